@@ -0,0 +1,35 @@
+#
+# Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+#
+# Authors: Manel Jimeno <manel.jimeno@gmail.com>
+#
+# License: https://www.opensource.org/licenses/mit-license.php MIT
+#
+
+# Find and include the Google Benchmark library, which is required for the benchmarks
+find_package(benchmark REQUIRED)
+
+# Include custom target configuration from target_config.cmake
+include(target_config)
+
+# Function to create a C++ benchmark target Arguments: - name: The name of the benchmark executable - ARGN: The source
+# files of the benchmark
+function(add_cpp_bench name)
+    # Create an executable target for the benchmark using the provided sources
+    add_executable(${name} ${ARGN})
+
+    # Apply custom target configuration using the target_configure function
+    target_configure(${name})
+
+    # Link the benchmark executable to the Google Benchmark library
+    target_link_libraries(${name} PRIVATE benchmark::benchmark)
+
+    # Set the benchmark target under the "Benchmarks" folder for better organization
+    set_target_properties(${name} PROPERTIES FOLDER "Benchmarks")
+
+    # Include the current binary directory for access to generated files (like headers)
+    target_include_directories(${name} PRIVATE ${CMAKE_CURRENT_BINARY_DIR})
+
+    # Print a message indicating that the benchmark was added
+    message(STATUS "\t benchmark ${name} added")
+endfunction()
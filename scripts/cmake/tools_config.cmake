@@ -20,6 +20,25 @@ function(generate_json_sources target json_dir generated_dir)
     add_dependencies(${target}_gen_tables db_api_generator)
 endfunction()
 
+# Function to generate the class of a single .json file at build time and compile it into a target, the class is
+# written to generated_dir as <table name>.h and <table name>.cpp, so the JSON file must be named after its table
+function(generate_json_class target json_file generated_dir)
+    get_filename_component(table_name ${json_file} NAME_WE)
+    set(generated_sources "${generated_dir}/${table_name}.h" "${generated_dir}/${table_name}.cpp")
+
+    add_custom_command(
+        OUTPUT ${generated_sources}
+        COMMAND ${CMAKE_COMMAND} -E make_directory ${generated_dir}
+        COMMAND db_api_generator --json-file ${json_file} --output ${generated_dir} --db-type QSQLITE --connection-info
+                :memory:
+        DEPENDS db_api_generator ${json_file}
+        COMMENT "Generating the class of ${json_file} in ${generated_dir}"
+        VERBATIM)
+
+    target_sources(${target} PRIVATE ${generated_sources})
+    target_include_directories(${target} PRIVATE ${generated_dir})
+endfunction()
+
 # Function to generate .cpp files from .json files
 function(generate_qml_sources target menu_dir generated_dir)
     message(STATUS "Loading JSON files from ${json_dir} the output directory is ${generated_dir}")
@@ -0,0 +1,123 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QRandomGenerator>
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "bench_tools.h"
+#include "db/db_manager.h"
+#include "security.h"
+#include "tools/password_hash.h"
+#include "users.h"
+
+using core::modules::security::Security;
+
+namespace
+{
+    /**
+     * @brief Opens the "main" connection the Security module works on, once for every benchmark.
+     */
+    class SecurityDatabase
+    {
+    public:
+        SecurityDatabase() : m_path(core::tools::getTemporaryFileName(".db"))
+        {
+            auto &manager = core::db::DBManager::manager();
+            static_cast<void>(manager.connect(m_path, core::db::SQLiteOptions::interactive(), "main"));
+            manager.enablePool("main");
+            Security::security().initialize();
+        }
+
+        ~SecurityDatabase()
+        {
+            QFile::remove(m_path);
+            QFile::remove(m_path + "-wal");
+            QFile::remove(m_path + "-shm");
+        }
+
+        /**
+         * @brief Replaces the users but the administrator, all of them with the same password.
+         * @param rows The number of users.
+         * @return The names of the users.
+         */
+        QStringList resetUsers(const qsizetype rows)
+        {
+            const auto database = core::db::DBManager::manager().main();
+            QSqlQuery  query(database);
+            query.exec("DELETE FROM users WHERE username <> 'admin';");
+
+            // Hashed once, a login costs the same whatever the user
+            static const auto          hash = core::tools::PasswordHash::hash("password");
+            std::vector<Users::Record> records(static_cast<size_t>(rows));
+            QStringList                usernames;
+            usernames.reserve(rows);
+            for (qsizetype i = 0; i < rows; i++)
+            {
+                auto &record         = records[static_cast<size_t>(i)];
+                record.m_username    = QString("user_%1").arg(i);
+                record.m_password    = hash;
+                record.m_email       = QString("user_%1@invoice.manager").arg(i);
+                record.m_groupId     = 0;
+                record.m_created_by  = "admin";
+                record.m_modified_by = "admin";
+                usernames << record.m_username;
+            }
+            Users users(database);
+            users.insertBatch(records);
+            return usernames;
+        }
+
+    private:
+        QString m_path; ///< Path of the temporary database file.
+    };
+
+    SecurityDatabase &securityDatabase()
+    {
+        static SecurityDatabase self;
+        return self;
+    }
+
+    /**
+     * @brief Picks a user at random.
+     */
+    const QString &anyUser(const QStringList &usernames)
+    {
+        return usernames[static_cast<qsizetype>(
+                QRandomGenerator::global()->bounded(static_cast<quint64>(usernames.size())))];
+    }
+} // namespace
+
+// Login of a user already in the identity cache, the cost of the password verification
+static void BM_SecurityLogin(benchmark::State &state)
+{
+    const auto  usernames = securityDatabase().resetUsers(state.range(0));
+    const auto &username  = anyUser(usernames);
+    // The first login stores the user in the cache
+    static_cast<void>(Security::login(username, "password"));
+
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(Security::login(username, "password"));
+    }
+}
+
+// Login of a user that is not cached, which looks it up in the users table first
+static void BM_SecurityLoginCacheMiss(benchmark::State &state)
+{
+    const auto usernames = securityDatabase().resetUsers(state.range(0));
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        Security::security().identities().invalidate("users");
+        const auto &username = anyUser(usernames);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(Security::login(username, "password"));
+    }
+}
+
+BENCHMARK(BM_SecurityLogin)->Apply(bench::rowCounts);
+BENCHMARK(BM_SecurityLoginCacheMiss)->Apply(bench::rowCounts);
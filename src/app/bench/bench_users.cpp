@@ -0,0 +1,233 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QRandomGenerator>
+#include <QSqlQuery>
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "bench_tools.h"
+#include "db/transaction.h"
+#include "users.h"
+
+namespace
+{
+    Users::Record makeUser(const qsizetype index)
+    {
+        Users::Record record{};
+        record.m_username    = QString("user_%1").arg(index);
+        record.m_password    = "password";
+        record.m_email       = QString("user_%1@invoice.manager").arg(index);
+        record.m_groupId     = 1;
+        record.m_created_by  = "admin";
+        record.m_modified_by = "admin";
+        return record;
+    }
+
+    std::vector<Users::Record> makeUsers(const qsizetype rows)
+    {
+        std::vector<Users::Record> records;
+        records.reserve(static_cast<size_t>(rows));
+        for (qsizetype i = 0; i < rows; i++)
+        {
+            records.push_back(makeUser(i));
+        }
+        return records;
+    }
+
+    /**
+     * @brief Lookups measured per iteration, whatever the size of the table.
+     */
+    constexpr qsizetype LOOKUPS = 1000;
+} // namespace
+
+// Generated insert, the new id is read from the driver
+static void BM_UsersInsert(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM users;");
+        state.ResumeTiming();
+        for (qsizetype i = 0; i < state.range(0); i++)
+        {
+            auto record = makeUser(i);
+            users.insert(record);
+            benchmark::DoNotOptimize(record.m_id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Generated insert followed by the former "SELECT last_insert_rowid();" round-trip
+static void BM_UsersInsertRowIdRoundTrip(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM users;");
+        state.ResumeTiming();
+        for (qsizetype i = 0; i < state.range(0); i++)
+        {
+            auto record = makeUser(i);
+            users.insert(record);
+            QSqlQuery query(db.database());
+            query.exec("SELECT last_insert_rowid();");
+            query.next();
+            record.m_id = query.value(0).toLongLong();
+            benchmark::DoNotOptimize(record.m_id);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_UsersInsertBatch(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+    auto records = makeUsers(state.range(0));
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM users;");
+        state.ResumeTiming();
+        users.insertBatch(records);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Random lookups by id
+static void BM_UsersSelectPk(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+    auto records = makeUsers(state.range(0));
+    users.insertBatch(records);
+    std::vector<long long> ids;
+    ids.reserve(LOOKUPS);
+    for (qsizetype i = 0; i < LOOKUPS; i++)
+    {
+        ids.push_back(records[QRandomGenerator::global()->bounded(static_cast<quint64>(records.size()))].m_id);
+    }
+
+    for (auto _: state)
+    {
+        for (const auto id: ids)
+        {
+            Users::Record record{};
+            record.m_id = id;
+            if (!users.selectPk(record))
+            {
+                state.SkipWithError("A user was not found by its id.");
+                return;
+            }
+            benchmark::DoNotOptimize(record);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+// Random lookups through the username index, as the login does
+static void BM_UsersFindUserByUsername(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+    auto records = makeUsers(state.range(0));
+    users.insertBatch(records);
+    QStringList usernames;
+    usernames.reserve(LOOKUPS);
+    for (qsizetype i = 0; i < LOOKUPS; i++)
+    {
+        usernames << records[QRandomGenerator::global()->bounded(static_cast<quint64>(records.size()))].m_username;
+    }
+
+    for (auto _: state)
+    {
+        for (const auto &username: usernames)
+        {
+            Users::Record record{};
+            record.m_username = username;
+            if (!users.findUserByUsername(record))
+            {
+                state.SkipWithError("A user was not found by its username.");
+                return;
+            }
+            benchmark::DoNotOptimize(record);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+static void BM_UsersUpdateBatch(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+    auto records = makeUsers(state.range(0));
+    users.insertBatch(records);
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        for (auto &record: records)
+        {
+            record.m_email += '+';
+        }
+        state.ResumeTiming();
+        users.updateBatch(records);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Row by row, all of them in one transaction
+static void BM_UsersDeleteRow(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    Users                    users(db.database());
+    users.create();
+    auto records = makeUsers(state.range(0));
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        users.insertBatch(records);
+        state.ResumeTiming();
+        core::db::Transaction transaction(db.database());
+        for (auto &record: records)
+        {
+            users.deleteRow(record);
+        }
+        transaction.commit();
+        state.PauseTiming();
+        const auto left = users.countRows();
+        state.ResumeTiming();
+        if (left != 0)
+        {
+            state.SkipWithError("Some users were not deleted.");
+            return;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_UsersInsert)->Arg(1000);
+BENCHMARK(BM_UsersInsertRowIdRoundTrip)->Arg(1000);
+BENCHMARK(BM_UsersInsertBatch)->Apply(bench::rowCounts);
+BENCHMARK(BM_UsersSelectPk)->Apply(bench::rowCounts);
+BENCHMARK(BM_UsersFindUserByUsername)->Apply(bench::rowCounts);
+BENCHMARK(BM_UsersUpdateBatch)->Apply(bench::rowCounts);
+BENCHMARK(BM_UsersDeleteRow)->Apply(bench::rowCounts);
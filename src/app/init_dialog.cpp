@@ -12,13 +12,17 @@
 #include <QApplication>
 #include <QQmlContext>
 #include <QtConcurrentRun>
+#include "tools/trace.h"
 
 
 InitDialog::InitDialog(QQmlApplicationEngine *engine, std::function<void()> initCallback, QObject *parent) :
     QObject(parent), m_engine(engine), m_window(nullptr), m_initCallback(std::move(initCallback)),
     m_loginUrl("qrc:/login_page.qml"), m_status(core::modules::security::Security::LoginStatus::NOT_LOGGED_IN)
 {
-    m_engine->load(QUrl("qrc:/init_dialog.qml"));
+    {
+        const core::tools::ScopedSpan span("qml.load", "startup", "qrc:/init_dialog.qml");
+        m_engine->load(QUrl("qrc:/init_dialog.qml"));
+    }
 
     if (m_engine->rootObjects().isEmpty())
     {
@@ -49,6 +53,13 @@ InitDialog::InitDialog(QQmlApplicationEngine *engine, std::function<void()> init
     {
         throw std::runtime_error("The root object is not a valid window.");
     }
+
+    connect(&m_loginWatcher, &QFutureWatcher<core::modules::security::Security::LoginStatus>::finished, this,
+            [this]()
+            {
+                m_status = m_loginWatcher.result();
+                emit loginFinished(static_cast<int>(m_status));
+            });
 }
 
 InitDialog::~InitDialog()
@@ -92,6 +103,8 @@ void InitDialog::show()
                 throw LoginError("User does not exist.");
             case core::modules::security::Security::LoginStatus::PASSWORD_IS_INCORRECT:
                 throw LoginError("Password is incorrect.");
+            case core::modules::security::Security::LoginStatus::TOO_MANY_ATTEMPTS:
+                throw LoginError("Too many failed attempts.");
             case core::modules::security::Security::LoginStatus::USER_IDENTIFIED:
                 break;
         }
@@ -134,17 +147,20 @@ void InitDialog::incrementProgress(const int value) const
     }
 }
 
-core::modules::security::Security::LoginStatus InitDialog::login(const QString &user, const QString &password)
+void InitDialog::login(const QString &user, const QString &password)
 {
-    if (user.isEmpty() || password.isEmpty())
+    if (m_loginWatcher.isRunning())
     {
-        m_status = core::modules::security::Security::LoginStatus::NOT_LOGGED_IN;
+        // The password field and the button both submit, only the first attempt is checked
+        return;
     }
-    else
+    if (user.isEmpty() || password.isEmpty())
     {
-        m_status = core::modules::security::Security::login(user, password);
+        m_status = core::modules::security::Security::LoginStatus::NOT_LOGGED_IN;
+        emit loginFinished(static_cast<int>(m_status));
+        return;
     }
-    return m_status;
+    m_loginWatcher.setFuture(core::modules::security::Security::loginAsync(user, password));
 }
 
 core::modules::security::Security::LoginStatus InitDialog::checkUser(const QString &user)
@@ -8,6 +8,7 @@
  */
 
 #pragma once
+#include <QFutureWatcher>
 #include <QQmlApplicationEngine>
 #include <QQuickWindow>
 #include <exception.h>
@@ -31,19 +32,24 @@ public:
     void             show();
     Q_INVOKABLE void exit(int returnCode = 0) const;
     Q_INVOKABLE void close() const;
-    Q_INVOKABLE core::modules::security::Security::LoginStatus login(const QString &user, const QString &password);
+    // The password is verified in a worker thread, the result is reported through loginFinished()
+    Q_INVOKABLE void login(const QString &user, const QString &password);
     Q_INVOKABLE static core::modules::security::Security::LoginStatus checkUser(const QString &user);
 
+signals:
+    void loginFinished(int status);
+
 public slots:
     void incrementProgress(int value) const;
 
 private:
-    QQmlApplicationEngine                         *m_engine;
-    QQuickWindow                                  *m_window;
-    QObject                                       *m_progressBar;
-    QObject                                       *m_stackView;
-    const QUrl                                     m_loginUrl;
-    std::shared_ptr<QEventLoop>                    m_eventLoop;
-    const std::function<void()>                    m_initCallback;
-    core::modules::security::Security::LoginStatus m_status;
+    QQmlApplicationEngine                                         *m_engine;
+    QQuickWindow                                                  *m_window;
+    QObject                                                       *m_progressBar;
+    QObject                                                       *m_stackView;
+    const QUrl                                                     m_loginUrl;
+    std::shared_ptr<QEventLoop>                                    m_eventLoop;
+    const std::function<void()>                                    m_initCallback;
+    core::modules::security::Security::LoginStatus                 m_status;
+    QFutureWatcher<core::modules::security::Security::LoginStatus> m_loginWatcher;
 };
@@ -18,6 +18,7 @@
 #include <QTimer>
 
 #include "db/db_manager.h"
+#include "tools/trace.h"
 
 InvoiceManagerApp::InvoiceManagerApp(int &argc, char **argv) :
     QApplication(argc, argv), m_settings(getDatabase(), "settings")
@@ -25,18 +26,26 @@ InvoiceManagerApp::InvoiceManagerApp(int &argc, char **argv) :
     auto aboutQuit = connect(this, &QCoreApplication::aboutToQuit, this, &InvoiceManagerApp::onAboutToQuit);
     QQuickStyle::setStyle("Material");
     m_engine.addImportPath(QStringLiteral("qrc:/themes"));
+    m_modules.add(core::modules::security::Security::security());
 }
 
 QSqlDatabase &InvoiceManagerApp::getDatabase()
 {
-    static QSqlDatabase db = core::db::DBManager::manager().connect("QSQLITE", "./invoice_manager.db", "main");
+    static QSqlDatabase db;
 
     if (!db.isOpen())
     {
-        if (!db.open())
+        try
+        {
+            db = core::db::DBManager::manager().connect("./invoice_manager.db",
+                                                        core::db::SQLiteOptions::interactive(), "main");
+        }
+        catch (const core::db::DBManagerException &error)
         {
-            qFatal("Failed to open the database.");
+            qFatal("Failed to open the database: %s", error.what());
         }
+        // Modules are initialized in worker threads, which lease their own clone of the connection
+        core::db::DBManager::manager().enablePool("main");
     }
     return db;
 }
@@ -44,11 +53,11 @@ QSqlDatabase &InvoiceManagerApp::getDatabase()
 int InvoiceManagerApp::loop()
 {
     {
-        auto      &security         = core::modules::security::Security::security();
-        auto       functionCallback = [&]() { security.initialize(); };
+        // The modules are initialized concurrently, each one leasing its own connection
+        auto       functionCallback = [this]() { m_modules.initialize(); };
         InitDialog init(&m_engine, functionCallback);
 
-        auto progressChanged = connect(&security, &core::modules::security::Security::progressChanged, &init,
+        auto progressChanged = connect(&m_modules, &core::modules::ModuleRegistry::progressChanged, &init,
                                        &InitDialog::incrementProgress);
         try
         {
@@ -56,6 +65,7 @@ int InvoiceManagerApp::loop()
         }
         catch (LoginError &)
         {
+            core::tools::Trace::flush();
             throw;
         }
     }
@@ -72,12 +82,16 @@ int InvoiceManagerApp::loop()
             Qt::QueuedConnection);
 
     m_engine.rootContext()->setContextProperty("controller", &m_mainWindow);
-    m_engine.load(url);
+    {
+        const core::tools::ScopedSpan span("qml.load", "startup", url.toString());
+        m_engine.load(url);
+    }
     return exec();
 }
 
 void InvoiceManagerApp::onAboutToQuit()
 {
     qDebug() << "Application is about to quit, stopping modules...";
-    core::modules::security::Security::security().stop();
+    m_modules.stop();
+    core::tools::Trace::flush();
 }
@@ -11,6 +11,7 @@
 
 #include <QApplication>
 #include <QQmlApplicationEngine>
+#include "module_registry.h"
 #include "settings/sqlite_settings.h"
 #include "ui/main_window.h"
 
@@ -45,9 +46,10 @@ public:
     [[nodiscard]] int loop();
 
 private:
-    static void onAboutToQuit();
+    void onAboutToQuit();
 
     MainWindow                     m_mainWindow; ///< Main window of the application.
     QQmlApplicationEngine          m_engine; ///< QML engine for loading QML UI.
     core::settings::SQLiteSettings m_settings; ///< Settings of the app.
+    core::modules::ModuleRegistry  m_modules; ///< Modules of the app, initialized by the init dialog.
 };
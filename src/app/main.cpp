@@ -8,6 +8,7 @@
  */
 
 #include "invoice_manager_app.h"
+#include "tools/trace.h"
 
 /**
  * @brief The main function, entry point of the application.
@@ -17,6 +18,8 @@
  */
 int main(int argc, char *argv[])
 {
+    // INVOICE_TRACE=<file> writes the startup spans as a Chrome trace
+    core::tools::Trace::enableFromEnvironment();
     InvoiceManagerApp app(argc, argv);
     return app.loop();
 }
@@ -14,8 +14,9 @@
 namespace core::modules
 {
 
-    Module::Module(QString name, QString description, const int initializationTime) :
-        m_name(std::move(name)), m_description(std::move(description)), m_initializationTime(initializationTime)
+    Module::Module(QString name, QString description, const int initializationTime, QStringList dependencies) :
+        m_name(std::move(name)), m_description(std::move(description)), m_initializationTime(initializationTime),
+        m_dependencies(std::move(dependencies))
     {
     }
 
@@ -29,4 +30,14 @@ namespace core::modules
         return m_description;
     }
 
+    int Module::initializationTime() const
+    {
+        return m_initializationTime;
+    }
+
+    const QStringList &Module::dependencies() const
+    {
+        return m_dependencies;
+    }
+
 } // namespace core::modules
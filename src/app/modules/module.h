@@ -10,6 +10,7 @@
 #pragma once
 #include <QObject>
 #include <QString>
+#include <QStringList>
 #include <functional>
 
 namespace core::modules
@@ -27,8 +28,9 @@ namespace core::modules
          * @param name The name of the module.
          * @param description The description of the module.
          * @param initializationTime The approximate time required for initialization (in milliseconds).
+         * @param dependencies The names of the modules that must be initialized before this one.
          */
-        Module(QString name, QString description, int initializationTime);
+        Module(QString name, QString description, int initializationTime, QStringList dependencies = {});
 
         /**
          * @brief Gets the name of the module.
@@ -42,8 +44,23 @@ namespace core::modules
          */
         [[nodiscard]] QString description() const;
 
+        /**
+         * @brief Gets the approximate time required for initialization, used to weight the progress.
+         * @return The time in milliseconds.
+         */
+        [[nodiscard]] int initializationTime() const;
+
+        /**
+         * @brief Gets the modules that must be initialized before this one.
+         * @return The names of the modules.
+         */
+        [[nodiscard]] const QStringList &dependencies() const;
+
         /**
          * @brief Initializes the module.
+         *
+         * Runs in a worker thread of the ModuleRegistry, concurrently with the modules that do not
+         * depend on it, so database work must use a connection leased by the module.
          */
         virtual void initialize() = 0;
 
@@ -58,12 +75,17 @@ namespace core::modules
         virtual ~Module() = default;
 
     signals:
+        /**
+         * @brief Reports the progress of the initialization.
+         * @param progress The percentage of the module initialization done since the last report.
+         */
         void progressChanged(int progress);
 
     private:
-        QString m_name;
-        QString m_description;
-        int     m_initializationTime;
+        QString     m_name;
+        QString     m_description;
+        int         m_initializationTime;
+        QStringList m_dependencies;
     };
 
 } // namespace core::modules
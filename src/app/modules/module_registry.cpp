@@ -0,0 +1,257 @@
+/**
+ * @file module_registry.cpp
+ * @brief Implementation file for the ModuleRegistry class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "module_registry.h"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QWaitCondition>
+#include <algorithm>
+#include <exception>
+#include "tools/trace.h"
+
+namespace core::modules
+{
+    namespace
+    {
+        /**
+         * @brief Weight of a module, modules without an estimation count as one millisecond.
+         */
+        qint64 weight(const Module *module)
+        {
+            return std::max(module->initializationTime(), 1);
+        }
+    } // namespace
+
+    ModuleRegistry::ModuleRegistry(const int maxThreads, QObject *parent) : QObject(parent)
+    {
+        m_pool.setMaxThreadCount(std::max(maxThreads, 1));
+    }
+
+    void ModuleRegistry::add(Module &module)
+    {
+        if (m_names.contains(module.name()))
+        {
+            throw ModuleError("The module " + module.name() + " is already registered.");
+        }
+        m_modules.append(&module);
+        m_names.insert(module.name(), &module);
+    }
+
+    Module *ModuleRegistry::module(const QString &name) const
+    {
+        return m_names.value(name, nullptr);
+    }
+
+    QList<Module *> ModuleRegistry::sorted() const
+    {
+        // Kahn's algorithm, keeping the registration order among the independent modules
+        QHash<Module *, qsizetype>       pending;
+        QHash<Module *, QList<Module *>> dependents;
+        for (auto *module: m_modules)
+        {
+            pending[module] = module->dependencies().size();
+            for (const auto &name: module->dependencies())
+            {
+                auto *dependency = this->module(name);
+                if (dependency == nullptr)
+                {
+                    throw ModuleError("The module " + module->name() + " depends on the unknown module " + name +
+                                      ".");
+                }
+                dependents[dependency].append(module);
+            }
+        }
+
+        QList<Module *> order;
+        order.reserve(m_modules.size());
+        for (auto *module: m_modules)
+        {
+            if (pending[module] == 0)
+            {
+                order.append(module);
+            }
+        }
+        for (qsizetype i = 0; i < order.size(); ++i)
+        {
+            for (auto *dependent: dependents.value(order[i]))
+            {
+                if (--pending[dependent] == 0)
+                {
+                    order.append(dependent);
+                }
+            }
+        }
+        if (order.size() != m_modules.size())
+        {
+            throw ModuleError("The dependencies of the modules have a cycle.");
+        }
+        return order;
+    }
+
+    QHash<Module *, qint64> ModuleRegistry::ranks(const QList<Module *> &order) const
+    {
+        // The dependents come later in the order, so walking it backwards ranks them first
+        QHash<Module *, qint64> ranks;
+        for (auto it = order.crbegin(); it != order.crend(); ++it)
+        {
+            ranks[*it] += weight(*it);
+            for (const auto &name: (*it)->dependencies())
+            {
+                auto &rank = ranks[module(name)];
+                rank       = std::max(rank, ranks[*it]);
+            }
+        }
+        return ranks;
+    }
+
+    int ModuleRegistry::criticalPath() const
+    {
+        const auto rank = ranks(sorted());
+        qint64     path = 0;
+        for (const auto value: rank)
+        {
+            path = std::max(path, value);
+        }
+        return static_cast<int>(path);
+    }
+
+    void ModuleRegistry::initialize()
+    {
+        const auto order = sorted();
+        const auto rank  = ranks(order);
+
+        m_progress.clear();
+        m_totalWeight = 0;
+        m_doneWeight  = 0;
+        m_reported    = 0;
+        QHash<Module *, qsizetype> pending;
+        for (auto *module: order)
+        {
+            m_totalWeight += weight(module);
+            pending[module] = module->dependencies().size();
+            connect(module, &Module::progressChanged, this,
+                    [this, module](const int progress) { addProgress(module, progress); }, Qt::DirectConnection);
+        }
+
+        QMutex             mutex;
+        QWaitCondition     changed;
+        QList<Module *>    ready;
+        qsizetype          running  = 0;
+        qsizetype          finished = 0;
+        std::exception_ptr error;
+        const auto         byRank = [&rank](Module *left, Module *right) { return rank[left] > rank[right]; };
+        for (auto *module: order)
+        {
+            if (pending[module] == 0)
+            {
+                ready.append(module);
+            }
+        }
+        std::stable_sort(ready.begin(), ready.end(), byRank);
+
+        const tools::ScopedSpan span("modules.initialize", "startup");
+        QElapsedTimer           timer;
+        timer.start();
+        QMutexLocker locker(&mutex);
+        while (finished < order.size())
+        {
+            while (!error && !ready.isEmpty())
+            {
+                auto *module = ready.takeFirst();
+                ++running;
+                m_pool.start(
+                        [&, module]()
+                        {
+                            std::exception_ptr failure;
+                            try
+                            {
+                                const tools::ScopedSpan span("module.initialize", "startup", module->name());
+                                module->initialize();
+                            }
+                            catch (...)
+                            {
+                                failure = std::current_exception();
+                            }
+                            if (!failure)
+                            {
+                                // Modules that report less than their whole progress are completed here
+                                addProgress(module, 100);
+                            }
+
+                            QMutexLocker guard(&mutex);
+                            --running;
+                            if (failure)
+                            {
+                                error = error ? error : failure;
+                            }
+                            else
+                            {
+                                ++finished;
+                                for (auto *dependent: order)
+                                {
+                                    if (dependent->dependencies().contains(module->name()) &&
+                                        --pending[dependent] == 0)
+                                    {
+                                        ready.insert(std::upper_bound(ready.begin(), ready.end(), dependent, byRank),
+                                                     dependent);
+                                    }
+                                }
+                            }
+                            changed.wakeAll();
+                        });
+            }
+            if (running == 0 && (error || ready.isEmpty()))
+            {
+                break;
+            }
+            changed.wait(&mutex);
+        }
+        locker.unlock();
+        m_pool.waitForDone();
+
+        for (auto *module: order)
+        {
+            disconnect(module, &Module::progressChanged, this, nullptr);
+        }
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+        qDebug() << "Modules initialized in" << timer.elapsed() << "ms, critical path estimated in"
+                 << criticalPath() << "ms";
+    }
+
+    void ModuleRegistry::stop()
+    {
+        const auto order = sorted();
+        for (auto it = order.crbegin(); it != order.crend(); ++it)
+        {
+            (*it)->stop();
+        }
+    }
+
+    void ModuleRegistry::addProgress(const Module *module, const int progress)
+    {
+        QMutexLocker locker(&m_progressMutex);
+        auto        &done  = m_progress[module];
+        const auto   added = std::clamp(progress, 0, 100 - done);
+        done += added;
+        m_doneWeight += added * weight(module);
+
+        const auto total = m_totalWeight > 0 ? static_cast<int>(m_doneWeight / m_totalWeight) : 100;
+        if (total > m_reported)
+        {
+            const auto increment = total - m_reported;
+            m_reported           = total;
+            locker.unlock();
+            emit progressChanged(increment);
+        }
+    }
+} // namespace core::modules
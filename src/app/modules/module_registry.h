@@ -0,0 +1,134 @@
+/**
+ * @file module_registry.h
+ * @brief Contains the declaration of the ModuleRegistry class.
+ *
+ * This file declares the ModuleRegistry class, which initializes the application modules in
+ * the order of their dependencies, running the independent ones at the same time.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QObject>
+#include <QThreadPool>
+#include <exception.h>
+#include "db/connection_pool.h"
+#include "module.h"
+
+namespace core::modules
+{
+    /**
+     * @class ModuleError
+     * @brief Exception thrown when the modules cannot be scheduled.
+     */
+    class ModuleError final : public core::Exception
+    {
+        using Exception::Exception; ///< Inherit the constructor from Exception.
+    };
+
+    /**
+     * @class ModuleRegistry
+     * @brief Initializes the registered modules on a thread pool following their dependencies.
+     *
+     * A module starts as soon as the modules it depends on are initialized, so the startup
+     * takes as long as the slowest chain of dependencies instead of the sum of every module.
+     * When more modules are ready than threads, the ones heading the longest chain, weighted by
+     * Module::initializationTime(), start first. The same weights turn the progress of each
+     * module into the progress of the whole initialization.
+     */
+    class ModuleRegistry final : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        /**
+         * @brief Constructs an empty registry.
+         * @param maxThreads Modules initialized at the same time, by default as many as connections
+         * the pool of a database leases, so each module gets its own.
+         * @param parent The parent object.
+         */
+        explicit ModuleRegistry(int      maxThreads = db::ConnectionPool::DEFAULT_MAX_CONNECTIONS,
+                                QObject *parent     = nullptr);
+
+        /**
+         * @brief Registers a module, which must outlive the registry.
+         * @param module The module.
+         * @throws ModuleError if a module with the same name is already registered.
+         */
+        void add(Module &module);
+
+        /**
+         * @brief Retrieves a registered module.
+         * @param name The name of the module.
+         * @return The module, or nullptr if it is not registered.
+         */
+        [[nodiscard]] Module *module(const QString &name) const;
+
+        /**
+         * @brief Initializes every module, blocking until all of them finish.
+         *
+         * Once a module fails no other one is started, the running ones are waited for and the
+         * error is rethrown.
+         *
+         * @throws ModuleError if a dependency is not registered or the dependencies have a cycle.
+         */
+        void initialize();
+
+        /**
+         * @brief Stops every module, the dependent modules before their dependencies.
+         */
+        void stop();
+
+        /**
+         * @brief Computes the time of the slowest chain of dependencies.
+         * @return The sum of the initialization times of the chain, in milliseconds.
+         * @throws ModuleError if a dependency is not registered or the dependencies have a cycle.
+         */
+        [[nodiscard]] int criticalPath() const;
+
+    signals:
+        /**
+         * @brief Reports the progress of the whole initialization.
+         * @param progress The percentage done since the last report.
+         */
+        void progressChanged(int progress);
+
+    private:
+        /**
+         * @brief Sorts the modules so every module comes after its dependencies.
+         * @return The sorted modules.
+         * @throws ModuleError if a dependency is not registered or the dependencies have a cycle.
+         */
+        [[nodiscard]] QList<Module *> sorted() const;
+
+        /**
+         * @brief Computes the weight of the longest chain headed by each module.
+         * @param order The modules sorted by sorted().
+         * @return The rank of each module.
+         */
+        [[nodiscard]] QHash<Module *, qint64> ranks(const QList<Module *> &order) const;
+
+        /**
+         * @brief Adds the progress reported by a module, emitting the change of the total progress.
+         * @param module The module.
+         * @param progress The percentage of the module done since its last report.
+         */
+        void addProgress(const Module *module, int progress);
+
+        QList<Module *>            m_modules; ///< Modules in registration order.
+        QHash<QString, Module *>   m_names; ///< Modules by name.
+        QThreadPool                m_pool; ///< Threads running the initializations.
+        QMutex                     m_progressMutex; ///< Modules report their progress from their thread.
+        QHash<const Module *, int> m_progress; ///< Percentage done of each module.
+        qint64                     m_totalWeight = 0; ///< Sum of the weights of the modules.
+        qint64                     m_doneWeight  = 0; ///< Sum of the weights done, in hundredths.
+        int                        m_reported    = 0; ///< Total percentage already emitted.
+    };
+} // namespace core::modules
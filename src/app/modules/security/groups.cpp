@@ -12,80 +12,158 @@
 #include <QSqlError>
 #include <QSqlRecord>
 #include "db/db_exception.h"
+#include "db/query_profiler.h"
+#include "tools/trace.h"
 
-Groups::Groups(const QSqlDatabase &db) :
-    core::db::SQLiteDbApi(db), m_create(m_database), m_insert(m_database), m_update(m_database),
-    m_deleteRow(m_database), m_selectPk(m_database), m_countRows(m_database), m_findUserByUsername(m_database)
+Groups::Groups(const QSqlDatabase &db) : core::db::SQLiteDbApi(db)
 {
-    m_insert.prepare(INSERT);
-    m_update.prepare(UPDATE);
-    m_deleteRow.prepare(DELETE_ROW);
-    m_selectPk.prepare(SELECT_PK);
-    m_countRows.prepare(COUNT_ROWS);
-    m_findUserByUsername.prepare(FIND_USER_BY_USERNAME);
 }
 
 void Groups::create()
 {
-    std::array<QString, 3> sentences = {CREATE, CREATE_INDEX_1, CREATE_INDEX_2};
-    for (auto &sentence: sentences)
+    const core::tools::ScopedSpan            span("Groups::create", "db");
+    constexpr std::array<QUtf8StringView, 3> sentences = {CREATE, CREATE_INDEX_1, CREATE_INDEX_2};
+    QSqlQuery                                query(m_database);
+    for (const auto &sentence: sentences)
     {
-        if (!m_create.exec(sentence))
+        if (!query.exec(sentence.toString()))
         {
-            throw core::db::SQLError(m_create.lastError().text());
+            throw core::db::SQLError(query.lastError().text());
         }
     }
 }
 
 void Groups::insert(Record &record)
 {
-    m_insert.bindValue(":groupName", record.m_groupName);
-    m_insert.bindValue(":description", record.m_description);
-    m_insert.bindValue(":modified_by", record.m_modified_by);
-    m_insert.bindValue(":created_by", record.m_created_by);
-    if (!m_insert.exec())
+    ensurePrepared(m_insert, INSERT);
+    core::db::ProfiledQuery profile(m_database, "Groups::insert");
+    m_insert->bindValue(":groupName", record.m_groupName);
+    m_insert->bindValue(":description", record.m_description);
+    m_insert->bindValue(":modified_by", record.m_modified_by);
+    m_insert->bindValue(":created_by", record.m_created_by);
+    if (!profile.exec(*m_insert))
     {
-        throw core::db::SQLError(m_insert.lastError().text());
+        throw core::db::SQLError(m_insert->lastError().text());
     }
-    record.m_id = getLastInsertRowId();
+    record.m_id = lastInsertRowId(*m_insert);
+    notifyTableChanged("groups");
+}
+
+void Groups::insertBatch(std::span<Record> records)
+{
+    if (records.empty())
+    {
+        return;
+    }
+    QVariantList groupNameValues;
+    groupNameValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList descriptionValues;
+    descriptionValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList modified_byValues;
+    modified_byValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList created_byValues;
+    created_byValues.reserve(static_cast<qsizetype>(records.size()));
+    for (const auto &record: records)
+    {
+        groupNameValues << record.m_groupName;
+        descriptionValues << record.m_description;
+        modified_byValues << record.m_modified_by;
+        created_byValues << record.m_created_by;
+    }
+    ensurePrepared(m_insert, INSERT);
+    m_insert->bindValue(":groupName", groupNameValues);
+    m_insert->bindValue(":description", descriptionValues);
+    m_insert->bindValue(":modified_by", modified_byValues);
+    m_insert->bindValue(":created_by", created_byValues);
+    execBatch(*m_insert, "Groups::insertBatch");
+    // The batch runs inside one transaction, so its rows get consecutive ids
+    auto lastId = lastInsertRowId(*m_insert) - static_cast<long long>(records.size());
+    for (auto &record: records)
+    {
+        record.m_id = ++lastId;
+    }
+    notifyTableChanged("groups");
 }
 
 void Groups::update(Record &record)
 {
+    ensurePrepared(m_update, UPDATE);
+    core::db::ProfiledQuery profile(m_database, "Groups::update");
+    m_update->bindValue(":groupName", record.m_groupName);
+    m_update->bindValue(":description", record.m_description);
+    m_update->bindValue(":modified_by", record.m_modified_by);
+    m_update->bindValue(":id", record.m_id);
+    if (!profile.exec(*m_update))
+    {
+        throw core::db::SQLError(m_update->lastError().text());
+    }
+    notifyTableChanged("groups");
+}
 
-    if (!m_update.exec())
+void Groups::updateBatch(std::span<Record> records)
+{
+    if (records.empty())
+    {
+        return;
+    }
+    QVariantList groupNameValues;
+    groupNameValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList descriptionValues;
+    descriptionValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList modified_byValues;
+    modified_byValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList idValues;
+    idValues.reserve(static_cast<qsizetype>(records.size()));
+    for (const auto &record: records)
     {
-        throw core::db::SQLError(m_update.lastError().text());
+        groupNameValues << record.m_groupName;
+        descriptionValues << record.m_description;
+        modified_byValues << record.m_modified_by;
+        idValues << record.m_id;
     }
+    ensurePrepared(m_update, UPDATE);
+    m_update->bindValue(":groupName", groupNameValues);
+    m_update->bindValue(":description", descriptionValues);
+    m_update->bindValue(":modified_by", modified_byValues);
+    m_update->bindValue(":id", idValues);
+    execBatch(*m_update, "Groups::updateBatch");
+    notifyTableChanged("groups");
 }
 
 void Groups::deleteRow(Record &record)
 {
-
-    if (!m_deleteRow.exec())
+    ensurePrepared(m_deleteRow, DELETE_ROW);
+    core::db::ProfiledQuery profile(m_database, "Groups::deleteRow");
+    m_deleteRow->bindValue(":id", record.m_id);
+    if (!profile.exec(*m_deleteRow))
     {
-        throw core::db::SQLError(m_deleteRow.lastError().text());
+        throw core::db::SQLError(m_deleteRow->lastError().text());
     }
+    notifyTableChanged("groups");
 }
 
 bool Groups::selectPk(Record &record)
 {
-
-    if (!m_selectPk.exec())
+    ensurePrepared(m_selectPk, SELECT_PK);
+    core::db::ProfiledQuery profile(m_database, "Groups::selectPk");
+    m_selectPk->bindValue(":id", record.m_id);
+    if (!profile.exec(*m_selectPk))
     {
-        throw core::db::SQLError(m_selectPk.lastError().text());
+        throw core::db::SQLError(m_selectPk->lastError().text());
     }
-    if (m_selectPk.next())
+    if (m_selectPk->next())
     {
-        const auto sqlRecord = m_selectPk.record();
-        record.m_id          = sqlRecord.value("id").toLongLong();
-        record.m_groupName   = sqlRecord.value("groupName").toString();
-        record.m_description = sqlRecord.value("description").toString();
-        record.m_modified_by = sqlRecord.value("modified_by").toString();
-        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
-        record.m_created_by  = sqlRecord.value("created_by").toString();
-        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
-
+        core::db::QueryProfiler::addRows("Groups::selectPk", 1);
+        const auto &fields   = resolveFields(*m_selectPk, m_selectPkFields, COLUMNS);
+        record.m_id          = fromVariant<COLUMNS[0].type>(m_selectPk->value(fields[0]));
+        record.m_groupName   = fromVariant<COLUMNS[1].type>(m_selectPk->value(fields[1]));
+        record.m_description = fromVariant<COLUMNS[2].type>(m_selectPk->value(fields[2]));
+        record.m_modified_by = fromVariant<COLUMNS[3].type>(m_selectPk->value(fields[3]));
+        record.m_modified_at = fromVariant<COLUMNS[4].type>(m_selectPk->value(fields[4]));
+        record.m_created_by  = fromVariant<COLUMNS[5].type>(m_selectPk->value(fields[5]));
+        record.m_created_at  = fromVariant<COLUMNS[6].type>(m_selectPk->value(fields[6]));
+
+        m_selectPk->finish();
         return true;
     }
     return false;
@@ -93,42 +171,83 @@ bool Groups::selectPk(Record &record)
 
 long long Groups::countRows()
 {
+    ensurePrepared(m_countRows, COUNT_ROWS);
+    core::db::ProfiledQuery profile(m_database, "Groups::countRows");
 
-    if (!m_countRows.exec())
+    if (!profile.exec(*m_countRows))
     {
-        throw core::db::SQLError(m_countRows.lastError().text());
+        throw core::db::SQLError(m_countRows->lastError().text());
     }
-    if (m_countRows.next())
+    long long rows = 0;
+    if (m_countRows->next())
     {
-        const auto sqlRecord = m_countRows.record();
-        return sqlRecord.value("rows").toLongLong();
+        rows = m_countRows->value(0).toLongLong();
     }
-    return 0;
+    m_countRows->finish();
+    return rows;
 }
 
-bool Groups::findUserByUsername(Record &record)
+QList<Groups::Record> Groups::selectPage(const Record *after, qsizetype limit)
 {
+    if (after == nullptr)
+    {
+        ensurePrepared(m_selectPage, SELECT_PAGE);
+    }
+    else
+    {
+        ensurePrepared(m_selectPageAfter, SELECT_PAGE_AFTER);
+    }
+    const auto             &query = after == nullptr ? m_selectPage : m_selectPageAfter;
+    core::db::ProfiledQuery profile(m_database, "Groups::selectPage");
 
-    if (!m_findUserByUsername.exec())
+    if (after != nullptr)
     {
-        throw core::db::SQLError(m_findUserByUsername.lastError().text());
+        query->bindValue(":after_id", after->m_id);
     }
-    return nextFindUserByUsername(record);
+    query->bindValue(":page_size", limit);
+    if (!profile.exec(*query))
+    {
+        throw core::db::SQLError(query->lastError().text());
+    }
+    QList<Record> records;
+    while (query->next())
+    {
+        const auto &fields = resolveFields(*query, m_selectPageFields, COLUMNS);
+        auto       &row    = records.emplace_back();
+        row.m_id           = fromVariant<COLUMNS[0].type>(query->value(fields[0]));
+        row.m_groupName    = fromVariant<COLUMNS[1].type>(query->value(fields[1]));
+        row.m_description  = fromVariant<COLUMNS[2].type>(query->value(fields[2]));
+        row.m_modified_by  = fromVariant<COLUMNS[3].type>(query->value(fields[3]));
+        row.m_modified_at  = fromVariant<COLUMNS[4].type>(query->value(fields[4]));
+        row.m_created_by   = fromVariant<COLUMNS[5].type>(query->value(fields[5]));
+        row.m_created_at   = fromVariant<COLUMNS[6].type>(query->value(fields[6]));
+    }
+    core::db::QueryProfiler::addRows("Groups::selectPage", static_cast<quint64>(records.size()));
+    return records;
 }
 
-bool Groups::nextFindUserByUsername(Record &record)
+bool Groups::findUserByUsername(Record &record)
 {
-    if (m_findUserByUsername.next())
+    ensurePrepared(m_findUserByUsername, FIND_USER_BY_USERNAME);
+    core::db::ProfiledQuery profile(m_database, "Groups::findUserByUsername");
+    m_findUserByUsername->bindValue(":groupName", record.m_groupName);
+    if (!profile.exec(*m_findUserByUsername))
     {
-        const auto sqlRecord = m_findUserByUsername.record();
-        record.m_id          = sqlRecord.value("id").toLongLong();
-        record.m_groupName   = sqlRecord.value("groupName").toString();
-        record.m_description = sqlRecord.value("description").toString();
-        record.m_modified_by = sqlRecord.value("modified_by").toString();
-        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
-        record.m_created_by  = sqlRecord.value("created_by").toString();
-        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
-
+        throw core::db::SQLError(m_findUserByUsername->lastError().text());
+    }
+    if (m_findUserByUsername->next())
+    {
+        core::db::QueryProfiler::addRows("Groups::findUserByUsername", 1);
+        const auto &fields   = resolveFields(*m_findUserByUsername, m_findUserByUsernameFields, COLUMNS);
+        record.m_id          = fromVariant<COLUMNS[0].type>(m_findUserByUsername->value(fields[0]));
+        record.m_groupName   = fromVariant<COLUMNS[1].type>(m_findUserByUsername->value(fields[1]));
+        record.m_description = fromVariant<COLUMNS[2].type>(m_findUserByUsername->value(fields[2]));
+        record.m_modified_by = fromVariant<COLUMNS[3].type>(m_findUserByUsername->value(fields[3]));
+        record.m_modified_at = fromVariant<COLUMNS[4].type>(m_findUserByUsername->value(fields[4]));
+        record.m_created_by  = fromVariant<COLUMNS[5].type>(m_findUserByUsername->value(fields[5]));
+        record.m_created_at  = fromVariant<COLUMNS[6].type>(m_findUserByUsername->value(fields[6]));
+
+        m_findUserByUsername->finish();
         return true;
     }
     return false;
@@ -10,8 +10,11 @@
 
 #pragma once
 #include <QSqlQuery>
+#include <QUtf8StringView>
+#include <array>
 #include <memory>
 #include <qdatetime.h>
+#include <span>
 #include "db/db_manager.h"
 #include "db/sqlite/sqlite_db_api.h"
 
@@ -31,38 +34,57 @@ public:
 
     explicit Groups(const QSqlDatabase &db = core::db::DBManager::manager().main());
 
-    void      create();
-    void      insert(Record &record);
-    void      update(Record &record);
-    void      deleteRow(Record &record);
-    bool      selectPk(Record &record);
-    long long countRows();
-    bool      findUserByUsername(Record &record);
-    bool      nextFindUserByUsername(Record &record);
+    void          create();
+    void          insert(Record &record);
+    void          insertBatch(std::span<Record> records);
+    void          update(Record &record);
+    void          updateBatch(std::span<Record> records);
+    void          deleteRow(Record &record);
+    bool          selectPk(Record &record);
+    long long     countRows();
+    QList<Record> selectPage(const Record *after, qsizetype limit);
+    bool          findUserByUsername(Record &record);
 
 private:
-    const QString CREATE = "CREATE TABLE IF NOT EXISTS groups ( id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE, groupName "
-                           "TEXT UNIQUE, description TEXT, modified_by TEXT, modified_at DATETIME DEFAULT "
-                           "CURRENT_TIMESTAMP, created_by TEXT, created_at DATETIME DEFAULT CURRENT_TIMESTAMP );";
-    const QString CREATE_INDEX_1 = "CREATE INDEX IF NOT EXISTS idx_groups_groupName ON groups(groupName);";
-    const QString CREATE_INDEX_2 = "CREATE INDEX IF NOT EXISTS idx_groups_id ON groups(id);";
-    const QString INSERT =
+    static constexpr QUtf8StringView CREATE =
+            "CREATE TABLE IF NOT EXISTS groups ( id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE, groupName TEXT UNIQUE, "
+            "description TEXT, modified_by TEXT, modified_at DATETIME DEFAULT CURRENT_TIMESTAMP, created_by TEXT, "
+            "created_at DATETIME DEFAULT CURRENT_TIMESTAMP );";
+    static constexpr QUtf8StringView CREATE_INDEX_1 =
+            "CREATE INDEX IF NOT EXISTS idx_groups_groupName ON groups(groupName);";
+    static constexpr QUtf8StringView CREATE_INDEX_2 = "CREATE INDEX IF NOT EXISTS idx_groups_id ON groups(id);";
+    static constexpr QUtf8StringView INSERT =
             "INSERT INTO groups (groupName, description, modified_by, modified_at, created_by, created_at) VALUES "
             "(:groupName, :description, :modified_by, CURRENT_TIMESTAMP, :created_by, CURRENT_TIMESTAMP);";
-    const QString UPDATE =
+    static constexpr QUtf8StringView UPDATE =
             "UPDATE groups SET groupName=:groupName, description=:description, modified_by=:modified_by, "
-            "modified_at=CURRENT_TIMESTAMP, created_by=:created_by, created_at=CURRENT_TIMESTAMP WHERE id=:id;";
-    const QString DELETE_ROW            = "DELETE FROM groups WHERE id=:id;";
-    const QString SELECT_PK             = "SELECT * FROM groups WHERE id=:id;";
-    const QString COUNT_ROWS            = "SELECT COUNT(*) rows FROM groups;";
-    const QString FIND_USER_BY_USERNAME = "select * from groups  where groupName = :groupName";
+            "modified_at=CURRENT_TIMESTAMP WHERE id=:id;";
+    static constexpr QUtf8StringView DELETE_ROW  = "DELETE FROM groups WHERE id=:id;";
+    static constexpr QUtf8StringView SELECT_PK   = "SELECT * FROM groups WHERE id=:id;";
+    static constexpr QUtf8StringView COUNT_ROWS  = "SELECT COUNT(*) rows FROM groups;";
+    static constexpr QUtf8StringView SELECT_PAGE = "SELECT * FROM groups ORDER BY id LIMIT :page_size;";
+    static constexpr QUtf8StringView SELECT_PAGE_AFTER =
+            "SELECT * FROM groups WHERE id > :after_id ORDER BY id LIMIT :page_size;";
+    static constexpr QUtf8StringView FIND_USER_BY_USERNAME = "select * from groups  where groupName = :groupName";
 
+    static constexpr std::array<core::db::ColumnDescriptor, 7> COLUMNS = {
+            {{"id", DataType::INTEGER, 0, Modifier::isPrimaryKey | Modifier::isAutoIncrement | Modifier::isUnique},
+             {"groupName", DataType::TEXT, 1, Modifier::isUnique},
+             {"description", DataType::TEXT, 2, Modifier::None},
+             {"modified_by", DataType::TEXT, 3, Modifier::None},
+             {"modified_at", DataType::DATETIME, 4, Modifier::None},
+             {"created_by", DataType::TEXT, 5, Modifier::isImmutable},
+             {"created_at", DataType::DATETIME, 6, Modifier::isImmutable}}};
 
-    QSqlQuery m_create;
-    QSqlQuery m_insert;
-    QSqlQuery m_update;
-    QSqlQuery m_deleteRow;
-    QSqlQuery m_selectPk;
-    QSqlQuery m_countRows;
-    QSqlQuery m_findUserByUsername;
+    std::shared_ptr<QSqlQuery> m_insert;
+    std::shared_ptr<QSqlQuery> m_update;
+    std::shared_ptr<QSqlQuery> m_deleteRow;
+    std::shared_ptr<QSqlQuery> m_selectPk;
+    std::array<int, 7>         m_selectPkFields{-1};
+    std::shared_ptr<QSqlQuery> m_countRows;
+    std::shared_ptr<QSqlQuery> m_selectPage;
+    std::shared_ptr<QSqlQuery> m_selectPageAfter;
+    std::array<int, 7>         m_selectPageFields{-1};
+    std::shared_ptr<QSqlQuery> m_findUserByUsername;
+    std::array<int, 7>         m_findUserByUsernameFields{-1};
 };
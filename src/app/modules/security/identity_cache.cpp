@@ -0,0 +1,182 @@
+/**
+ * @file identity_cache.cpp
+ * @brief Implementation file for the IdentityCache class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "identity_cache.h"
+
+namespace core::modules::security
+{
+    namespace
+    {
+        constexpr qsizetype POPULATE_PAGE_SIZE = 512; ///< Rows read per page when the tables are loaded.
+    } // namespace
+
+    IdentityCache::IdentityCache(const std::chrono::milliseconds timeToLive) :
+        m_timeToLive(timeToLive),
+        m_listener(db::SQLiteDbApi::addTableListener([this](const QString &table) { invalidate(table); }))
+    {
+    }
+
+    IdentityCache::~IdentityCache()
+    {
+        db::SQLiteDbApi::removeTableListener(m_listener);
+    }
+
+    void IdentityCache::populate(const QSqlDatabase &database)
+    {
+        QHash<QString, Users::Record>    users;
+        QHash<long long, QString>        userIds;
+        QHash<long long, Groups::Record> groups;
+
+        // The tables are read a page at a time through the generated classes
+        const auto loaded     = Clock::now();
+        const auto generation = m_generation.load();
+        Users      usersTable(database);
+        for (auto page = usersTable.selectPage(nullptr, POPULATE_PAGE_SIZE); !page.isEmpty();
+             page = usersTable.selectPage(&page.last(), POPULATE_PAGE_SIZE))
+        {
+            // The last row of the page is the key of the next one, so the rows are copied
+            for (const auto &user: page)
+            {
+                userIds.insert(user.m_id, user.m_username);
+                users.insert(user.m_username, user);
+            }
+        }
+
+        Groups groupsTable(database);
+        for (auto page = groupsTable.selectPage(nullptr, POPULATE_PAGE_SIZE); !page.isEmpty();
+             page = groupsTable.selectPage(&page.last(), POPULATE_PAGE_SIZE))
+        {
+            for (const auto &group: page)
+            {
+                groups.insert(group.m_id, group);
+            }
+        }
+
+        QWriteLocker locker(&m_lock);
+        // A user written while the tables were read would be cached stale
+        if (generation == m_generation.load())
+        {
+            m_users       = std::move(users);
+            m_userIds     = std::move(userIds);
+            m_usersLoaded = loaded;
+        }
+        m_groups       = std::move(groups);
+        m_groupsLoaded = loaded;
+    }
+
+    std::optional<Users::Record> IdentityCache::user(const QString &username) const
+    {
+        QReadLocker locker(&m_lock);
+        const auto  it    = m_users.constFind(username);
+        const auto  found = it != m_users.cend() && isFresh(m_usersLoaded);
+        count(found);
+        if (!found)
+        {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    std::optional<Users::Record> IdentityCache::userById(const long long id) const
+    {
+        QReadLocker locker(&m_lock);
+        const auto  username = m_userIds.constFind(id);
+        const auto  it       = username != m_userIds.cend() ? m_users.constFind(*username) : m_users.cend();
+        const auto  found    = it != m_users.cend() && isFresh(m_usersLoaded);
+        count(found);
+        if (!found)
+        {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    std::optional<Groups::Record> IdentityCache::group(const long long id) const
+    {
+        QReadLocker locker(&m_lock);
+        const auto  it    = m_groups.constFind(id);
+        const auto  found = it != m_groups.cend() && isFresh(m_groupsLoaded);
+        count(found);
+        if (!found)
+        {
+            return std::nullopt;
+        }
+        return *it;
+    }
+
+    quint64 IdentityCache::generation() const
+    {
+        return m_generation.load();
+    }
+
+    void IdentityCache::store(const Users::Record &record, const quint64 generation)
+    {
+        QWriteLocker locker(&m_lock);
+        if (generation != m_generation.load())
+        {
+            return;
+        }
+        // An expired copy is dropped, the stored user starts a new one
+        if (!isFresh(m_usersLoaded))
+        {
+            m_users.clear();
+            m_userIds.clear();
+            m_usersLoaded = Clock::now();
+        }
+        m_userIds.insert(record.m_id, record.m_username);
+        m_users.insert(record.m_username, record);
+    }
+
+    void IdentityCache::invalidate(const QString &table)
+    {
+        if (table == "users")
+        {
+            QWriteLocker locker(&m_lock);
+            // Increased under the lock, so store() cannot add a row read before the write
+            ++m_generation;
+            m_users.clear();
+            m_userIds.clear();
+        }
+        else if (table == "groups")
+        {
+            QWriteLocker locker(&m_lock);
+            m_groups.clear();
+        }
+        else
+        {
+            return;
+        }
+        ++m_invalidations;
+    }
+
+    void IdentityCache::clear()
+    {
+        QWriteLocker locker(&m_lock);
+        ++m_generation;
+        m_users.clear();
+        m_userIds.clear();
+        m_groups.clear();
+    }
+
+    IdentityCache::Metrics IdentityCache::metrics() const
+    {
+        return {m_hits.load(std::memory_order_relaxed), m_misses.load(std::memory_order_relaxed),
+                m_invalidations.load(std::memory_order_relaxed)};
+    }
+
+    void IdentityCache::count(const bool found) const
+    {
+        (found ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+    }
+
+    bool IdentityCache::isFresh(const Clock::time_point loaded) const
+    {
+        return Clock::now() - loaded < m_timeToLive;
+    }
+} // namespace core::modules::security
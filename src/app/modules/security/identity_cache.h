@@ -0,0 +1,163 @@
+/**
+ * @file identity_cache.h
+ * @brief Contains the declaration of the IdentityCache class.
+ *
+ * This file declares the IdentityCache class, which keeps the users and groups in memory so
+ * the security checks do not query the database on every call.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QReadWriteLock>
+#include <QSqlDatabase>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include "groups.h"
+#include "users.h"
+
+namespace core::modules::security
+{
+    /**
+     * @class IdentityCache
+     * @brief In-memory copy of the users and groups tables.
+     *
+     * Users are kept by username with an index by id, groups by id, in QHash tables, which
+     * store their nodes in open addressing spans instead of a node per bucket. Every insert,
+     * update or delete of the generated Users and Groups classes drops the copy of the written
+     * table, so a lookup never returns a row older than the last write of this process. The
+     * cache can be read and invalidated from any thread.
+     *
+     * Writes of other processes, or of SQL run outside the generated classes, are not notified.
+     * They are only seen once the copy of the table outlives its time to live, after which the
+     * lookups miss until it is loaded again, so a changed password or group may be honoured for
+     * up to that long.
+     */
+    class IdentityCache
+    {
+    public:
+        /**
+         * @brief Counters of the cache lookups.
+         */
+        struct Metrics
+        {
+            quint64 hits          = 0; ///< Lookups answered by the cache.
+            quint64 misses        = 0; ///< Lookups that had to query the database.
+            quint64 invalidations = 0; ///< Times a table copy was dropped by a write.
+        };
+
+        static constexpr std::chrono::seconds DEFAULT_TIME_TO_LIVE{60}; ///< Default age of a usable table copy.
+
+        /**
+         * @brief Constructs an empty cache and registers it as a table listener.
+         * @param timeToLive The age after which a table copy is no longer used, see the class description.
+         */
+        explicit IdentityCache(std::chrono::milliseconds timeToLive = DEFAULT_TIME_TO_LIVE);
+
+        /**
+         * @brief Unregisters the cache from the table listeners.
+         */
+        ~IdentityCache();
+
+        IdentityCache(const IdentityCache &)            = delete;
+        IdentityCache &operator=(const IdentityCache &) = delete;
+
+        /**
+         * @brief Loads every user and group of a database, replacing the cached ones.
+         * @param database The connection to read from.
+         * @throws SQLError if the tables cannot be read.
+         */
+        void populate(const QSqlDatabase &database);
+
+        /**
+         * @brief Looks up a user by username.
+         * @param username The username.
+         * @return The user, or nothing if it is not cached.
+         */
+        [[nodiscard]] std::optional<Users::Record> user(const QString &username) const;
+
+        /**
+         * @brief Looks up a user by id.
+         * @param id The id of the user.
+         * @return The user, or nothing if it is not cached.
+         */
+        [[nodiscard]] std::optional<Users::Record> userById(long long id) const;
+
+        /**
+         * @brief Looks up a group by id.
+         * @param id The id of the group.
+         * @return The group, or nothing if it is not cached.
+         */
+        [[nodiscard]] std::optional<Groups::Record> group(long long id) const;
+
+        /**
+         * @brief Retrieves the generation of the users copy, increased by every write to the table.
+         *
+         * Read it before querying a user missing from the cache and pass it to store(), so a row
+         * read before a concurrent write is not cached after it.
+         *
+         * @return The generation.
+         */
+        [[nodiscard]] quint64 generation() const;
+
+        /**
+         * @brief Caches a user read from the database.
+         * @param record The user.
+         * @param generation The generation read before querying the user.
+         */
+        void store(const Users::Record &record, quint64 generation);
+
+        /**
+         * @brief Drops the copy of a table.
+         * @param table The name of the table, users or groups, any other one is ignored.
+         */
+        void invalidate(const QString &table);
+
+        /**
+         * @brief Drops every cached user and group.
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the lookup counters.
+         * @return The counters since the cache was constructed.
+         */
+        [[nodiscard]] Metrics metrics() const;
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @brief Counts a lookup.
+         * @param found Whether the lookup was answered by the cache.
+         */
+        void count(bool found) const;
+
+        /**
+         * @brief Checks whether a table copy is younger than the time to live, called with the lock held.
+         * @param loaded The time the copy was loaded.
+         * @return true if the copy can answer lookups.
+         */
+        [[nodiscard]] bool isFresh(Clock::time_point loaded) const;
+
+        mutable QReadWriteLock           m_lock; ///< Lookups run in the login worker threads.
+        QHash<QString, Users::Record>    m_users; ///< Users by username.
+        QHash<long long, QString>        m_userIds; ///< Usernames by user id.
+        QHash<long long, Groups::Record> m_groups; ///< Groups by id.
+        std::atomic<quint64>             m_generation    = 0; ///< Writes to the users table.
+        mutable std::atomic<quint64>     m_hits          = 0; ///< Lookups answered by the cache.
+        mutable std::atomic<quint64>     m_misses        = 0; ///< Lookups not answered by the cache.
+        std::atomic<quint64>             m_invalidations = 0; ///< Table copies dropped.
+        std::chrono::milliseconds        m_timeToLive; ///< Age after which a table copy is not used.
+        Clock::time_point                m_usersLoaded; ///< Time the users copy was started.
+        Clock::time_point                m_groupsLoaded; ///< Time the groups copy was started.
+        qsizetype                        m_listener; ///< Handle of the table listener.
+    };
+} // namespace core::modules::security
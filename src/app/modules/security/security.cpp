@@ -11,10 +11,94 @@
 #include "groups.h"
 #include "users.h"
 
-#include <qcryptographichash.h>
+#include <QDebug>
+#include <QDeadlineTimer>
+#include <QHash>
+#include <QMutex>
+#include <QtConcurrentRun>
+#include <algorithm>
+#include <chrono>
+#include "db/db_manager.h"
+#include "db/transaction.h"
+#include "tools/password_hash.h"
 
 namespace core::modules::security
 {
+    namespace
+    {
+        /**
+         * @class LoginThrottle
+         * @brief Failed login attempts by user, blocking the user with an exponential backoff.
+         */
+        class LoginThrottle
+        {
+        public:
+            static constexpr int                       FREE_ATTEMPTS = 3; ///< Failures allowed without delay.
+            static constexpr std::chrono::milliseconds FIRST_DELAY{1000}; ///< Block after the first delayed failure.
+            static constexpr std::chrono::milliseconds MAX_DELAY{300000}; ///< Longest block.
+            static constexpr qsizetype                 MAX_USERS = 1024; ///< Users tracked before pruning.
+
+            /**
+             * @brief Checks whether a user is blocked.
+             * @param user The username.
+             * @return true if the user must wait before trying again.
+             */
+            bool isBlocked(const QString &user)
+            {
+                QMutexLocker locker(&m_mutex);
+                const auto   it = m_attempts.constFind(user.toLower());
+                return it != m_attempts.cend() && !it->blockedUntil.hasExpired();
+            }
+
+            /**
+             * @brief Records a failure, blocking the user once the free attempts are spent.
+             * @param user The username.
+             */
+            void failed(const QString &user)
+            {
+                QMutexLocker locker(&m_mutex);
+                if (m_attempts.size() >= MAX_USERS)
+                {
+                    m_attempts.removeIf([](const QHash<QString, Attempts>::iterator it)
+                                        { return it->blockedUntil.hasExpired(); });
+                }
+                auto &attempts = m_attempts[user.toLower()];
+                if (++attempts.failures > FREE_ATTEMPTS)
+                {
+                    const auto exponent = std::min(attempts.failures - FREE_ATTEMPTS - 1, 16);
+                    const auto delay =
+                            std::min<std::chrono::milliseconds>(FIRST_DELAY * (1 << exponent), MAX_DELAY);
+                    attempts.blockedUntil.setRemainingTime(delay);
+                }
+            }
+
+            /**
+             * @brief Forgets the failures of a user.
+             * @param user The username.
+             */
+            void succeeded(const QString &user)
+            {
+                QMutexLocker locker(&m_mutex);
+                m_attempts.remove(user.toLower());
+            }
+
+        private:
+            /**
+             * @brief Failures of a user.
+             */
+            struct Attempts
+            {
+                int            failures = 0; ///< Consecutive failures.
+                QDeadlineTimer blockedUntil{0}; ///< End of the block, already expired while not blocked.
+            };
+
+            QMutex                   m_mutex; ///< Logins run in worker threads.
+            QHash<QString, Attempts> m_attempts; ///< Failures by lowercase username.
+        };
+
+        LoginThrottle throttle; ///< Failed login attempts of the application.
+    } // namespace
+
     Security::Security() : Module("Security", "Security module", 10)
     {
     }
@@ -27,17 +111,18 @@ namespace core::modules::security
 
     void Security::initialize()
     {
-        // If the table does not exist, the preparation of all the statements will fail,
-        // so we first create the table and then make queries on it.
-        {
-            Groups groupTable;
-            groupTable.create();
-            Users userTable;
-            userTable.create();
-        }
-        Groups         groupTable;
+        // The initialization runs in a worker thread, so it cannot use the main connection
+        const auto lease    = db::DBManager::manager().lease("main");
+        const auto database = lease.database();
+        // The statements are prepared on their first use, so the tables can be created
+        // by the same objects that query them afterwards.
+        Groups         groupTable(database);
         Groups::Record group;
-        Users          userTable;
+        Users          userTable(database);
+        // The schema and the default accounts are created all or nothing
+        db::Transaction transaction(database);
+        groupTable.create();
+        userTable.create();
         if (groupTable.countRows() == 0)
         {
             group.m_id          = 0;
@@ -52,38 +137,91 @@ namespace core::modules::security
         {
             Users::Record user;
             user.m_username    = "admin";
-            user.m_password    = hashString("admin");
+            user.m_password    = tools::PasswordHash::hash("admin");
             user.m_created_by  = "admin";
             user.m_modified_by = "admin";
             user.m_groupId     = group.m_id;
             userTable.insert(user);
         }
+        transaction.commit();
+        m_identities.populate(database);
         emit progressChanged(50);
     }
 
     void Security::stop()
     {
+        const auto metrics = m_identities.metrics();
+        qDebug() << "Identity cache hits:" << metrics.hits << "misses:" << metrics.misses
+                 << "invalidations:" << metrics.invalidations;
+    }
+
+    IdentityCache &Security::identities()
+    {
+        return m_identities;
     }
 
     Security::LoginStatus Security::login(const QString &user, const QString &password)
     {
-        Users         users;
-        Users::Record record;
-        record.m_username = user;
-        record.m_password = hashString(password);
-        if (!users.findUserByUsername(record))
+        if (throttle.isBlocked(user))
         {
+            return LoginStatus::TOO_MANY_ATTEMPTS;
+        }
+
+        auto      &identities = security().m_identities;
+        const auto generation = identities.generation();
+        auto       record     = identities.user(user);
+        if (!record)
+        {
+            // Logins run in worker threads, which lease their own connection
+            const auto    lease = db::DBManager::manager().lease("main");
+            Users         users(lease.database());
+            Users::Record found;
+            found.m_username = user;
+            if (users.findUserByUsername(found))
+            {
+                identities.store(found, generation);
+                record = std::move(found);
+            }
+        }
+        if (!record)
+        {
+            // Hash anyway, so the response time does not tell which users exist
+            static const auto unknownUser = tools::PasswordHash::hash(QString());
+            static_cast<void>(tools::PasswordHash::verify(password, unknownUser));
+            throttle.failed(user);
             return LoginStatus::USER_DOES_NOT_EXIST;
         }
-        if (!users.findUserByUsernamePassword(record))
+        if (!tools::PasswordHash::verify(password, record->m_password))
         {
+            throttle.failed(user);
             return LoginStatus::PASSWORD_IS_INCORRECT;
         }
+        throttle.succeeded(user);
+
+        if (tools::PasswordHash::needsRehash(record->m_password))
+        {
+            const auto lease      = db::DBManager::manager().lease("main");
+            Users      users(lease.database());
+            record->m_password    = tools::PasswordHash::hash(password);
+            record->m_modified_by = user;
+            users.update(*record);
+        }
         return LoginStatus::USER_IDENTIFIED;
     }
 
+    QFuture<Security::LoginStatus> Security::loginAsync(const QString &user, const QString &password)
+    {
+        return QtConcurrent::run([user, password]() { return login(user, password); });
+    }
+
     Security::LoginStatus Security::checkUser(const QString &user)
     {
+        auto &identities = security().m_identities;
+        if (identities.user(user))
+        {
+            return LoginStatus::USER_IDENTIFIED;
+        }
+        const auto    generation = identities.generation();
         Users         users;
         Users::Record record;
         record.m_username = user;
@@ -91,15 +229,8 @@ namespace core::modules::security
         {
             return LoginStatus::USER_DOES_NOT_EXIST;
         }
+        identities.store(record, generation);
         return LoginStatus::USER_IDENTIFIED;
     }
 
-    QString Security::hashString(const QString &value)
-    {
-        const QByteArray   byteArray = value.toUtf8();
-        QCryptographicHash hash(QCryptographicHash::Sha512);
-        hash.addData(byteArray);
-        return hash.result().toHex();
-    }
-
 }; // namespace core::modules::security
@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include <QFuture>
+#include "identity_cache.h"
 #include "module.h"
 
 /**
@@ -41,7 +43,8 @@ namespace core::modules::security
             NOT_LOGGED_IN, ///< The user is not logged in.
             USER_DOES_NOT_EXIST, ///< The provided username does not exist.
             PASSWORD_IS_INCORRECT, ///< The password provided is incorrect.
-            USER_IDENTIFIED ///< The user has been successfully identified.
+            USER_IDENTIFIED, ///< The user has been successfully identified.
+            TOO_MANY_ATTEMPTS ///< The user failed too many times, the attempt was not checked.
         };
 
         /**
@@ -73,8 +76,10 @@ namespace core::modules::security
         /**
          * @brief Attempts to log in a user with the provided credentials.
          *
-         * This method verifies the provided username and password, and returns the status
-         * of the login attempt.
+         * This method fetches the user once and verifies the password against its salted hash
+         * in constant time, rehashing it when it uses an older scheme or a lower work factor.
+         * After a few failures the user is throttled with an increasing delay. Hashing is slow
+         * by design, so the UI must use loginAsync() instead.
          *
          * @param user The username of the user attempting to log in.
          * @param chars The password associated with the username.
@@ -82,6 +87,14 @@ namespace core::modules::security
          */
         static LoginStatus login(const QString &user, const QString &chars);
 
+        /**
+         * @brief Runs login() in a worker thread.
+         * @param user The username of the user attempting to log in.
+         * @param chars The password associated with the username.
+         * @return The future login status.
+         */
+        static QFuture<LoginStatus> loginAsync(const QString &user, const QString &chars);
+
         /**
          * @brief Checks if a user exists in the system.
          *
@@ -93,15 +106,14 @@ namespace core::modules::security
         static LoginStatus checkUser(const QString &user);
 
         /**
-         * @brief Hashes a string using the application's hashing algorithm.
+         * @brief Retrieves the cache of users and groups used by the security checks.
          *
-         * This method securely hashes the given string, typically used for password storage
-         * or verification purposes.
+         * It is loaded by initialize() and refilled user by user on the lookups that miss it,
+         * its metrics tell how many lookups reached the database.
          *
-         * @param value The string to hash.
-         * @return A hashed representation of the input string.
+         * @return A reference to the identity cache.
          */
-        static QString hashString(const QString &value);
+        IdentityCache &identities();
 
     private:
         /**
@@ -110,5 +122,7 @@ namespace core::modules::security
          * This constructor is private to enforce the Singleton design pattern.
          */
         explicit Security();
+
+        IdentityCache m_identities; ///< Users and groups in memory.
     };
 } // namespace core::modules::security
@@ -12,87 +12,180 @@
 #include <QSqlError>
 #include <QSqlRecord>
 #include "db/db_exception.h"
+#include "db/query_profiler.h"
+#include "tools/trace.h"
 
-Users::Users(const QSqlDatabase &db) :
-    core::db::SQLiteDbApi(db), m_create(m_database), m_insert(m_database), m_update(m_database),
-    m_deleteRow(m_database), m_selectPk(m_database), m_countRows(m_database), m_findUserByUsername(m_database),
-    m_findUserByUsernamePassword(m_database), m_findUserByEmail(m_database)
+Users::Users(const QSqlDatabase &db) : core::db::SQLiteDbApi(db)
 {
-    m_insert.prepare(INSERT);
-    m_update.prepare(UPDATE);
-    m_deleteRow.prepare(DELETE_ROW);
-    m_selectPk.prepare(SELECT_PK);
-    m_countRows.prepare(COUNT_ROWS);
-    m_findUserByUsername.prepare(FIND_USER_BY_USERNAME);
-    m_findUserByUsernamePassword.prepare(FIND_USER_BY_USERNAME_PASSWORD);
-    m_findUserByEmail.prepare(FIND_USER_BY_EMAIL);
 }
 
 void Users::create()
 {
-    std::array<QString, 2> sentences = {CREATE, CREATE_INDEX_1};
-    for (auto &sentence: sentences)
+    const core::tools::ScopedSpan            span("Users::create", "db");
+    constexpr std::array<QUtf8StringView, 3> sentences = {CREATE, CREATE_INDEX_1, CREATE_INDEX_2};
+    QSqlQuery                                query(m_database);
+    for (const auto &sentence: sentences)
     {
-        if (!m_create.exec(sentence))
+        if (!query.exec(sentence.toString()))
         {
-            throw core::db::SQLError(m_create.lastError().text());
+            throw core::db::SQLError(query.lastError().text());
         }
     }
 }
 
 void Users::insert(Record &record)
 {
-    m_insert.bindValue(":username", record.m_username);
-    m_insert.bindValue(":password", record.m_password);
-    m_insert.bindValue(":email", record.m_email);
-    m_insert.bindValue(":groupId", record.m_groupId);
-    m_insert.bindValue(":modified_by", record.m_modified_by);
-    m_insert.bindValue(":created_by", record.m_created_by);
-    if (!m_insert.exec())
+    ensurePrepared(m_insert, INSERT);
+    core::db::ProfiledQuery profile(m_database, "Users::insert");
+    m_insert->bindValue(":username", record.m_username);
+    m_insert->bindValue(":password", record.m_password);
+    m_insert->bindValue(":email", record.m_email);
+    m_insert->bindValue(":groupId", record.m_groupId);
+    m_insert->bindValue(":modified_by", record.m_modified_by);
+    m_insert->bindValue(":created_by", record.m_created_by);
+    if (!profile.exec(*m_insert))
     {
-        throw core::db::SQLError(m_insert.lastError().text());
+        throw core::db::SQLError(m_insert->lastError().text());
     }
-    record.m_id = getLastInsertRowId();
+    record.m_id = lastInsertRowId(*m_insert);
+    notifyTableChanged("users");
+}
+
+void Users::insertBatch(std::span<Record> records)
+{
+    if (records.empty())
+    {
+        return;
+    }
+    QVariantList usernameValues;
+    usernameValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList passwordValues;
+    passwordValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList emailValues;
+    emailValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList groupIdValues;
+    groupIdValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList modified_byValues;
+    modified_byValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList created_byValues;
+    created_byValues.reserve(static_cast<qsizetype>(records.size()));
+    for (const auto &record: records)
+    {
+        usernameValues << record.m_username;
+        passwordValues << record.m_password;
+        emailValues << record.m_email;
+        groupIdValues << record.m_groupId;
+        modified_byValues << record.m_modified_by;
+        created_byValues << record.m_created_by;
+    }
+    ensurePrepared(m_insert, INSERT);
+    m_insert->bindValue(":username", usernameValues);
+    m_insert->bindValue(":password", passwordValues);
+    m_insert->bindValue(":email", emailValues);
+    m_insert->bindValue(":groupId", groupIdValues);
+    m_insert->bindValue(":modified_by", modified_byValues);
+    m_insert->bindValue(":created_by", created_byValues);
+    execBatch(*m_insert, "Users::insertBatch");
+    // The batch runs inside one transaction, so its rows get consecutive ids
+    auto lastId = lastInsertRowId(*m_insert) - static_cast<long long>(records.size());
+    for (auto &record: records)
+    {
+        record.m_id = ++lastId;
+    }
+    notifyTableChanged("users");
 }
 
 void Users::update(Record &record)
 {
+    ensurePrepared(m_update, UPDATE);
+    core::db::ProfiledQuery profile(m_database, "Users::update");
+    m_update->bindValue(":username", record.m_username);
+    m_update->bindValue(":password", record.m_password);
+    m_update->bindValue(":email", record.m_email);
+    m_update->bindValue(":groupId", record.m_groupId);
+    m_update->bindValue(":modified_by", record.m_modified_by);
+    m_update->bindValue(":id", record.m_id);
+    if (!profile.exec(*m_update))
+    {
+        throw core::db::SQLError(m_update->lastError().text());
+    }
+    notifyTableChanged("users");
+}
 
-    if (!m_update.exec())
+void Users::updateBatch(std::span<Record> records)
+{
+    if (records.empty())
     {
-        throw core::db::SQLError(m_update.lastError().text());
+        return;
     }
+    QVariantList usernameValues;
+    usernameValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList passwordValues;
+    passwordValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList emailValues;
+    emailValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList groupIdValues;
+    groupIdValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList modified_byValues;
+    modified_byValues.reserve(static_cast<qsizetype>(records.size()));
+    QVariantList idValues;
+    idValues.reserve(static_cast<qsizetype>(records.size()));
+    for (const auto &record: records)
+    {
+        usernameValues << record.m_username;
+        passwordValues << record.m_password;
+        emailValues << record.m_email;
+        groupIdValues << record.m_groupId;
+        modified_byValues << record.m_modified_by;
+        idValues << record.m_id;
+    }
+    ensurePrepared(m_update, UPDATE);
+    m_update->bindValue(":username", usernameValues);
+    m_update->bindValue(":password", passwordValues);
+    m_update->bindValue(":email", emailValues);
+    m_update->bindValue(":groupId", groupIdValues);
+    m_update->bindValue(":modified_by", modified_byValues);
+    m_update->bindValue(":id", idValues);
+    execBatch(*m_update, "Users::updateBatch");
+    notifyTableChanged("users");
 }
 
 void Users::deleteRow(Record &record)
 {
-
-    if (!m_deleteRow.exec())
+    ensurePrepared(m_deleteRow, DELETE_ROW);
+    core::db::ProfiledQuery profile(m_database, "Users::deleteRow");
+    m_deleteRow->bindValue(":id", record.m_id);
+    if (!profile.exec(*m_deleteRow))
     {
-        throw core::db::SQLError(m_deleteRow.lastError().text());
+        throw core::db::SQLError(m_deleteRow->lastError().text());
     }
+    notifyTableChanged("users");
 }
 
 bool Users::selectPk(Record &record)
 {
-
-    if (!m_selectPk.exec())
+    ensurePrepared(m_selectPk, SELECT_PK);
+    core::db::ProfiledQuery profile(m_database, "Users::selectPk");
+    m_selectPk->bindValue(":id", record.m_id);
+    if (!profile.exec(*m_selectPk))
     {
-        throw core::db::SQLError(m_selectPk.lastError().text());
+        throw core::db::SQLError(m_selectPk->lastError().text());
     }
-    if (m_selectPk.next())
+    if (m_selectPk->next())
     {
-        const auto sqlRecord = m_selectPk.record();
-        record.m_id          = sqlRecord.value("id").toLongLong();
-        record.m_username    = sqlRecord.value("username").toString();
-        record.m_password    = sqlRecord.value("password").toString();
-        record.m_email       = sqlRecord.value("email").toString();
-        record.m_groupId     = sqlRecord.value("groupId").toLongLong();
-        record.m_modified_by = sqlRecord.value("modified_by").toString();
-        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
-        record.m_created_by  = sqlRecord.value("created_by").toString();
-        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
+        core::db::QueryProfiler::addRows("Users::selectPk", 1);
+        const auto &fields   = resolveFields(*m_selectPk, m_selectPkFields, COLUMNS);
+        record.m_id          = fromVariant<COLUMNS[0].type>(m_selectPk->value(fields[0]));
+        record.m_username    = fromVariant<COLUMNS[1].type>(m_selectPk->value(fields[1]));
+        record.m_password    = fromVariant<COLUMNS[2].type>(m_selectPk->value(fields[2]));
+        record.m_email       = fromVariant<COLUMNS[3].type>(m_selectPk->value(fields[3]));
+        record.m_groupId     = fromVariant<COLUMNS[4].type>(m_selectPk->value(fields[4]));
+        record.m_modified_by = fromVariant<COLUMNS[5].type>(m_selectPk->value(fields[5]));
+        record.m_modified_at = fromVariant<COLUMNS[6].type>(m_selectPk->value(fields[6]));
+        record.m_created_by  = fromVariant<COLUMNS[7].type>(m_selectPk->value(fields[7]));
+        record.m_created_at  = fromVariant<COLUMNS[8].type>(m_selectPk->value(fields[8]));
 
+        m_selectPk->finish();
         return true;
     }
     return false;
@@ -100,65 +193,87 @@ bool Users::selectPk(Record &record)
 
 long long Users::countRows()
 {
+    ensurePrepared(m_countRows, COUNT_ROWS);
+    core::db::ProfiledQuery profile(m_database, "Users::countRows");
 
-    if (!m_countRows.exec())
+    if (!profile.exec(*m_countRows))
     {
-        throw core::db::SQLError(m_countRows.lastError().text());
+        throw core::db::SQLError(m_countRows->lastError().text());
     }
-    if (m_countRows.next())
+    long long rows = 0;
+    if (m_countRows->next())
     {
-        const auto sqlRecord = m_countRows.record();
-        return sqlRecord.value("rows").toLongLong();
+        rows = m_countRows->value(0).toLongLong();
     }
-    return 0;
+    m_countRows->finish();
+    return rows;
 }
 
-bool Users::findUserByUsername(Record &record)
+QList<Users::Record> Users::selectPage(const Record *after, qsizetype limit)
 {
-    m_findUserByUsername.bindValue(":username", record.m_username);
-    if (!m_findUserByUsername.exec())
+    if (after == nullptr)
     {
-        throw core::db::SQLError(m_findUserByUsername.lastError().text());
+        ensurePrepared(m_selectPage, SELECT_PAGE);
     }
-    if (m_findUserByUsername.next())
+    else
     {
-        const auto sqlRecord = m_findUserByUsername.record();
-        record.m_id          = sqlRecord.value("id").toLongLong();
-        record.m_username    = sqlRecord.value("username").toString();
-        record.m_password    = sqlRecord.value("password").toString();
-        record.m_email       = sqlRecord.value("email").toString();
-        record.m_groupId     = sqlRecord.value("groupId").toLongLong();
-        record.m_modified_by = sqlRecord.value("modified_by").toString();
-        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
-        record.m_created_by  = sqlRecord.value("created_by").toString();
-        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
+        ensurePrepared(m_selectPageAfter, SELECT_PAGE_AFTER);
+    }
+    const auto             &query = after == nullptr ? m_selectPage : m_selectPageAfter;
+    core::db::ProfiledQuery profile(m_database, "Users::selectPage");
 
-        return true;
+    if (after != nullptr)
+    {
+        query->bindValue(":after_id", after->m_id);
     }
-    return false;
+    query->bindValue(":page_size", limit);
+    if (!profile.exec(*query))
+    {
+        throw core::db::SQLError(query->lastError().text());
+    }
+    QList<Record> records;
+    while (query->next())
+    {
+        const auto &fields = resolveFields(*query, m_selectPageFields, COLUMNS);
+        auto       &row    = records.emplace_back();
+        row.m_id           = fromVariant<COLUMNS[0].type>(query->value(fields[0]));
+        row.m_username     = fromVariant<COLUMNS[1].type>(query->value(fields[1]));
+        row.m_password     = fromVariant<COLUMNS[2].type>(query->value(fields[2]));
+        row.m_email        = fromVariant<COLUMNS[3].type>(query->value(fields[3]));
+        row.m_groupId      = fromVariant<COLUMNS[4].type>(query->value(fields[4]));
+        row.m_modified_by  = fromVariant<COLUMNS[5].type>(query->value(fields[5]));
+        row.m_modified_at  = fromVariant<COLUMNS[6].type>(query->value(fields[6]));
+        row.m_created_by   = fromVariant<COLUMNS[7].type>(query->value(fields[7]));
+        row.m_created_at   = fromVariant<COLUMNS[8].type>(query->value(fields[8]));
+    }
+    core::db::QueryProfiler::addRows("Users::selectPage", static_cast<quint64>(records.size()));
+    return records;
 }
 
-bool Users::findUserByUsernamePassword(Record &record)
+bool Users::findUserByUsername(Record &record)
 {
-    m_findUserByUsernamePassword.bindValue(":username", record.m_username);
-    m_findUserByUsernamePassword.bindValue(":password", record.m_password);
-    if (!m_findUserByUsernamePassword.exec())
+    ensurePrepared(m_findUserByUsername, FIND_USER_BY_USERNAME);
+    core::db::ProfiledQuery profile(m_database, "Users::findUserByUsername");
+    m_findUserByUsername->bindValue(":username", record.m_username);
+    if (!profile.exec(*m_findUserByUsername))
     {
-        throw core::db::SQLError(m_findUserByUsernamePassword.lastError().text());
+        throw core::db::SQLError(m_findUserByUsername->lastError().text());
     }
-    if (m_findUserByUsernamePassword.next())
+    if (m_findUserByUsername->next())
     {
-        const auto sqlRecord = m_findUserByUsernamePassword.record();
-        record.m_id          = sqlRecord.value("id").toLongLong();
-        record.m_username    = sqlRecord.value("username").toString();
-        record.m_password    = sqlRecord.value("password").toString();
-        record.m_email       = sqlRecord.value("email").toString();
-        record.m_groupId     = sqlRecord.value("groupId").toLongLong();
-        record.m_modified_by = sqlRecord.value("modified_by").toString();
-        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
-        record.m_created_by  = sqlRecord.value("created_by").toString();
-        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
+        core::db::QueryProfiler::addRows("Users::findUserByUsername", 1);
+        const auto &fields   = resolveFields(*m_findUserByUsername, m_findUserByUsernameFields, COLUMNS);
+        record.m_id          = fromVariant<COLUMNS[0].type>(m_findUserByUsername->value(fields[0]));
+        record.m_username    = fromVariant<COLUMNS[1].type>(m_findUserByUsername->value(fields[1]));
+        record.m_password    = fromVariant<COLUMNS[2].type>(m_findUserByUsername->value(fields[2]));
+        record.m_email       = fromVariant<COLUMNS[3].type>(m_findUserByUsername->value(fields[3]));
+        record.m_groupId     = fromVariant<COLUMNS[4].type>(m_findUserByUsername->value(fields[4]));
+        record.m_modified_by = fromVariant<COLUMNS[5].type>(m_findUserByUsername->value(fields[5]));
+        record.m_modified_at = fromVariant<COLUMNS[6].type>(m_findUserByUsername->value(fields[6]));
+        record.m_created_by  = fromVariant<COLUMNS[7].type>(m_findUserByUsername->value(fields[7]));
+        record.m_created_at  = fromVariant<COLUMNS[8].type>(m_findUserByUsername->value(fields[8]));
 
+        m_findUserByUsername->finish();
         return true;
     }
     return false;
@@ -166,30 +281,74 @@ bool Users::findUserByUsernamePassword(Record &record)
 
 bool Users::findUserByEmail(Record &record)
 {
-    m_findUserByEmail.bindValue(":email", record.m_email);
-    if (!m_findUserByEmail.exec())
+    ensurePreparedCursor(m_findUserByEmail, FIND_USER_BY_EMAIL);
+    core::db::ProfiledQuery profile(m_database, "Users::findUserByEmail");
+    m_findUserByEmail->bindValue(":email", record.m_email);
+    if (!profile.exec(*m_findUserByEmail))
     {
-        throw core::db::SQLError(m_findUserByEmail.lastError().text());
+        throw core::db::SQLError(m_findUserByEmail->lastError().text());
     }
     return nextFindUserByEmail(record);
 }
 
 bool Users::nextFindUserByEmail(Record &record)
 {
-    if (m_findUserByEmail.next())
-    {
-        const auto sqlRecord = m_findUserByEmail.record();
-        record.m_id          = sqlRecord.value("id").toLongLong();
-        record.m_username    = sqlRecord.value("username").toString();
-        record.m_password    = sqlRecord.value("password").toString();
-        record.m_email       = sqlRecord.value("email").toString();
-        record.m_groupId     = sqlRecord.value("groupId").toLongLong();
-        record.m_modified_by = sqlRecord.value("modified_by").toString();
-        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
-        record.m_created_by  = sqlRecord.value("created_by").toString();
-        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
+    if (m_findUserByEmail && m_findUserByEmail->next())
+    {
+        core::db::QueryProfiler::addRows("Users::findUserByEmail", 1);
+        const auto &fields   = resolveFields(*m_findUserByEmail, m_findUserByEmailFields, COLUMNS);
+        record.m_id          = fromVariant<COLUMNS[0].type>(m_findUserByEmail->value(fields[0]));
+        record.m_username    = fromVariant<COLUMNS[1].type>(m_findUserByEmail->value(fields[1]));
+        record.m_password    = fromVariant<COLUMNS[2].type>(m_findUserByEmail->value(fields[2]));
+        record.m_email       = fromVariant<COLUMNS[3].type>(m_findUserByEmail->value(fields[3]));
+        record.m_groupId     = fromVariant<COLUMNS[4].type>(m_findUserByEmail->value(fields[4]));
+        record.m_modified_by = fromVariant<COLUMNS[5].type>(m_findUserByEmail->value(fields[5]));
+        record.m_modified_at = fromVariant<COLUMNS[6].type>(m_findUserByEmail->value(fields[6]));
+        record.m_created_by  = fromVariant<COLUMNS[7].type>(m_findUserByEmail->value(fields[7]));
+        record.m_created_at  = fromVariant<COLUMNS[8].type>(m_findUserByEmail->value(fields[8]));
 
         return true;
     }
     return false;
 }
+
+QList<Users::Record> Users::findUserByEmailPage(const Record &record, const Record *after, qsizetype limit)
+{
+    if (after == nullptr)
+    {
+        ensurePrepared(m_findUserByEmailPage, FIND_USER_BY_EMAIL_PAGE);
+    }
+    else
+    {
+        ensurePrepared(m_findUserByEmailPageAfter, FIND_USER_BY_EMAIL_PAGE_AFTER);
+    }
+    const auto             &query = after == nullptr ? m_findUserByEmailPage : m_findUserByEmailPageAfter;
+    core::db::ProfiledQuery profile(m_database, "Users::findUserByEmailPage");
+    query->bindValue(":email", record.m_email);
+    if (after != nullptr)
+    {
+        query->bindValue(":after_id", after->m_id);
+    }
+    query->bindValue(":page_size", limit);
+    if (!profile.exec(*query))
+    {
+        throw core::db::SQLError(query->lastError().text());
+    }
+    QList<Record> records;
+    while (query->next())
+    {
+        const auto &fields = resolveFields(*query, m_findUserByEmailPageFields, COLUMNS);
+        auto       &row    = records.emplace_back();
+        row.m_id           = fromVariant<COLUMNS[0].type>(query->value(fields[0]));
+        row.m_username     = fromVariant<COLUMNS[1].type>(query->value(fields[1]));
+        row.m_password     = fromVariant<COLUMNS[2].type>(query->value(fields[2]));
+        row.m_email        = fromVariant<COLUMNS[3].type>(query->value(fields[3]));
+        row.m_groupId      = fromVariant<COLUMNS[4].type>(query->value(fields[4]));
+        row.m_modified_by  = fromVariant<COLUMNS[5].type>(query->value(fields[5]));
+        row.m_modified_at  = fromVariant<COLUMNS[6].type>(query->value(fields[6]));
+        row.m_created_by   = fromVariant<COLUMNS[7].type>(query->value(fields[7]));
+        row.m_created_at   = fromVariant<COLUMNS[8].type>(query->value(fields[8]));
+    }
+    core::db::QueryProfiler::addRows("Users::findUserByEmailPage", static_cast<quint64>(records.size()));
+    return records;
+}
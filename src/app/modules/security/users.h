@@ -10,8 +10,11 @@
 
 #pragma once
 #include <QSqlQuery>
+#include <QUtf8StringView>
+#include <array>
 #include <memory>
 #include <qdatetime.h>
+#include <span>
 #include "db/db_manager.h"
 #include "db/sqlite/sqlite_db_api.h"
 
@@ -33,45 +36,73 @@ public:
 
     explicit Users(const QSqlDatabase &db = core::db::DBManager::manager().main());
 
-    void      create();
-    void      insert(Record &record);
-    void      update(Record &record);
-    void      deleteRow(Record &record);
-    bool      selectPk(Record &record);
-    long long countRows();
-    bool      findUserByUsername(Record &record);
-    bool      findUserByUsernamePassword(Record &record);
-    bool      findUserByEmail(Record &record);
-    bool      nextFindUserByEmail(Record &record);
+    void          create();
+    void          insert(Record &record);
+    void          insertBatch(std::span<Record> records);
+    void          update(Record &record);
+    void          updateBatch(std::span<Record> records);
+    void          deleteRow(Record &record);
+    bool          selectPk(Record &record);
+    long long     countRows();
+    QList<Record> selectPage(const Record *after, qsizetype limit);
+    bool          findUserByUsername(Record &record);
+    bool          findUserByEmail(Record &record);
+    bool          nextFindUserByEmail(Record &record);
+    QList<Record> findUserByEmailPage(const Record &record, const Record *after, qsizetype limit);
 
 private:
-    const QString CREATE =
+    static constexpr QUtf8StringView CREATE =
             "CREATE TABLE IF NOT EXISTS users ( id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE, username TEXT UNIQUE, "
             "password TEXT, email TEXT, groupId INTEGER, modified_by TEXT, modified_at DATETIME DEFAULT "
             "CURRENT_TIMESTAMP, created_by TEXT, created_at DATETIME DEFAULT CURRENT_TIMESTAMP );";
-    const QString CREATE_INDEX_1 = "CREATE INDEX IF NOT EXISTS idx_users_username ON users(username);";
-    const QString INSERT         = "INSERT INTO users (username, password, email, groupId, modified_by, modified_at, "
-                                   "created_by, created_at) VALUES (:username, :password, :email, :groupId, :modified_by, "
-                                   "CURRENT_TIMESTAMP, :created_by, CURRENT_TIMESTAMP);";
-    const QString UPDATE = "UPDATE users SET username=:username, password=:password, email=:email, groupId=:groupId, "
-                           "modified_by=:modified_by, modified_at=CURRENT_TIMESTAMP, created_by=:created_by, "
-                           "created_at=CURRENT_TIMESTAMP WHERE id=:id;";
-    const QString DELETE_ROW            = "DELETE FROM users WHERE id=:id;";
-    const QString SELECT_PK             = "SELECT * FROM users WHERE id=:id;";
-    const QString COUNT_ROWS            = "SELECT COUNT(*) rows FROM users;";
-    const QString FIND_USER_BY_USERNAME = "select * from users  where username = :username";
-    const QString FIND_USER_BY_USERNAME_PASSWORD =
-            "select * from users  where username = :username and password = :password";
-    const QString FIND_USER_BY_EMAIL = "select * from users  where email = :email";
+    static constexpr QUtf8StringView CREATE_INDEX_1 =
+            "CREATE INDEX IF NOT EXISTS idx_users_username ON users(username);";
+    static constexpr QUtf8StringView CREATE_INDEX_2 = "CREATE INDEX IF NOT EXISTS idx_users_email ON users(email);";
+    static constexpr QUtf8StringView INSERT =
+            "INSERT INTO users (username, password, email, groupId, modified_by, modified_at, created_by, "
+            "created_at) VALUES (:username, :password, :email, :groupId, :modified_by, CURRENT_TIMESTAMP, "
+            ":created_by, CURRENT_TIMESTAMP);";
+    static constexpr QUtf8StringView UPDATE =
+            "UPDATE users SET username=:username, password=:password, email=:email, groupId=:groupId, "
+            "modified_by=:modified_by, modified_at=CURRENT_TIMESTAMP WHERE id=:id;";
+    static constexpr QUtf8StringView DELETE_ROW  = "DELETE FROM users WHERE id=:id;";
+    static constexpr QUtf8StringView SELECT_PK   = "SELECT * FROM users WHERE id=:id;";
+    static constexpr QUtf8StringView COUNT_ROWS  = "SELECT COUNT(*) rows FROM users;";
+    static constexpr QUtf8StringView SELECT_PAGE = "SELECT * FROM users ORDER BY id LIMIT :page_size;";
+    static constexpr QUtf8StringView SELECT_PAGE_AFTER =
+            "SELECT * FROM users WHERE id > :after_id ORDER BY id LIMIT :page_size;";
+    static constexpr QUtf8StringView FIND_USER_BY_USERNAME = "select * from users  where username = :username";
+    static constexpr QUtf8StringView FIND_USER_BY_EMAIL    = "select * from users  where email = :email";
+    static constexpr QUtf8StringView FIND_USER_BY_EMAIL_PAGE =
+            "SELECT * FROM users WHERE email = :email ORDER BY id LIMIT :page_size;";
+    static constexpr QUtf8StringView FIND_USER_BY_EMAIL_PAGE_AFTER =
+            "SELECT * FROM users WHERE (email = :email) AND id > :after_id ORDER BY id LIMIT :page_size;";
 
+    static constexpr std::array<core::db::ColumnDescriptor, 9> COLUMNS = {
+            {{"id", DataType::INTEGER, 0, Modifier::isPrimaryKey | Modifier::isAutoIncrement | Modifier::isUnique},
+             {"username", DataType::TEXT, 1, Modifier::isUnique},
+             {"password", DataType::TEXT, 2, Modifier::None},
+             {"email", DataType::TEXT, 3, Modifier::None},
+             {"groupId", DataType::INTEGER, 4, Modifier::None},
+             {"modified_by", DataType::TEXT, 5, Modifier::None},
+             {"modified_at", DataType::DATETIME, 6, Modifier::None},
+             {"created_by", DataType::TEXT, 7, Modifier::isImmutable},
+             {"created_at", DataType::DATETIME, 8, Modifier::isImmutable}}};
 
-    QSqlQuery m_create;
-    QSqlQuery m_insert;
-    QSqlQuery m_update;
-    QSqlQuery m_deleteRow;
-    QSqlQuery m_selectPk;
-    QSqlQuery m_countRows;
-    QSqlQuery m_findUserByUsername;
-    QSqlQuery m_findUserByUsernamePassword;
-    QSqlQuery m_findUserByEmail;
+    std::shared_ptr<QSqlQuery> m_insert;
+    std::shared_ptr<QSqlQuery> m_update;
+    std::shared_ptr<QSqlQuery> m_deleteRow;
+    std::shared_ptr<QSqlQuery> m_selectPk;
+    std::array<int, 9>         m_selectPkFields{-1};
+    std::shared_ptr<QSqlQuery> m_countRows;
+    std::shared_ptr<QSqlQuery> m_selectPage;
+    std::shared_ptr<QSqlQuery> m_selectPageAfter;
+    std::array<int, 9>         m_selectPageFields{-1};
+    std::shared_ptr<QSqlQuery> m_findUserByUsername;
+    std::array<int, 9>         m_findUserByUsernameFields{-1};
+    std::shared_ptr<QSqlQuery> m_findUserByEmail;
+    std::array<int, 9>         m_findUserByEmailFields{-1};
+    std::shared_ptr<QSqlQuery> m_findUserByEmailPage;
+    std::shared_ptr<QSqlQuery> m_findUserByEmailPageAfter;
+    std::array<int, 9>         m_findUserByEmailPageFields{-1};
 };
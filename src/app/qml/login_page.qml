@@ -9,12 +9,14 @@ Page {
     signal registerClicked
 
     function login() {
-        let loginResult;
         if (loginPassword.text === "") {
-            loginResult = initDialog.checkUser(loginUsername.text);
-        } else {
-            loginResult = initDialog.login(loginUsername.text, loginPassword.text);
+            return showResult(initDialog.checkUser(loginUsername.text));
         }
+        // The password is verified in a worker thread, the result arrives through onLoginFinished
+        initDialog.login(loginUsername.text, loginPassword.text);
+        return false;
+    }
+    function showResult(loginResult) {
         switch (loginResult) {
         case 3:
             return true;
@@ -27,6 +29,9 @@ Page {
         case 2:
             popup.popMessage = "Incorrect password";
             break;
+        case 4:
+            popup.popMessage = "Too many failed attempts, try again later";
+            break;
         }
         popup.open();
         return false;
@@ -36,6 +41,19 @@ Page {
         color: Theme.backgroundColor
     }
 
+    Connections {
+        function onLoginFinished(loginResult) {
+            if (loginPage.showResult(loginResult)) {
+                initDialog.close();
+            } else {
+                loginPassword.clear();
+                loginPassword.forceActiveFocus();
+            }
+        }
+
+        target: initDialog
+    }
+
     ColumnLayout {
         spacing: 15
         width: parent.width
@@ -119,12 +137,7 @@ Page {
                 }
             }
 
-            onEditingFinished: {
-                if (!loginPage.login()) {
-                    loginPassword.clear();
-                    forceActiveFocus();
-                }
-            }
+            onEditingFinished: loginPage.login()
         }
         Item {
             Layout.preferredHeight: 20
@@ -0,0 +1,196 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QSqlQuery>
+#include <QThread>
+#include <QTimer>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <vector>
+#include "identity_cache.h"
+#include "tools/tools.h"
+
+using core::modules::security::IdentityCache;
+
+QSqlDatabase db;
+
+namespace
+{
+    Users::Record makeUser(const QString &name)
+    {
+        Users::Record record{};
+        record.m_username    = name;
+        record.m_password    = "password";
+        record.m_email       = name + "@invoice.manager";
+        record.m_groupId     = 1;
+        record.m_created_by  = "admin";
+        record.m_modified_by = "admin";
+        return record;
+    }
+} // namespace
+
+/**
+ * @brief Runs an IdentityCache over empty users and groups tables.
+ */
+class IdentityCacheTest : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        users.create();
+        groups.create();
+    }
+
+    void TearDown() override
+    {
+        QSqlQuery(db).exec("DELETE FROM users;");
+        QSqlQuery(db).exec("DELETE FROM groups;");
+    }
+
+    Users         users{db};
+    Groups        groups{db};
+    IdentityCache cache;
+};
+
+TEST_F(IdentityCacheTest, populate_reads_every_page)
+{
+    // More users than fit in a page of populate()
+    std::vector<Users::Record> records;
+    for (int i = 0; i < 600; i++)
+    {
+        records.push_back(makeUser(QString("user_%1").arg(i)));
+    }
+    users.insertBatch(records);
+    Groups::Record group{};
+    group.m_groupName   = "administrators";
+    group.m_description = "Administrators";
+    groups.insert(group);
+
+    cache.populate(db);
+    const auto first = cache.user("user_0");
+    ASSERT_TRUE(first.has_value());
+    EXPECT_EQ(first->m_id, records.front().m_id);
+    const auto last = cache.userById(records.back().m_id);
+    ASSERT_TRUE(last.has_value());
+    EXPECT_EQ(last->m_username, "user_599");
+    const auto cachedGroup = cache.group(group.m_id);
+    ASSERT_TRUE(cachedGroup.has_value());
+    EXPECT_EQ(cachedGroup->m_groupName, "administrators");
+    EXPECT_FALSE(cache.user("missing").has_value());
+
+    const auto metrics = cache.metrics();
+    EXPECT_EQ(metrics.hits, 3);
+    EXPECT_EQ(metrics.misses, 1);
+}
+
+TEST_F(IdentityCacheTest, write_through_users_invalidates)
+{
+    auto user = makeUser("invalidated");
+    users.insert(user);
+    cache.populate(db);
+    ASSERT_TRUE(cache.user("invalidated").has_value());
+
+    const auto generation    = cache.generation();
+    const auto invalidations = cache.metrics().invalidations;
+    user.m_email             = "changed@invoice.manager";
+    users.update(user);
+    EXPECT_FALSE(cache.user("invalidated").has_value());
+    EXPECT_GT(cache.generation(), generation);
+    EXPECT_EQ(cache.metrics().invalidations, invalidations + 1);
+
+    // A write to another table keeps the users
+    cache.populate(db);
+    ASSERT_TRUE(cache.user("invalidated").has_value());
+    EXPECT_EQ(cache.user("invalidated")->m_email, "changed@invoice.manager");
+    Groups::Record group{};
+    group.m_groupName = "users";
+    groups.insert(group);
+    EXPECT_TRUE(cache.user("invalidated").has_value());
+    EXPECT_EQ(cache.metrics().invalidations, invalidations + 2);
+}
+
+TEST_F(IdentityCacheTest, store_with_stale_generation_is_dropped)
+{
+    auto       user       = makeUser("stored");
+    const auto generation = cache.generation();
+    // A write lands between the read of the user and its store
+    users.insert(user);
+    cache.store(user, generation);
+    EXPECT_FALSE(cache.user("stored").has_value());
+
+    cache.store(user, cache.generation());
+    const auto cached = cache.userById(user.m_id);
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->m_username, "stored");
+}
+
+TEST_F(IdentityCacheTest, expired_copy_misses)
+{
+    IdentityCache expiring(std::chrono::milliseconds(50));
+    auto          user = makeUser("expiring");
+    users.insert(user);
+    expiring.populate(db);
+    ASSERT_TRUE(expiring.user("expiring").has_value());
+
+    // Another process changes the user, no listener is told
+    QSqlQuery query(db);
+    ASSERT_TRUE(query.exec(QString("UPDATE users SET email='other@invoice.manager' WHERE id=%1;").arg(user.m_id)));
+    EXPECT_EQ(expiring.user("expiring")->m_email, "expiring@invoice.manager");
+
+    QThread::msleep(60);
+    EXPECT_FALSE(expiring.user("expiring").has_value());
+    EXPECT_FALSE(expiring.userById(user.m_id).has_value());
+    expiring.populate(db);
+    ASSERT_TRUE(expiring.user("expiring").has_value());
+    EXPECT_EQ(expiring.user("expiring")->m_email, "other@invoice.manager");
+}
+
+TEST_F(IdentityCacheTest, torn_down_from_a_listener)
+{
+    auto     *owned  = new IdentityCache;
+    qsizetype handle = -1;
+    int       calls  = 0;
+    // Registered after the cache, so the cache is called before it is destroyed
+    handle = core::db::SQLiteDbApi::addTableListener(
+            [&](const QString &)
+            {
+                ++calls;
+                core::db::SQLiteDbApi::removeTableListener(handle);
+                delete owned;
+                owned = nullptr;
+            });
+
+    auto user = makeUser("listened");
+    users.insert(user);
+    EXPECT_EQ(owned, nullptr);
+    users.deleteRow(user);
+    EXPECT_EQ(calls, 1);
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+
+    QTimer::singleShot(0,
+                       [&]()
+                       {
+                           const auto dbPath = core::tools::getTemporaryFileName(".db");
+                           db                = QSqlDatabase::addDatabase("QSQLITE");
+                           db.setDatabaseName(dbPath);
+
+                           ASSERT_TRUE(db.open());
+
+                           ::testing::InitGoogleTest(&argc, argv);
+                           const auto testResult = RUN_ALL_TESTS();
+
+                           QFile::remove(dbPath);
+                           QCoreApplication::exit(testResult);
+                       });
+
+    return QCoreApplication::exec();
+}
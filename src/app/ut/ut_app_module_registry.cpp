@@ -0,0 +1,200 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QMutex>
+#include <QThread>
+#include <atomic>
+#include <functional>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <utility>
+#include "module_registry.h"
+
+using core::modules::Module;
+using core::modules::ModuleError;
+using core::modules::ModuleRegistry;
+
+namespace
+{
+    /**
+     * @brief Records the start and the end of every initialization, in the order they happen.
+     */
+    class Journal
+    {
+    public:
+        void append(const QString &event)
+        {
+            QMutexLocker locker(&m_mutex);
+            m_events.append(event);
+        }
+
+        [[nodiscard]] QStringList events() const
+        {
+            QMutexLocker locker(&m_mutex);
+            return m_events;
+        }
+
+    private:
+        mutable QMutex m_mutex;
+        QStringList    m_events;
+    };
+
+    /**
+     * @brief Module whose initialization runs a function and is written to a journal.
+     */
+    class FakeModule final : public Module
+    {
+    public:
+        FakeModule(const QString &name, Journal &journal, QStringList dependencies = {},
+                   std::function<void(FakeModule &)> work = {}, const int initializationTime = 10) :
+            Module(name, name, initializationTime, std::move(dependencies)), m_journal(journal),
+            m_work(std::move(work))
+        {
+        }
+
+        void initialize() override
+        {
+            m_journal.append("start:" + name());
+            if (m_work)
+            {
+                m_work(*this);
+            }
+            m_journal.append("end:" + name());
+        }
+
+        void stop() override
+        {
+        }
+
+    private:
+        Journal                          &m_journal;
+        std::function<void(FakeModule &)> m_work;
+    };
+
+    void slowWork(FakeModule &)
+    {
+        QThread::msleep(20);
+    }
+} // namespace
+
+TEST(ModuleRegistry, cycle_throws)
+{
+    Journal        journal;
+    FakeModule     first("first", journal, {"second"});
+    FakeModule     second("second", journal, {"first"});
+    ModuleRegistry registry;
+    registry.add(first);
+    registry.add(second);
+
+    EXPECT_THROW(registry.initialize(), ModuleError);
+    EXPECT_THROW(static_cast<void>(registry.criticalPath()), ModuleError);
+    EXPECT_TRUE(journal.events().isEmpty());
+}
+
+TEST(ModuleRegistry, unknown_dependency_throws)
+{
+    Journal        journal;
+    FakeModule     module("module", journal, {"missing"});
+    ModuleRegistry registry;
+    registry.add(module);
+
+    EXPECT_THROW(registry.initialize(), ModuleError);
+    EXPECT_TRUE(journal.events().isEmpty());
+    EXPECT_THROW(registry.add(module), ModuleError);
+}
+
+TEST(ModuleRegistry, dependents_start_after_their_dependencies)
+{
+    Journal        journal;
+    FakeModule     base("base", journal, {}, slowWork);
+    FakeModule     left("left", journal, {"base"}, slowWork);
+    FakeModule     right("right", journal, {"base"}, slowWork);
+    FakeModule     top("top", journal, {"left", "right"});
+    FakeModule     alone("alone", journal, {}, slowWork);
+    ModuleRegistry registry(4);
+    // Registered before their dependencies on purpose
+    registry.add(top);
+    registry.add(left);
+    registry.add(right);
+    registry.add(base);
+    registry.add(alone);
+
+    registry.initialize();
+    const auto events = journal.events();
+    ASSERT_EQ(events.size(), 10);
+    for (const auto *module: {&left, &right, &top})
+    {
+        const auto started = events.indexOf("start:" + module->name());
+        for (const auto &dependency: module->dependencies())
+        {
+            EXPECT_LT(events.indexOf("end:" + dependency), started) << module->name().toStdString();
+        }
+    }
+    EXPECT_EQ(registry.criticalPath(), 30);
+}
+
+TEST(ModuleRegistry, failure_rethrown_after_running_modules_drain)
+{
+    Journal          journal;
+    std::atomic_bool slowDone = false;
+    FakeModule       slow("slow", journal, {},
+                          [&slowDone](FakeModule &)
+                          {
+                              QThread::msleep(50);
+                              slowDone = true;
+                          });
+    FakeModule       failing("failing", journal, {}, [](FakeModule &) { throw std::runtime_error("failed"); });
+    FakeModule       dependent("dependent", journal, {"failing"});
+    ModuleRegistry   registry(2);
+    registry.add(slow);
+    registry.add(failing);
+    registry.add(dependent);
+
+    EXPECT_THROW(registry.initialize(), std::runtime_error);
+    // The running module was waited for and nothing depending on the failure was started
+    EXPECT_TRUE(slowDone);
+    EXPECT_TRUE(journal.events().contains("end:slow"));
+    EXPECT_FALSE(journal.events().contains("start:dependent"));
+}
+
+TEST(ModuleRegistry, progress_adds_up_to_100)
+{
+    Journal        journal;
+    const auto     halves = [](FakeModule &module)
+    {
+        emit module.progressChanged(50);
+        emit module.progressChanged(50);
+    };
+    const auto     partial = [](FakeModule &module) { emit module.progressChanged(30); };
+    FakeModule     first("first", journal, {}, halves, 100);
+    FakeModule     second("second", journal, {"first"}, partial, 300);
+    FakeModule     silent("silent", journal, {}, {}, 0);
+    ModuleRegistry registry(2);
+    registry.add(first);
+    registry.add(second);
+    registry.add(silent);
+
+    std::atomic_int total      = 0;
+    std::atomic_int increments = 0;
+    QObject::connect(
+            &registry, &ModuleRegistry::progressChanged, &registry,
+            [&](const int progress)
+            {
+                EXPECT_GT(progress, 0);
+                total += progress;
+                ++increments;
+            },
+            Qt::DirectConnection);
+
+    registry.initialize();
+    EXPECT_EQ(total, 100);
+    EXPECT_GT(increments, 1);
+
+    // A second initialization reports its progress from zero again
+    total = 0;
+    registry.initialize();
+    EXPECT_EQ(total, 100);
+}
@@ -0,0 +1,272 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QRandomGenerator>
+#include <benchmark/benchmark.h>
+#include "bench_tools.h"
+#include "db/dynamic_table.h"
+#include "db/factory.h"
+#include "db/sqlite/sqlite_column.h"
+
+using namespace core::db;
+
+namespace
+{
+    const std::initializer_list<std::shared_ptr<Column>> benchColumns = {
+            std::make_shared<SQLiteColumn>("name", SQLiteColumn::SQLiteDataType::TEXT,
+                                           SQLiteModifier::isNotNull | SQLiteModifier::isUnique |
+                                                   SQLiteModifier::isPrimaryKey),
+            std::make_shared<SQLiteColumn>("value", SQLiteColumn::SQLiteDataType::TEXT)};
+
+    QMap<QString, QVariantList> makeBatch(const qsizetype rows)
+    {
+        QVariantList names;
+        QVariantList values;
+        names.reserve(rows);
+        values.reserve(rows);
+        for (qsizetype i = 0; i < rows; i++)
+        {
+            names << QString("name_%1").arg(i);
+            values << QString("value_%1").arg(i);
+        }
+        return {{"name", names}, {"value", values}};
+    }
+
+    /**
+     * @brief Lookups by primary key measured per iteration, whatever the size of the table.
+     */
+    constexpr qsizetype LOOKUPS = 1000;
+
+    /**
+     * @brief Rows of a page of the pagination benchmarks.
+     */
+    constexpr qsizetype PAGE_ROWS = 50;
+} // namespace
+
+static void BM_DynamicTableInsert(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    const auto batch  = makeBatch(state.range(0));
+    const auto names  = batch.value("name");
+    const auto values = batch.value("value");
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM bench;");
+        state.ResumeTiming();
+        for (qsizetype i = 0; i < state.range(0); i++)
+        {
+            table.insert({{"name", names[i]}, {"value", values[i]}});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Same rows as BM_DynamicTableInsert, bound by position
+static void BM_DynamicTableInsertRow(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    const auto batch  = makeBatch(state.range(0));
+    const auto names  = batch.value("name");
+    const auto values = batch.value("value");
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM bench;");
+        state.ResumeTiming();
+        for (qsizetype i = 0; i < state.range(0); i++)
+        {
+            table.insertRow(DynamicTable::row(names[i], values[i]));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DynamicTableInsertMany(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    const auto batch = makeBatch(state.range(0));
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM bench;");
+        state.ResumeTiming();
+        table.insertMany(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Full table scan through the cursor
+static void BM_DynamicTableSelect(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    table.insertMany(makeBatch(state.range(0)));
+
+    for (auto _: state)
+    {
+        qsizetype rows = 0;
+        for (const auto &record: table.scan())
+        {
+            benchmark::DoNotOptimize(record.value(1));
+            rows++;
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Random lookups by primary key, the cost grows with the depth of the index
+static void BM_DynamicTableSelectPk(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    table.insertMany(makeBatch(state.range(0)));
+    QList<QVariant> keys;
+    keys.reserve(LOOKUPS);
+    for (qsizetype i = 0; i < LOOKUPS; i++)
+    {
+        keys << QString("name_%1").arg(QRandomGenerator::global()->bounded(static_cast<qint64>(state.range(0))));
+    }
+
+    for (auto _: state)
+    {
+        for (const auto &key: keys)
+        {
+            benchmark::DoNotOptimize(table.selectPk({{"name", key}}));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * LOOKUPS);
+}
+
+// The last page of the table through OFFSET, which reads and discards every previous row
+static void BM_DynamicTablePageOffset(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    table.insertMany(makeBatch(state.range(0)));
+    QSqlQuery query(db.database());
+    query.setForwardOnly(true);
+    query.prepare("SELECT * FROM bench ORDER BY name LIMIT :page_size OFFSET :offset;");
+
+    for (auto _: state)
+    {
+        query.bindValue(":page_size", PAGE_ROWS);
+        query.bindValue(":offset", state.range(0) - PAGE_ROWS);
+        query.exec();
+        while (query.next())
+        {
+            benchmark::DoNotOptimize(query.value(1));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PAGE_ROWS);
+}
+
+// The same page through keyset pagination, a range scan of the primary key that ignores the previous rows
+static void BM_DynamicTablePageKeyset(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    table.insertMany(makeBatch(state.range(0)));
+    QSqlQuery query(db.database());
+    query.exec(QString("SELECT name FROM bench ORDER BY name LIMIT 1 OFFSET %1;").arg(state.range(0) - PAGE_ROWS - 1));
+    query.next();
+    const auto after = DynamicTable::row(query.value(0));
+    query.finish();
+
+    for (auto _: state)
+    {
+        for (const auto &record: table.scanPage(after, PAGE_ROWS))
+        {
+            benchmark::DoNotOptimize(record.value(1));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * PAGE_ROWS);
+}
+
+static void BM_DynamicTableUpdateMany(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    auto batch = makeBatch(state.range(0));
+    table.insertMany(batch);
+    // Every iteration writes other values, so SQLite cannot skip the writes
+    auto &values = batch["value"];
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        for (auto &value: values)
+        {
+            value = value.toString() + '+';
+        }
+        state.ResumeTiming();
+        table.updateMany(batch);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DynamicTableDeleteMany(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    DynamicTable             table(db.database(), "bench", benchColumns);
+    table.create();
+    const auto batch = makeBatch(state.range(0));
+    const QMap<QString, QVariantList> keys{{"name", batch.value("name")}};
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        table.insertMany(batch);
+        state.ResumeTiming();
+        table.deleteMany(keys);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_DynamicTableOpen(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    const bool               cached = state.range(0) != 0;
+
+    for (auto _: state)
+    {
+        if (!cached)
+        {
+            Factory::clearStatements();
+        }
+        DynamicTable table(db.database(), "bench", benchColumns);
+        benchmark::DoNotOptimize(table.schema().size());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Opening a table without the shared statements generates its SQL again
+BENCHMARK(BM_DynamicTableOpen)->ArgName("cached")->Arg(0)->Arg(1);
+// One transaction per row, so it is not run on the largest tables
+BENCHMARK(BM_DynamicTableInsert)->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DynamicTableInsertRow)->RangeMultiplier(10)->Range(100, 10000)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DynamicTableInsertMany)->Apply(bench::rowCounts);
+BENCHMARK(BM_DynamicTableSelect)->Apply(bench::rowCounts);
+BENCHMARK(BM_DynamicTableSelectPk)->Apply(bench::rowCounts);
+BENCHMARK(BM_DynamicTablePageOffset)->Apply(bench::rowCounts);
+BENCHMARK(BM_DynamicTablePageKeyset)->Apply(bench::rowCounts);
+BENCHMARK(BM_DynamicTableUpdateMany)->Apply(bench::rowCounts);
+BENCHMARK(BM_DynamicTableDeleteMany)->Apply(bench::rowCounts);
@@ -0,0 +1,45 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include "tools/password_hash.h"
+
+using core::tools::PasswordHash;
+
+// Verification of a stored password, the cost of a login, for each work factor. Pick the
+// largest iterations whose time stays under the login latency wanted on the target machine.
+static void BM_PasswordHashVerify(benchmark::State &state)
+{
+    const auto hash = PasswordHash::hash("password", static_cast<int>(state.range(0)));
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(PasswordHash::verify("password", hash));
+    }
+    state.counters["iterations"] = static_cast<double>(state.range(0));
+}
+
+// Work factor suggested by PasswordHash::calibrate() for a target login latency in milliseconds
+static void BM_PasswordHashCalibrate(benchmark::State &state)
+{
+    int iterations = 0;
+    for (auto _: state)
+    {
+        iterations = PasswordHash::calibrate(std::chrono::milliseconds(state.range(0)));
+        benchmark::DoNotOptimize(iterations);
+    }
+    state.counters["target_ms"]  = static_cast<double>(state.range(0));
+    state.counters["iterations"] = iterations;
+}
+
+BENCHMARK(BM_PasswordHashVerify)
+        ->Arg(PasswordHash::MIN_ITERATIONS)
+        ->Arg(50000)
+        ->Arg(100000)
+        ->Arg(PasswordHash::DEFAULT_ITERATIONS)
+        ->Arg(600000)
+        ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_PasswordHashCalibrate)->Arg(100)->Arg(250)->Arg(500)->Iterations(3)->Unit(benchmark::kMillisecond);
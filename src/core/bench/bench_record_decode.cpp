@@ -0,0 +1,107 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QDateTime>
+#include <QSqlRecord>
+#include <array>
+#include <benchmark/benchmark.h>
+#include "bench_tools.h"
+
+namespace
+{
+    // Same layout as the Users::Record generated from src/app/modules/security/tables/users.json
+    struct Record
+    {
+        long long m_id;
+        QString   m_username;
+        QString   m_password;
+        QString   m_email;
+        long long m_groupId;
+        QString   m_modified_by;
+        QDateTime m_modified_at;
+        QString   m_created_by;
+        QDateTime m_created_at;
+    };
+
+    constexpr std::array<const char *, 9> FIELDS = {"id",          "username",    "password",   "email",     "groupId",
+                                                    "modified_by", "modified_at", "created_by", "created_at"};
+
+    /**
+     * @brief Creates the users table with one row and leaves findUserByEmail positioned on it.
+     */
+    void prepareFindUserByEmail(bench::TemporaryDatabase &db, QSqlQuery &query)
+    {
+        db.exec("CREATE TABLE users ( id INTEGER PRIMARY KEY AUTOINCREMENT UNIQUE, username TEXT UNIQUE, "
+                "password TEXT, email TEXT, groupId INTEGER, modified_by TEXT, modified_at DATETIME DEFAULT "
+                "CURRENT_TIMESTAMP, created_by TEXT, created_at DATETIME DEFAULT CURRENT_TIMESTAMP );");
+        db.exec("INSERT INTO users (username, password, email, groupId, modified_by, created_by) VALUES "
+                "('admin', 'secret', 'admin@invoice.manager', 1, 'admin', 'admin');");
+        query.setForwardOnly(true);
+        query.prepare("select * from users  where email = :email");
+        query.bindValue(":email", "admin@invoice.manager");
+        query.exec();
+        query.next();
+    }
+} // namespace
+
+// Row decoding as generated before: copy the record and look every field up by name
+static void BM_FindUserByEmailDecodeByName(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    QSqlQuery                query(db.database());
+    prepareFindUserByEmail(db, query);
+
+    Record record;
+    for (auto _: state)
+    {
+        const auto sqlRecord = query.record();
+        record.m_id          = sqlRecord.value("id").toLongLong();
+        record.m_username    = sqlRecord.value("username").toString();
+        record.m_password    = sqlRecord.value("password").toString();
+        record.m_email       = sqlRecord.value("email").toString();
+        record.m_groupId     = sqlRecord.value("groupId").toLongLong();
+        record.m_modified_by = sqlRecord.value("modified_by").toString();
+        record.m_modified_at = sqlRecord.value("modified_at").toDateTime();
+        record.m_created_by  = sqlRecord.value("created_by").toString();
+        record.m_created_at  = sqlRecord.value("created_at").toDateTime();
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+// Row decoding as generated now: ordinals resolved once, values read by position
+static void BM_FindUserByEmailDecodeByOrdinal(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    QSqlQuery                query(db.database());
+    prepareFindUserByEmail(db, query);
+
+    std::array<int, 9> ordinals{-1};
+    Record             record;
+    for (auto _: state)
+    {
+        if (ordinals.front() < 0)
+        {
+            const auto sqlRecord = query.record();
+            for (std::size_t i = 0; i < FIELDS.size(); i++)
+            {
+                ordinals[i] = sqlRecord.indexOf(FIELDS[i]);
+            }
+        }
+        record.m_id          = query.value(ordinals[0]).toLongLong();
+        record.m_username    = query.value(ordinals[1]).toString();
+        record.m_password    = query.value(ordinals[2]).toString();
+        record.m_email       = query.value(ordinals[3]).toString();
+        record.m_groupId     = query.value(ordinals[4]).toLongLong();
+        record.m_modified_by = query.value(ordinals[5]).toString();
+        record.m_modified_at = query.value(ordinals[6]).toDateTime();
+        record.m_created_by  = query.value(ordinals[7]).toString();
+        record.m_created_at  = query.value(ordinals[8]).toDateTime();
+        benchmark::DoNotOptimize(record);
+    }
+}
+
+BENCHMARK(BM_FindUserByEmailDecodeByName);
+BENCHMARK(BM_FindUserByEmailDecodeByOrdinal);
@@ -0,0 +1,83 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <benchmark/benchmark.h>
+#include "bench_tools.h"
+#include "settings/sqlite_settings.h"
+
+using core::settings::SQLiteSettings;
+
+namespace
+{
+    /**
+     * @brief Sets the keys of a settings store, marking them as changed.
+     * @param settings The settings store.
+     * @param keys The number of keys.
+     * @param revision Suffix of the values, so every call changes all of them.
+     */
+    void setKeys(SQLiteSettings &settings, const qsizetype keys, const int revision)
+    {
+        for (qsizetype i = 0; i < keys; i++)
+        {
+            settings.setValue(QString("key_%1").arg(i), QString("value_%1_%2").arg(i).arg(revision));
+        }
+    }
+} // namespace
+
+// Every key changed, so every key is upserted
+static void BM_SQLiteSettingsWrite(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    SQLiteSettings           settings(db.database(), "settings");
+    int                      revision = 0;
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        setKeys(settings, state.range(0), revision++);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(settings.write());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+// Only one key changed, the write must not depend on the size of the store
+static void BM_SQLiteSettingsWriteOneKey(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    SQLiteSettings           settings(db.database(), "settings");
+    setKeys(settings, state.range(0), 0);
+    settings.write();
+    int revision = 0;
+
+    for (auto _: state)
+    {
+        settings.setValue("key_0", revision++);
+        benchmark::DoNotOptimize(settings.write());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_SQLiteSettingsRead(benchmark::State &state)
+{
+    bench::TemporaryDatabase db;
+    {
+        SQLiteSettings writer(db.database(), "settings");
+        setKeys(writer, state.range(0), 0);
+        writer.write();
+    }
+    SQLiteSettings settings(db.database(), "settings");
+
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(settings.read());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_SQLiteSettingsWrite)->Apply(bench::rowCounts);
+BENCHMARK(BM_SQLiteSettingsWriteOneKey)->Apply(bench::rowCounts);
+BENCHMARK(BM_SQLiteSettingsRead)->Apply(bench::rowCounts);
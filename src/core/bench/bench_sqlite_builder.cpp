@@ -0,0 +1,105 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <benchmark/benchmark.h>
+#include "db/db_manager.h"
+#include "db/factory.h"
+#include "db/sqlite/sqlite_column.h"
+
+using namespace core::db;
+
+namespace
+{
+    /**
+     * @brief Creates a builder for a table with an integer primary key and text columns.
+     * @param columns The number of columns of the table.
+     */
+    std::shared_ptr<SQLBuilder> makeBuilder(const qsizetype columns)
+    {
+        auto builder = Factory::builder(DBManager::QSQLITE);
+        builder->setTableName("bench");
+        builder->addColumn(std::make_shared<SQLiteColumn>(
+                "id", SQLiteColumn::SQLiteDataType::INTEGER,
+                SQLiteModifier::isPrimaryKey | SQLiteModifier::isAutoIncrement | SQLiteModifier::isUnique));
+        for (qsizetype i = 1; i < columns; i++)
+        {
+            builder->addColumn(
+                    std::make_shared<SQLiteColumn>(QString("column_%1").arg(i), SQLiteColumn::SQLiteDataType::TEXT));
+        }
+        return builder;
+    }
+
+    /**
+     * @brief Number of columns of the wide table, with indexed, defaulted and checked columns.
+     */
+    constexpr qsizetype WIDE_TABLE = 200;
+} // namespace
+
+// Every statement DynamicTable and the generator ask for a table
+static void BM_SQLiteBuilderStatements(benchmark::State &state)
+{
+    const auto builder = makeBuilder(state.range(0));
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(builder->createTable());
+        benchmark::DoNotOptimize(builder->createIndexes());
+        benchmark::DoNotOptimize(builder->createInsert());
+        benchmark::DoNotOptimize(builder->createUpdate());
+        benchmark::DoNotOptimize(builder->createUpsert());
+        benchmark::DoNotOptimize(builder->createSelect());
+        benchmark::DoNotOptimize(builder->createSelectPk());
+        benchmark::DoNotOptimize(builder->createSelectCount());
+        benchmark::DoNotOptimize(builder->createDelete());
+    }
+    state.counters["columns"] = static_cast<double>(state.range(0));
+}
+
+// Building the description of the table, as every DynamicTable constructor does
+static void BM_SQLiteBuilderColumns(benchmark::State &state)
+{
+    for (auto _: state)
+    {
+        benchmark::DoNotOptimize(makeBuilder(state.range(0)));
+    }
+    state.counters["columns"] = static_cast<double>(state.range(0));
+}
+
+// Loading the schema of a wide table from Column objects, then building all of its statements
+static void BM_TableSchemaLoad(benchmark::State &state)
+{
+    QVector<std::shared_ptr<Column>> columns{
+            std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER,
+                                           SQLiteModifier::isPrimaryKey | SQLiteModifier::isAutoIncrement)};
+    for (qsizetype i = 1; i < state.range(0); i++)
+    {
+        const auto kind = i % 4;
+        columns.append(std::make_shared<SQLiteColumn>(
+                QString("column_%1").arg(i), kind == 0 ? SQLiteColumn::SQLiteDataType::INTEGER
+                                                       : SQLiteColumn::SQLiteDataType::TEXT,
+                kind == 1 ? SQLiteModifiers(SQLiteModifier::isNotNull) : SQLiteModifier::None,
+                kind == 2 ? std::optional<QString>(QString("idx_%1").arg(i % 8)) : std::nullopt,
+                kind == 3 ? std::optional<QString>("''") : std::nullopt, std::nullopt,
+                kind == 0 ? std::optional<QString>(QString("column_%1 >= 0").arg(i)) : std::nullopt));
+    }
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("bench");
+
+    for (auto _: state)
+    {
+        TableSchema schema;
+        for (const auto &column: columns)
+        {
+            column->addTo(schema);
+        }
+        builder->setSchema(std::move(schema));
+        benchmark::DoNotOptimize(builder->statements());
+    }
+    state.counters["columns"] = static_cast<double>(state.range(0));
+}
+
+BENCHMARK(BM_TableSchemaLoad)->Arg(WIDE_TABLE)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SQLiteBuilderStatements)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SQLiteBuilderColumns)->RangeMultiplier(4)->Range(4, 256)->Unit(benchmark::kMicrosecond);
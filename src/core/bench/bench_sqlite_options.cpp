@@ -0,0 +1,78 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <benchmark/benchmark.h>
+#include "bench_tools.h"
+#include "db/dynamic_table.h"
+#include "db/sqlite/sqlite_column.h"
+#include "db/sqlite/sqlite_options.h"
+
+using namespace core::db;
+
+namespace
+{
+    const std::initializer_list<std::shared_ptr<Column>> benchColumns = {
+            std::make_shared<SQLiteColumn>("name", SQLiteColumn::SQLiteDataType::TEXT,
+                                           SQLiteModifier::isNotNull | SQLiteModifier::isUnique |
+                                                   SQLiteModifier::isPrimaryKey),
+            std::make_shared<SQLiteColumn>("value", SQLiteColumn::SQLiteDataType::TEXT)};
+} // namespace
+
+// One transaction per row, as the application does when a form is saved
+static void BM_SQLiteProfileInsert(benchmark::State &state, const SQLiteOptions &options)
+{
+    bench::TemporaryDatabase db;
+    options.apply(db.database());
+    DynamicTable table(db.database(), "bench", benchColumns);
+    table.create();
+
+    for (auto _: state)
+    {
+        state.PauseTiming();
+        db.exec("DELETE FROM bench;");
+        state.ResumeTiming();
+        for (qsizetype i = 0; i < state.range(0); i++)
+        {
+            table.insert({{"name", QString("name_%1").arg(i)}, {"value", QString("value_%1").arg(i)}});
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+static void BM_SQLiteProfileRead(benchmark::State &state, const SQLiteOptions &options)
+{
+    bench::TemporaryDatabase db;
+    options.apply(db.database());
+    DynamicTable table(db.database(), "bench", benchColumns);
+    table.create();
+    QVariantList names;
+    QVariantList values;
+    for (qsizetype i = 0; i < state.range(0); i++)
+    {
+        names << QString("name_%1").arg(i);
+        values << QString("value_%1").arg(i);
+    }
+    table.insertMany({{"name", names}, {"value", values}});
+
+    for (auto _: state)
+    {
+        qsizetype rows = 0;
+        for (const auto &record: table.scan())
+        {
+            benchmark::DoNotOptimize(record.value(1));
+            rows++;
+        }
+        benchmark::DoNotOptimize(rows);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_CAPTURE(BM_SQLiteProfileInsert, sqlite_default, SQLiteOptions{})->Arg(1000);
+BENCHMARK_CAPTURE(BM_SQLiteProfileInsert, interactive, SQLiteOptions::interactive())->Arg(1000);
+BENCHMARK_CAPTURE(BM_SQLiteProfileInsert, bulk_load, SQLiteOptions::bulkLoad())->Arg(1000);
+BENCHMARK_CAPTURE(BM_SQLiteProfileRead, sqlite_default, SQLiteOptions{})->Arg(100000);
+BENCHMARK_CAPTURE(BM_SQLiteProfileRead, interactive, SQLiteOptions::interactive())->Arg(100000);
+BENCHMARK_CAPTURE(BM_SQLiteProfileRead, bulk_load, SQLiteOptions::bulkLoad())->Arg(100000);
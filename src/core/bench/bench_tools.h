@@ -0,0 +1,91 @@
+/**
+ * @file bench_tools.h
+ * @brief Helpers shared by the core and the application benchmarks.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QFile>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QUuid>
+#include <benchmark/benchmark.h>
+#include "tools/tools.h"
+
+namespace bench
+{
+
+    /**
+     * @brief Runs a benchmark for every table size tracked between releases, from 1k to 1M rows.
+     *
+     * Use it with Apply(), the size is read with state.range(0).
+     *
+     * @param target The benchmark to parameterize.
+     */
+    inline void rowCounts(benchmark::internal::Benchmark *target)
+    {
+        target->RangeMultiplier(10)->Range(1000, 1000000)->Unit(benchmark::kMillisecond);
+    }
+
+    /**
+     * @class TemporaryDatabase
+     * @brief SQLite connection opened on a temporary file, removed when the object is destroyed.
+     *
+     * Every benchmark works on its own file so that the measures include the real fsync cost
+     * and no state leaks from one benchmark into the next one.
+     */
+    class TemporaryDatabase
+    {
+    public:
+        TemporaryDatabase() :
+            m_path(core::tools::getTemporaryFileName(".db")),
+            m_connectionName(QUuid::createUuid().toString(QUuid::WithoutBraces))
+        {
+            m_database = QSqlDatabase::addDatabase("QSQLITE", m_connectionName);
+            m_database.setDatabaseName(m_path);
+            m_database.open();
+        }
+
+        ~TemporaryDatabase()
+        {
+            m_database.close();
+            m_database = QSqlDatabase();
+            QSqlDatabase::removeDatabase(m_connectionName);
+            QFile::remove(m_path);
+            QFile::remove(m_path + "-wal");
+            QFile::remove(m_path + "-shm");
+        }
+
+        TemporaryDatabase(const TemporaryDatabase &)            = delete;
+        TemporaryDatabase &operator=(const TemporaryDatabase &) = delete;
+
+        /**
+         * @brief Provides access to the opened connection.
+         * @return A reference to the QSqlDatabase object.
+         */
+        [[nodiscard]] QSqlDatabase &database()
+        {
+            return m_database;
+        }
+
+        /**
+         * @brief Executes a raw SQL sentence on the connection, used to reset the state between iterations.
+         * @param sql The sentence to execute.
+         */
+        void exec(const QString &sql) const
+        {
+            QSqlQuery query(m_database);
+            query.exec(sql);
+        }
+
+    private:
+        QString      m_path; ///< Path of the temporary database file.
+        QString      m_connectionName; ///< Unique connection name registered in QSqlDatabase.
+        QSqlDatabase m_database; ///< The opened connection.
+    };
+
+} // namespace bench
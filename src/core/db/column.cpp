@@ -8,6 +8,7 @@
  */
 
 #include "column.h"
+#include "table_schema.h"
 
 namespace core::db
 {
@@ -17,6 +18,24 @@ namespace core::db
         return (m_modifiers & modifier) != 0;
     }
 
+    qsizetype Column::addTo(TableSchema &schema) const
+    {
+        const auto column = schema.addColumn(m_columnName, m_dataType, 0, m_modifiers);
+        const std::array<std::pair<TableSchema::Attribute, const std::optional<QString> *>, 4> attributes = {
+                {{TableSchema::Attribute::Index, &m_indexName},
+                 {TableSchema::Attribute::Default, &m_defaultValue},
+                 {TableSchema::Attribute::ForeignKey, &m_foreignKey},
+                 {TableSchema::Attribute::Check, &m_customConstraint}}};
+        for (const auto &[attribute, value]: attributes)
+        {
+            if (value->has_value())
+            {
+                schema.setAttribute(column, attribute, value->value());
+            }
+        }
+        return column;
+    }
+
     std::optional<QString> Column::indexName() const
     {
         return m_indexName;
@@ -19,6 +19,7 @@
 
 namespace core::db
 {
+    class TableSchema;
 
     /**
      * @class Column
@@ -106,6 +107,17 @@ namespace core::db
          */
         [[nodiscard]] virtual bool hasModifier(unsigned int modifier) const;
 
+        /**
+         * @brief Appends the column to the flat schema of a table.
+         *
+         * Copies every property of the column into the arrays of the schema, the statement
+         * builders read them from there.
+         *
+         * @param schema The schema to append the column to.
+         * @return The position of the column in the schema.
+         */
+        virtual qsizetype addTo(TableSchema &schema) const;
+
         // Accessors for optional properties
 
         /**
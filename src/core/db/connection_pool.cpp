@@ -0,0 +1,266 @@
+/**
+ * @file connection_pool.cpp
+ * @brief Implementation file for the ConnectionPool and ConnectionLease classes.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "connection_pool.h"
+#include "db_manager.h"
+
+#include <QDeadlineTimer>
+#include <QSqlError>
+#include <algorithm>
+#include "tools/trace.h"
+
+namespace core::db
+{
+    namespace
+    {
+        /**
+         * @brief Closes a clone and removes it from the registered connections.
+         * @param database The clone, its last handle.
+         */
+        void closeConnection(QSqlDatabase database)
+        {
+            const auto cloneName = database.connectionName();
+            database.close();
+            database = QSqlDatabase();
+            DBManager::manager().releaseStatementCache(cloneName);
+            QSqlDatabase::removeDatabase(cloneName);
+        }
+    } // namespace
+
+    ConnectionLease::ConnectionLease(std::shared_ptr<ConnectionPool> pool, QSqlDatabase database) :
+        m_pool(std::move(pool)), m_database(std::move(database))
+    {
+    }
+
+    ConnectionLease::ConnectionLease(ConnectionLease &&other) noexcept :
+        m_pool(std::move(other.m_pool)), m_database(std::move(other.m_database))
+    {
+        other.m_pool.reset();
+    }
+
+    ConnectionLease &ConnectionLease::operator=(ConnectionLease &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+            m_pool     = std::move(other.m_pool);
+            m_database = std::move(other.m_database);
+            other.m_pool.reset();
+        }
+        return *this;
+    }
+
+    ConnectionLease::~ConnectionLease()
+    {
+        release();
+    }
+
+    void ConnectionLease::release()
+    {
+        if (m_pool)
+        {
+            m_pool->release(m_database);
+            m_pool.reset();
+        }
+        m_database = QSqlDatabase();
+    }
+
+    ConnectionPool::ConnectionPool(QString connectionName, int maxConnections, std::chrono::milliseconds idleTimeout,
+                                   std::function<void(const QSqlDatabase &)> initializer) :
+        m_connectionName(std::move(connectionName)), m_owner(QThread::currentThread()),
+        m_maxConnections(std::max(1, maxConnections)), m_idleTimeout(idleTimeout), m_initializer(std::move(initializer))
+    {
+    }
+
+    ConnectionPool::~ConnectionPool()
+    {
+        // The clones of running threads are closed by their thread when it finishes, see lease()
+        QMutexLocker locker(&m_mutex);
+        for (qsizetype i = m_clones.size() - 1; i >= 0; i--)
+        {
+            if (isClosable(m_clones[i]))
+            {
+                removeClone(i);
+            }
+        }
+    }
+
+    ConnectionLease ConnectionPool::lease(std::chrono::milliseconds wait)
+    {
+        auto *const current = QThread::currentThread();
+        if (current == m_owner)
+        {
+            return {shared_from_this(), QSqlDatabase::database(m_connectionName, false)};
+        }
+
+        QMutexLocker locker(&m_mutex);
+        removeExpired();
+        for (auto &clone: m_clones)
+        {
+            if (clone.thread == current)
+            {
+                clone.leases++;
+                return {shared_from_this(), clone.database};
+            }
+        }
+
+        const QDeadlineTimer deadline(wait);
+        while (m_clones.size() >= m_maxConnections && !evictLeastRecentlyUsed())
+        {
+            if (!m_released.wait(&m_mutex, deadline))
+            {
+                throw ConnectionPoolException(
+                        QString("No connection of the pool %1 was released in time.").arg(m_connectionName));
+            }
+        }
+
+        const auto cloneName = QString("%1_clone_%2").arg(m_connectionName).arg(++m_nextId);
+        const tools::ScopedSpan span("db.open", "db", cloneName);
+        Clone                   clone;
+        clone.thread   = current;
+        clone.leases   = 1;
+        clone.database = QSqlDatabase::cloneDatabase(m_connectionName, cloneName);
+        if (!clone.database.open())
+        {
+            const auto error = clone.database.lastError().text();
+            clone.database   = QSqlDatabase();
+            QSqlDatabase::removeDatabase(cloneName);
+            throw ConnectionPoolException(QString("Failed to open the connection %1: %2").arg(cloneName, error));
+        }
+        if (m_initializer)
+        {
+            try
+            {
+                m_initializer(clone.database);
+            }
+            catch (...)
+            {
+                clone.database.close();
+                clone.database = QSqlDatabase();
+                QSqlDatabase::removeDatabase(cloneName);
+                throw;
+            }
+        }
+        // QThread::finished is emitted from the finishing thread, so the clone is closed where it was opened,
+        // even when the pool has been destroyed in the meantime
+        std::weak_ptr<ConnectionPool> pool = weak_from_this();
+        clone.finished = QObject::connect(current, &QThread::finished,
+                                          [pool, current, cloneName]()
+                                          {
+                                              if (const auto self = pool.lock())
+                                              {
+                                                  self->threadFinished(current);
+                                              }
+                                              else
+                                              {
+                                                  closeConnection(QSqlDatabase::database(cloneName, false));
+                                              }
+                                          });
+        m_clones.append(clone);
+        return {shared_from_this(), clone.database};
+    }
+
+    int ConnectionPool::evictIdle()
+    {
+        QMutexLocker locker(&m_mutex);
+        return removeExpired();
+    }
+
+    int ConnectionPool::size() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return static_cast<int>(m_clones.size());
+    }
+
+    int ConnectionPool::leased() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return static_cast<int>(std::count_if(m_clones.begin(), m_clones.end(),
+                                              [](const Clone &clone) { return clone.leases > 0; }));
+    }
+
+    void ConnectionPool::release(const QSqlDatabase &database)
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto &clone: m_clones)
+        {
+            if (clone.database.connectionName() == database.connectionName())
+            {
+                if (--clone.leases == 0)
+                {
+                    clone.idle.start();
+                    m_released.wakeAll();
+                }
+                return;
+            }
+        }
+    }
+
+    void ConnectionPool::threadFinished(QThread *thread)
+    {
+        QMutexLocker locker(&m_mutex);
+        for (qsizetype i = 0; i < m_clones.size(); i++)
+        {
+            if (m_clones[i].thread == thread && m_clones[i].leases == 0)
+            {
+                removeClone(i);
+                return;
+            }
+        }
+    }
+
+    bool ConnectionPool::isClosable(const Clone &clone)
+    {
+        return clone.thread == QThread::currentThread() || clone.thread.isNull() || clone.thread->isFinished();
+    }
+
+    void ConnectionPool::removeClone(qsizetype index)
+    {
+        auto database = std::move(m_clones[index].database);
+        QObject::disconnect(m_clones[index].finished);
+        m_clones.removeAt(index);
+        closeConnection(std::move(database));
+        m_released.wakeAll();
+    }
+
+    int ConnectionPool::removeExpired()
+    {
+        int removed = 0;
+        for (qsizetype i = m_clones.size() - 1; i >= 0; i--)
+        {
+            if (m_clones[i].leases == 0 && m_clones[i].idle.hasExpired(m_idleTimeout.count()) &&
+                isClosable(m_clones[i]))
+            {
+                removeClone(i);
+                removed++;
+            }
+        }
+        return removed;
+    }
+
+    bool ConnectionPool::evictLeastRecentlyUsed()
+    {
+        qsizetype oldest = -1;
+        for (qsizetype i = 0; i < m_clones.size(); i++)
+        {
+            if (m_clones[i].leases == 0 && isClosable(m_clones[i]) &&
+                (oldest < 0 || m_clones[i].idle.elapsed() > m_clones[oldest].idle.elapsed()))
+            {
+                oldest = i;
+            }
+        }
+        if (oldest < 0)
+        {
+            return false;
+        }
+        removeClone(oldest);
+        return true;
+    }
+
+} // namespace core::db
@@ -0,0 +1,224 @@
+/**
+ * @file connection_pool.h
+ * @brief Header file for the ConnectionPool and ConnectionLease classes.
+ *
+ * Qt SQL connections can only be used from the thread that opened them. The ConnectionPool
+ * hands out a clone of a registered connection to each worker thread, bounded in number,
+ * and closes the clones that stay idle for too long. A clone is only closed from the thread
+ * that opened it, or once that thread has finished.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "dllexports.h"
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QPointer>
+#include <QSqlDatabase>
+#include <QThread>
+#include <QWaitCondition>
+#include <chrono>
+#include <exception.h>
+#include <functional>
+#include <memory>
+
+namespace core::db
+{
+
+    /**
+     * @class ConnectionPoolException
+     * @brief Exception thrown when the pool cannot provide a connection.
+     */
+    class ConnectionPoolException final : public Exception
+    {
+        using Exception::Exception; ///< Inherits constructors from the `Exception` base class.
+    };
+
+    class ConnectionPool;
+
+    /**
+     * @class ConnectionLease
+     * @brief Move-only handle to a pooled connection, the connection is returned when the lease is destroyed.
+     *
+     * A lease must be destroyed in the thread that obtained it, and the queries created on its
+     * connection must not outlive it.
+     */
+    class CORE_API ConnectionLease
+    {
+    public:
+        /**
+         * @brief Constructs a lease over a connection of the pool.
+         * @param pool The pool the connection is returned to.
+         * @param database The leased connection.
+         */
+        ConnectionLease(std::shared_ptr<ConnectionPool> pool, QSqlDatabase database);
+
+        ConnectionLease(const ConnectionLease &)            = delete;
+        ConnectionLease &operator=(const ConnectionLease &) = delete;
+        ConnectionLease(ConnectionLease &&other) noexcept;
+        ConnectionLease &operator=(ConnectionLease &&other) noexcept;
+
+        /**
+         * @brief Returns the connection to the pool.
+         */
+        ~ConnectionLease();
+
+        /**
+         * @brief Retrieves the leased connection.
+         * @return The connection, usable only from the current thread.
+         */
+        [[nodiscard]] QSqlDatabase database() const
+        {
+            return m_database;
+        }
+
+        /**
+         * @brief Returns the connection to the pool before the lease is destroyed.
+         */
+        void release();
+
+    private:
+        std::shared_ptr<ConnectionPool> m_pool; ///< Pool the connection belongs to, nullptr once released.
+        QSqlDatabase                    m_database; ///< The leased connection.
+    };
+
+    /**
+     * @class ConnectionPool
+     * @brief Bounded pool of per-thread clones of a registered connection.
+     *
+     * The thread that created the pool keeps using the original connection. Any other thread
+     * gets its own clone, made with QSqlDatabase::cloneDatabase(), which is reused by the nested
+     * leases of that thread. A clone is closed when its thread finishes, or once it exceeds the
+     * idle timeout by its own thread on its next lease() or evictIdle(). A connection cannot be
+     * closed from another thread while its owner runs, so when the pool is full lease() only
+     * reuses the slots of the threads already finished and otherwise waits for one to finish.
+     */
+    class CORE_API ConnectionPool : public std::enable_shared_from_this<ConnectionPool>
+    {
+    public:
+        static constexpr int                       DEFAULT_MAX_CONNECTIONS = 8; ///< Default number of clones.
+        static constexpr std::chrono::milliseconds DEFAULT_IDLE_TIMEOUT{60000}; ///< Default idle time of a clone.
+        static constexpr std::chrono::milliseconds DEFAULT_WAIT{30000}; ///< Default wait for a free slot.
+
+        /**
+         * @brief Constructs a pool over a registered connection.
+         * @param connectionName The name of the connection to clone.
+         * @param maxConnections Maximum number of clones opened at the same time.
+         * @param idleTimeout Time a clone can stay unused before it is closed.
+         * @param initializer Called on every clone once it is opened, to apply the per-connection settings.
+         */
+        ConnectionPool(QString connectionName, int maxConnections = DEFAULT_MAX_CONNECTIONS,
+                       std::chrono::milliseconds                 idleTimeout = DEFAULT_IDLE_TIMEOUT,
+                       std::function<void(const QSqlDatabase &)> initializer = {});
+
+        ConnectionPool(const ConnectionPool &)            = delete;
+        ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+        /**
+         * @brief Closes and removes the clones of the current thread and of the finished threads.
+         *
+         * The clones of the threads still running are closed by those threads when they finish.
+         */
+        ~ConnectionPool();
+
+        /**
+         * @brief Leases a connection usable from the current thread.
+         * @param wait Maximum time to wait for a free slot when the pool is full.
+         * @return The lease of the connection.
+         * @throws ConnectionPoolException if no slot is freed in time or the clone cannot be opened.
+         */
+        [[nodiscard]] ConnectionLease lease(std::chrono::milliseconds wait = DEFAULT_WAIT);
+
+        /**
+         * @brief Closes the clones idle longer than the idle timeout that the current thread can close.
+         *
+         * Those are the clone of the current thread and the clones of the finished threads.
+         *
+         * @return The number of clones closed.
+         */
+        int evictIdle();
+
+        /**
+         * @brief Retrieves the number of clones currently opened.
+         * @return The number of clones.
+         */
+        [[nodiscard]] int size() const;
+
+        /**
+         * @brief Retrieves the number of clones currently leased.
+         * @return The number of leased clones.
+         */
+        [[nodiscard]] int leased() const;
+
+    private:
+        friend class ConnectionLease;
+
+        /**
+         * @struct Clone
+         * @brief A clone of the connection and the thread that owns it.
+         */
+        struct Clone
+        {
+            QPointer<QThread>       thread; ///< Thread that opened the clone, null once it is deleted.
+            QSqlDatabase            database; ///< The cloned connection.
+            int                     leases = 0; ///< Number of active leases in the owner thread.
+            QElapsedTimer           idle; ///< Time elapsed since the last lease was returned.
+            QMetaObject::Connection finished; ///< Connection to the QThread::finished signal of the owner.
+        };
+
+        /**
+         * @brief Returns a connection leased by the current thread.
+         * @param database The connection being returned.
+         */
+        void release(const QSqlDatabase &database);
+
+        /**
+         * @brief Closes the clone owned by a thread, if it is idle.
+         * @param thread The owner thread.
+         */
+        void threadFinished(QThread *thread);
+
+        /**
+         * @brief Checks whether a clone can be closed from the current thread.
+         * @param clone The clone.
+         * @return true if the clone belongs to the current thread or its thread has finished.
+         */
+        [[nodiscard]] static bool isClosable(const Clone &clone);
+
+        /**
+         * @brief Closes and removes a clone, the mutex must be held.
+         * @param index Position of the clone in m_clones.
+         */
+        void removeClone(qsizetype index);
+
+        /**
+         * @brief Closes the closable clones idle longer than the idle timeout, the mutex must be held.
+         * @return The number of clones closed.
+         */
+        int removeExpired();
+
+        /**
+         * @brief Closes the least recently used closable idle clone to free a slot, the mutex must be held.
+         * @return true if a clone was closed.
+         */
+        bool evictLeastRecentlyUsed();
+
+        QString                                   m_connectionName; ///< Name of the connection being cloned.
+        QThread                                  *m_owner; ///< Thread that uses the original connection.
+        int                                       m_maxConnections; ///< Maximum number of clones.
+        std::chrono::milliseconds                 m_idleTimeout; ///< Time a clone can stay idle.
+        std::function<void(const QSqlDatabase &)> m_initializer; ///< Applied to every clone once it is opened.
+        quint64                                   m_nextId = 0; ///< Sequence used to name the clones.
+        QList<Clone>                              m_clones; ///< The opened clones.
+        mutable QMutex                            m_mutex; ///< Protects m_clones.
+        QWaitCondition                            m_released; ///< Signalled when a clone becomes idle or is removed.
+    };
+
+} // namespace core::db
@@ -0,0 +1,87 @@
+/**
+ * @file cursor.cpp
+ * @brief Implementation file for the Cursor class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "cursor.h"
+#include "query_profiler.h"
+
+#include <utility>
+
+namespace core::db
+{
+
+    Cursor::Cursor(std::shared_ptr<QSqlQuery> statement, QString profileName) :
+        m_statement(std::move(statement)), m_profileName(std::move(profileName))
+    {
+    }
+
+    Cursor::Cursor(Cursor &&other) noexcept :
+        m_statement(std::move(other.m_statement)), m_record(std::move(other.m_record)),
+        m_profileName(std::move(other.m_profileName)), m_rows(std::exchange(other.m_rows, 0))
+    {
+    }
+
+    Cursor &Cursor::operator=(Cursor &&other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            m_statement   = std::move(other.m_statement);
+            m_record      = std::move(other.m_record);
+            m_profileName = std::move(other.m_profileName);
+            m_rows        = std::exchange(other.m_rows, 0);
+        }
+        return *this;
+    }
+
+    Cursor::~Cursor()
+    {
+        close();
+    }
+
+    bool Cursor::next()
+    {
+        if (m_statement && m_statement->next())
+        {
+            m_record = m_statement->record();
+            m_rows++;
+            return true;
+        }
+        m_record.clear();
+        return false;
+    }
+
+    const QSqlRecord &Cursor::record() const
+    {
+        return m_record;
+    }
+
+    void Cursor::close()
+    {
+        if (m_statement)
+        {
+            m_statement->finish();
+            m_statement.reset();
+            if (!m_profileName.isEmpty())
+            {
+                QueryProfiler::addRows(m_profileName, m_rows);
+            }
+        }
+    }
+
+    Cursor::iterator Cursor::begin()
+    {
+        return next() ? iterator(this) : end();
+    }
+
+    Cursor::iterator Cursor::end()
+    {
+        return iterator();
+    }
+
+} // namespace core::db
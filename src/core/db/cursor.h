@@ -0,0 +1,147 @@
+/**
+ * @file cursor.h
+ * @brief Header file for the Cursor class.
+ *
+ * This file declares the Cursor class, a forward-only range over the rows returned
+ * by a prepared statement, which allows processing large result sets in constant memory.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "dllexports.h"
+
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <iterator>
+#include <memory>
+
+namespace core::db
+{
+
+    /**
+     * @class Cursor
+     * @brief Forward-only range over the rows of an executed statement.
+     *
+     * The Cursor keeps only the current row in memory, rows are fetched from the driver
+     * as the range is iterated, so the caller can stop at any time without reading the
+     * rest of the result set. The statement is released when the cursor is destroyed.
+     */
+    class CORE_API Cursor
+    {
+    public:
+        /**
+         * @class iterator
+         * @brief Input iterator returned by Cursor::begin() and Cursor::end().
+         */
+        class iterator
+        {
+        public:
+            using iterator_category = std::input_iterator_tag;
+            using value_type        = QSqlRecord;
+            using difference_type   = std::ptrdiff_t;
+            using pointer           = const QSqlRecord *;
+            using reference         = const QSqlRecord &;
+
+            /**
+             * @brief Constructs the past-the-end iterator.
+             */
+            iterator() = default;
+
+            /**
+             * @brief Constructs an iterator positioned on the current row of a cursor.
+             * @param cursor The cursor to iterate, nullptr for the past-the-end iterator.
+             */
+            explicit iterator(Cursor *cursor) : m_cursor(cursor)
+            {
+            }
+
+            reference operator*() const
+            {
+                return m_cursor->record();
+            }
+
+            pointer operator->() const
+            {
+                return &m_cursor->record();
+            }
+
+            iterator &operator++()
+            {
+                if (!m_cursor->next())
+                {
+                    m_cursor = nullptr;
+                }
+                return *this;
+            }
+
+            void operator++(int)
+            {
+                ++*this;
+            }
+
+            bool operator==(const iterator &other) const = default;
+
+        private:
+            Cursor *m_cursor = nullptr; ///< Cursor being iterated, nullptr once the rows are exhausted.
+        };
+
+        /**
+         * @brief Constructs a cursor over an already executed statement.
+         * @param statement The executed statement, it should be forward-only to avoid caching the rows.
+         * @param profileName Name of the statement in the QueryProfiler, which gets the rows fetched
+         * when the cursor is closed, empty while the profiler is disabled.
+         */
+        explicit Cursor(std::shared_ptr<QSqlQuery> statement, QString profileName = {});
+
+        Cursor(const Cursor &)            = delete;
+        Cursor &operator=(const Cursor &) = delete;
+        Cursor(Cursor &&other) noexcept;
+        Cursor &operator=(Cursor &&other) noexcept;
+
+        /**
+         * @brief Releases the statement, so its read lock is not held after an early stop.
+         */
+        ~Cursor();
+
+        /**
+         * @brief Fetches the next row.
+         * @return true if a row was fetched, false when there are no more rows.
+         */
+        bool next();
+
+        /**
+         * @brief Retrieves the current row.
+         * @return A constant reference to the current QSqlRecord.
+         */
+        [[nodiscard]] const QSqlRecord &record() const;
+
+        /**
+         * @brief Releases the statement before the cursor is destroyed.
+         */
+        void close();
+
+        /**
+         * @brief Fetches the first row and returns an iterator positioned on it.
+         * @return An iterator to the first row, or end() if there are no rows.
+         */
+        iterator begin();
+
+        /**
+         * @brief Returns the past-the-end iterator.
+         * @return The past-the-end iterator.
+         */
+        static iterator end();
+
+    private:
+        std::shared_ptr<QSqlQuery> m_statement; ///< The executed statement the rows are fetched from.
+        QSqlRecord                 m_record; ///< The current row.
+        QString                    m_profileName; ///< Name of the statement in the QueryProfiler.
+        quint64                    m_rows = 0; ///< Rows fetched.
+    };
+
+} // namespace core::db
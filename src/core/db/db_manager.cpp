@@ -8,6 +8,11 @@
  */
 #include "db_manager.h"
 
+#include <QSqlError>
+
+#include "db_exception.h"
+#include "tools/trace.h"
+
 namespace core::db
 {
 
@@ -27,14 +32,11 @@ namespace core::db
         {
             throw DBManagerException("This type of database is not registered.");
         }
+        // Registered under its name, which the pools clone and the tuning options are kept by
+        m_connections[connectionName] = QSqlDatabase::addDatabase(dbType, connectionName);
         if (connectionName == "main")
         {
-            m_main                        = QSqlDatabase::addDatabase(dbType);
-            m_connections[connectionName] = m_main;
-        }
-        else
-        {
-            m_connections[connectionName] = QSqlDatabase::addDatabase(dbType);
+            m_main = m_connections[connectionName];
         }
         if (dbType.compare(DBManager::QSQLITE) == 0)
         {
@@ -43,11 +45,87 @@ namespace core::db
         return m_connections[connectionName];
     }
 
+    QSqlDatabase DBManager::connect(const QString &connectionInfo, const SQLiteOptions &options,
+                                    const QString &connectionName)
+    {
+        const tools::ScopedSpan span("db.open", "db", connectionInfo);
+        auto                    database = connect(QSQLITE, connectionInfo, connectionName);
+        if (!database.open())
+        {
+            throw DBManagerException(database.lastError().text());
+        }
+        try
+        {
+            options.apply(database);
+        }
+        catch (const SQLError &error)
+        {
+            throw DBManagerException(error.what());
+        }
+        m_sqliteOptions[connectionName] = options;
+        return database;
+    }
+
     QSqlDatabase &DBManager::connection(const QString &connectionName)
     {
         return m_connections[connectionName];
     }
 
+    std::shared_ptr<ConnectionPool> DBManager::enablePool(const QString &connectionName, int maxConnections,
+                                                          std::chrono::milliseconds idleTimeout)
+    {
+        if (!QSqlDatabase::contains(connectionName))
+        {
+            throw DBManagerException(QString("The connection %1 is not registered.").arg(connectionName));
+        }
+        QMutexLocker locker(&m_poolsMutex);
+        auto        &pool = m_pools[connectionName];
+        if (!pool)
+        {
+            std::function<void(const QSqlDatabase &)> initializer;
+            if (m_sqliteOptions.contains(connectionName))
+            {
+                initializer = [options = m_sqliteOptions[connectionName]](const QSqlDatabase &database)
+                { options.apply(database); };
+            }
+            pool = std::make_shared<ConnectionPool>(connectionName, maxConnections, idleTimeout, initializer);
+        }
+        return pool;
+    }
+
+    std::shared_ptr<ConnectionPool> DBManager::pool(const QString &connectionName) const
+    {
+        QMutexLocker locker(&m_poolsMutex);
+        return m_pools.value(connectionName);
+    }
+
+    ConnectionLease DBManager::lease(const QString &connectionName, std::chrono::milliseconds wait) const
+    {
+        const auto connectionPool = pool(connectionName);
+        if (!connectionPool)
+        {
+            throw DBManagerException(QString("The pooled mode is not enabled for %1.").arg(connectionName));
+        }
+        return connectionPool->lease(wait);
+    }
+
+    std::shared_ptr<StatementCache> DBManager::statementCache(const QSqlDatabase &database)
+    {
+        QMutexLocker locker(&m_statementCachesMutex);
+        auto        &cache = m_statementCaches[database.connectionName()];
+        if (!cache)
+        {
+            cache = std::make_shared<StatementCache>(database);
+        }
+        return cache;
+    }
+
+    void DBManager::releaseStatementCache(const QString &connectionName)
+    {
+        QMutexLocker locker(&m_statementCachesMutex);
+        m_statementCaches.remove(connectionName);
+    }
+
     const QSet<QString> &DBManager::allowTypes()
     {
         return m_allowedDBTypes;
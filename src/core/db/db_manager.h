@@ -16,9 +16,14 @@
 #include "dllexports.h"
 
 #include <QMap>
+#include <QMutex>
 #include <QSet>
 #include <QSqlDatabase>
 #include <exception.h>
+#include <memory>
+#include "connection_pool.h"
+#include "statement_cache.h"
+#include "db/sqlite/sqlite_options.h"
 
 namespace core::db
 {
@@ -83,6 +88,21 @@ namespace core::db
         [[nodiscard]] QSqlDatabase connect(const QString &dbType, const QString &connectionInfo = "",
                                            const QString &connectionName = DEFAULT_CONNECTION);
 
+        /**
+         * @brief Establishes and opens a tuned SQLite connection.
+         *
+         * The options are applied right after the connection is opened, and again on every
+         * clone leased from its pool, see enablePool().
+         *
+         * @param connectionInfo The path of the database file.
+         * @param options The tuning of the connection, see SQLiteOptions::interactive().
+         * @param connectionName The name of the database connection.
+         * @return A `QSqlDatabase` object representing the opened connection.
+         * @throws DBManagerException if the connection cannot be opened or tuned.
+         */
+        [[nodiscard]] QSqlDatabase connect(const QString &connectionInfo, const SQLiteOptions &options,
+                                           const QString &connectionName = DEFAULT_CONNECTION);
+
         /**
          * @brief Retrieves an existing database connection.
          *
@@ -113,6 +133,58 @@ namespace core::db
             return m_main;
         }
 
+        /**
+         * @brief Enables the pooled mode for a connection.
+         *
+         * Must be called from the thread that opened the connection, which keeps using it directly.
+         * The other threads lease their own clone of it through lease().
+         *
+         * @param connectionName The name of the connection to pool.
+         * @param maxConnections Maximum number of clones opened at the same time.
+         * @param idleTimeout Time a clone can stay unused before it is closed.
+         * @return The pool of the connection.
+         * @throws DBManagerException if the connection is not registered.
+         */
+        std::shared_ptr<ConnectionPool> enablePool(
+                const QString            &connectionName = DEFAULT_CONNECTION,
+                int                       maxConnections = ConnectionPool::DEFAULT_MAX_CONNECTIONS,
+                std::chrono::milliseconds idleTimeout    = ConnectionPool::DEFAULT_IDLE_TIMEOUT);
+
+        /**
+         * @brief Retrieves the pool of a connection.
+         * @param connectionName The name of the pooled connection.
+         * @return The pool, or nullptr if the pooled mode is not enabled for the connection.
+         */
+        [[nodiscard]] std::shared_ptr<ConnectionPool> pool(const QString &connectionName = DEFAULT_CONNECTION) const;
+
+        /**
+         * @brief Leases a connection usable from the current thread.
+         *
+         * Worker threads, such as the ones used by QtConcurrent::run, must lease the connection
+         * instead of using the one returned by connection() or main().
+         *
+         * @param connectionName The name of the pooled connection.
+         * @param wait Maximum time to wait for a free connection when the pool is full.
+         * @return The lease, the connection returns to the pool when it is destroyed.
+         * @throws DBManagerException if the pooled mode is not enabled for the connection.
+         * @throws ConnectionPoolException if no connection is available in time.
+         */
+        [[nodiscard]] ConnectionLease lease(const QString            &connectionName = DEFAULT_CONNECTION,
+                                            std::chrono::milliseconds wait = ConnectionPool::DEFAULT_WAIT) const;
+
+        /**
+         * @brief Retrieves the prepared statement cache of a connection, creating it on first use.
+         * @param database The connection, the cache is shared by every user of its connection name.
+         * @return The statement cache of the connection.
+         */
+        [[nodiscard]] std::shared_ptr<StatementCache> statementCache(const QSqlDatabase &database);
+
+        /**
+         * @brief Drops the prepared statement cache of a connection, call it before removing the connection.
+         * @param connectionName The name of the connection.
+         */
+        void releaseStatementCache(const QString &connectionName);
+
     private:
         /**
          * @brief Private constructor for the singleton pattern.
@@ -121,9 +193,14 @@ namespace core::db
          */
         DBManager();
 
-        QSqlDatabase                m_main; ///< Main database connection.
-        QMap<QString, QSqlDatabase> m_connections; ///< Map of connection names to `QSqlDatabase` objects.
-        static const QSet<QString>  m_allowedDBTypes; ///< Allowed database types for connections.
+        QSqlDatabase                                   m_main; ///< Main database connection.
+        QMap<QString, QSqlDatabase>                    m_connections; ///< Map of connection names to `QSqlDatabase` objects.
+        QMap<QString, SQLiteOptions>                   m_sqliteOptions; ///< Tuning of the SQLite connections.
+        QMap<QString, std::shared_ptr<StatementCache>> m_statementCaches; ///< Statement caches, destroyed after m_pools.
+        QMutex                                         m_statementCachesMutex; ///< Protects m_statementCaches.
+        QMap<QString, std::shared_ptr<ConnectionPool>> m_pools; ///< Pools of the connections in pooled mode.
+        mutable QMutex                                 m_poolsMutex; ///< Protects m_pools, leased from any thread.
+        static const QSet<QString>                     m_allowedDBTypes; ///< Allowed database types for connections.
     };
 
 } // namespace core::db
@@ -9,108 +9,411 @@
 
 #include "dynamic_table.h"
 
+#include "db_manager.h"
 #include "factory.h"
+#include "query_profiler.h"
+#include "tools/trace.h"
+#include "transaction.h"
 
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QVariantList>
 
 namespace core::db
 {
 
     DynamicTable::DynamicTable(const QSqlDatabase &database, QString name,
                                const std::initializer_list<std::shared_ptr<db::Column>> columns) :
-        m_database(database), m_name(std::move(name)), m_builder(Factory::builder(m_database.driverName()))
+        DynamicTable(database, std::move(name), TableSchema(columns))
+    {
+    }
+
+    DynamicTable::DynamicTable(const QSqlDatabase &database, QString name, TableSchema schema) :
+        m_database(database), m_name(std::move(name)), m_schema(std::move(schema)),
+        m_sentences(Factory::statements(m_database.driverName(), m_name, m_schema))
     {
-        m_builder->setTableName(m_name);
-        for (const auto &column: columns)
-        {
-            m_builder->addColumn(column);
-        }
-        m_sentences[DynamicTable::CREATE]    = m_builder->createTable();
-        m_sentences[DynamicTable::INSERT]    = m_builder->createInsert();
-        m_sentences[DynamicTable::UPDATE]    = m_builder->createUpdate();
-        m_sentences[DynamicTable::DELETE]    = m_builder->createDelete();
-        m_sentences[DynamicTable::SELECT]    = m_builder->createSelect();
-        m_sentences[DynamicTable::SELECT_PK] = m_builder->createSelectPk();
+    }
+
+    const TableSchema &DynamicTable::schema() const
+    {
+        return m_schema;
     }
 
     std::shared_ptr<QSqlQuery> DynamicTable::ensureStatementExists(const QString &name, const QString &statement)
     {
         if (m_statements[name] == nullptr)
         {
-            m_statements[name] = std::make_shared<QSqlQuery>(m_database);
-            if (!statement.isEmpty())
+            if (statement.isEmpty())
             {
-                m_statements[name]->prepare(statement);
+                m_statements[name] = std::make_shared<QSqlQuery>(m_database);
+                m_statements[name]->setForwardOnly(true);
             }
+            else
+            {
+                // Tables with the same definition on the same connection share the compiled statements
+                m_statements[name] = DBManager::manager().statementCache(m_database)->acquire(statement);
+            }
+        }
+        return m_statements[name];
+    }
+
+    std::shared_ptr<QSqlQuery> DynamicTable::ensureCursorExists(const QString &name, const QString &statement)
+    {
+        if (m_statements[name] == nullptr)
+        {
+            m_statements[name] = std::make_shared<QSqlQuery>(m_database);
+            m_statements[name]->setForwardOnly(true);
+            m_statements[name]->prepare(statement);
         }
         return m_statements[name];
     }
 
     void DynamicTable::create()
     {
-        const auto statement = ensureStatementExists(DynamicTable::CREATE);
-        if (!statement->exec(m_sentences[DynamicTable::CREATE]))
+        const tools::ScopedSpan span("DynamicTable::create", "db", m_name);
+        const auto              statement = ensureStatementExists(DynamicTable::CREATE);
+        if (!statement->exec(m_sentences->create))
         {
             throw SQLError(statement->lastError().text());
         }
+        for (const auto &index: m_sentences->indexes)
+        {
+            if (!statement->exec(index))
+            {
+                throw SQLError(statement->lastError().text());
+            }
+        }
     }
 
     void DynamicTable::insert(const QMap<QString, QVariant> &columns)
     {
-        const auto statement = ensureStatementExists(DynamicTable::INSERT, m_sentences[DynamicTable::INSERT]);
-        exec(statement, columns);
+        const auto statement = ensureStatementExists(DynamicTable::INSERT, m_sentences->insert);
+        exec("DynamicTable::insert", statement, columns);
     }
 
     void DynamicTable::update(const QMap<QString, QVariant> &columns)
     {
-        const auto statement = ensureStatementExists(DynamicTable::UPDATE, m_sentences[DynamicTable::UPDATE]);
-        exec(statement, columns);
+        const auto statement = ensureStatementExists(DynamicTable::UPDATE, m_sentences->update);
+        exec("DynamicTable::update", statement, columns);
+    }
+
+    void DynamicTable::upsert(const QMap<QString, QVariant> &columns)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPSERT, m_sentences->upsert);
+        exec("DynamicTable::upsert", statement, columns);
     }
 
     void DynamicTable::deleteRows(const QMap<QString, QVariant> &columns)
     {
-        const auto statement = ensureStatementExists(DynamicTable::DELETE, m_sentences[DynamicTable::DELETE]);
-        exec(statement, columns);
+        const auto statement = ensureStatementExists(DynamicTable::DELETE, m_sentences->remove);
+        exec("DynamicTable::delete", statement, columns);
+    }
+
+    void DynamicTable::insertMany(const QMap<QString, QVariantList> &columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::INSERT, m_sentences->insert);
+        execBatch("DynamicTable::insertMany", statement, columns, chunkSize);
+    }
+
+    void DynamicTable::updateMany(const QMap<QString, QVariantList> &columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPDATE, m_sentences->update);
+        execBatch("DynamicTable::updateMany", statement, columns, chunkSize);
+    }
+
+    void DynamicTable::upsertMany(const QMap<QString, QVariantList> &columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPSERT, m_sentences->upsert);
+        execBatch("DynamicTable::upsertMany", statement, columns, chunkSize);
+    }
+
+    void DynamicTable::deleteMany(const QMap<QString, QVariantList> &columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::DELETE, m_sentences->remove);
+        execBatch("DynamicTable::deleteMany", statement, columns, chunkSize);
+    }
+
+    void DynamicTable::insertRow(const Row row)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::INSERT, m_sentences->insert);
+        execRow("DynamicTable::insertRow", statement, m_sentences->insertBinding, row, m_schema.size());
+    }
+
+    void DynamicTable::updateRow(const Row row)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPDATE, m_sentences->update);
+        execRow("DynamicTable::updateRow", statement, m_sentences->updateBinding, row, m_schema.size());
+    }
+
+    void DynamicTable::upsertRow(const Row row)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPSERT, m_sentences->upsert);
+        execRow("DynamicTable::upsertRow", statement, m_sentences->upsertBinding, row, m_schema.size());
+    }
+
+    void DynamicTable::removeRow(const Row key)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::DELETE, m_sentences->remove);
+        execRow("DynamicTable::removeRow", statement, m_sentences->keyBinding, key, m_sentences->keyBinding.size());
+    }
+
+    void DynamicTable::insertRows(const std::span<const QVariantList> columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::INSERT, m_sentences->insert);
+        execRows("DynamicTable::insertRows", statement, m_sentences->insertBinding, columns, m_schema.size(),
+                 chunkSize);
+    }
+
+    void DynamicTable::updateRows(const std::span<const QVariantList> columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPDATE, m_sentences->update);
+        execRows("DynamicTable::updateRows", statement, m_sentences->updateBinding, columns, m_schema.size(),
+                 chunkSize);
+    }
+
+    void DynamicTable::upsertRows(const std::span<const QVariantList> columns, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::UPSERT, m_sentences->upsert);
+        execRows("DynamicTable::upsertRows", statement, m_sentences->upsertBinding, columns, m_schema.size(),
+                 chunkSize);
+    }
+
+    void DynamicTable::removeRows(const std::span<const QVariantList> keys, const qsizetype chunkSize)
+    {
+        const auto statement = ensureStatementExists(DynamicTable::DELETE, m_sentences->remove);
+        execRows("DynamicTable::removeRows", statement, m_sentences->keyBinding, keys,
+                 m_sentences->keyBinding.size(), chunkSize);
     }
 
     QList<QSqlRecord> DynamicTable::select()
     {
-        const auto statement = ensureStatementExists(DynamicTable::SELECT, m_sentences[DynamicTable::SELECT]);
-        if (!statement->exec())
+        QList<QSqlRecord> records;
+        for (const auto &record: scan())
+        {
+            records.append(record);
+        }
+        return records;
+    }
+
+    QList<QSqlRecord> DynamicTable::selectPk(const QMap<QString, QVariant> &columns)
+    {
+        QList<QSqlRecord> records;
+        for (const auto &record: scanPk(columns))
+        {
+            records.append(record);
+        }
+        return records;
+    }
+
+    Cursor DynamicTable::scan()
+    {
+        const auto    statement = ensureCursorExists(DynamicTable::SELECT, m_sentences->select);
+        ProfiledQuery profile(m_database, "DynamicTable::select", m_name);
+        if (!profile.exec(*statement))
         {
             throw SQLError(statement->lastError().text());
         }
+        return Cursor(statement, profile.name());
+    }
+
+    Cursor DynamicTable::scanPk(const QMap<QString, QVariant> &columns)
+    {
+        const auto statement = ensureCursorExists(DynamicTable::SELECT_PK, m_sentences->selectPk);
+        auto profileName = exec("DynamicTable::select_pk", statement, columns);
+        return Cursor(statement, std::move(profileName));
+    }
+
+    QList<QSqlRecord> DynamicTable::selectByKey(const Row key)
+    {
         QList<QSqlRecord> records;
-        while (statement->next())
+        for (const auto &record: scanByKey(key))
         {
-            records.append(statement->record());
+            records.append(record);
         }
         return records;
     }
 
-    QList<QSqlRecord> DynamicTable::selectPk(const QMap<QString, QVariant> &columns)
+    Cursor DynamicTable::scanByKey(const Row key)
+    {
+        const auto statement   = ensureCursorExists(DynamicTable::SELECT_PK, m_sentences->selectPk);
+        auto       profileName = execRow("DynamicTable::select_key", statement, m_sentences->keyBinding, key,
+                                         m_sentences->keyBinding.size());
+        return Cursor(statement, std::move(profileName));
+    }
+
+    const QStringList &DynamicTable::pageKey(const QString &index) const
+    {
+        return page(index).key;
+    }
+
+    QVariantList DynamicTable::pageKeyOf(const QSqlRecord &record, const QString &index) const
+    {
+        QVariantList key;
+        for (const auto &column: page(index).key)
+        {
+            key << record.value(column);
+        }
+        return key;
+    }
+
+    QList<QSqlRecord> DynamicTable::selectPage(const Row afterKey, const qsizetype limit, const QString &index)
     {
-        const auto statement = ensureStatementExists(DynamicTable::SELECT_PK, m_sentences[DynamicTable::SELECT_PK]);
-        exec(statement, columns);
         QList<QSqlRecord> records;
-        while (statement->next())
+        for (const auto &record: scanPage(afterKey, limit, index))
         {
-            records.append(statement->record());
+            records.append(record);
         }
         return records;
     }
 
-    void DynamicTable::exec(const std::shared_ptr<QSqlQuery> &statement, const QMap<QString, QVariant> &columns)
+    Cursor DynamicTable::scanPage(const Row afterKey, const qsizetype limit, const QString &index)
     {
+        if (limit < 1)
+        {
+            throw SQLError(QString("The page size must be positive, %1 given.").arg(limit));
+        }
+        const auto &statements = page(index);
+        if (afterKey.empty())
+        {
+            const auto statement = ensureCursorExists(QString(SELECT_PAGE) + ':' + index, statements.first);
+            statement->bindValue(SQLBuilder::PAGE_SIZE, limit);
+            auto profileName = execRow("DynamicTable::select_page", statement, {}, afterKey, 0);
+            return Cursor(statement, std::move(profileName));
+        }
+        const auto statement = ensureCursorExists(QString(SELECT_NEXT_PAGE) + ':' + index, statements.next);
+        statement->bindValue(SQLBuilder::PAGE_SIZE, limit);
+        auto profileName = execRow("DynamicTable::select_next_page", statement, statements.afterBinding, afterKey,
+                                   statements.key.size());
+        return Cursor(statement, std::move(profileName));
+    }
+
+    const PageStatements &DynamicTable::page(const QString &index) const
+    {
+        const auto it = m_sentences->pages.constFind(index);
+        if (it == m_sentences->pages.cend())
+        {
+            if (index.isEmpty())
+            {
+                throw SQLError(QString("The table %1 has no primary key to paginate by.").arg(m_name));
+            }
+            throw SQLError(
+                    QString("The table %1 has no index %2 with a primary key to paginate by.").arg(m_name, index));
+        }
+        return it.value();
+    }
+
+    QString DynamicTable::exec(const char *name, const std::shared_ptr<QSqlQuery> &statement,
+                               const QMap<QString, QVariant> &columns) const
+    {
+        ProfiledQuery profile(m_database, name, m_name);
         for (auto it = columns.cbegin(); it != columns.cend(); ++it)
         {
             statement->bindValue(":" + it.key(), it.value());
         }
-        if (!statement->exec())
+        if (!profile.exec(*statement))
         {
             throw SQLError(statement->lastError().text());
         }
+        return profile.name();
+    }
+
+    void DynamicTable::execBatch(const char *name, const std::shared_ptr<QSqlQuery> &statement,
+                                 const QMap<QString, QVariantList> &columns, const qsizetype chunkSize) const
+    {
+        if (columns.isEmpty())
+        {
+            return;
+        }
+        const auto rows = columns.cbegin().value().size();
+        for (const auto &values: columns)
+        {
+            if (values.size() != rows)
+            {
+                throw SQLError("All the columns of a batch must have the same number of rows.");
+            }
+        }
+
+        execChunks(name, *statement, rows, chunkSize,
+                   [&statement, &columns](const qsizetype offset, const qsizetype size)
+                   {
+                       for (auto it = columns.cbegin(); it != columns.cend(); ++it)
+                       {
+                           statement->bindValue(":" + it.key(), it.value().mid(offset, size));
+                       }
+                   });
+    }
+
+    QString DynamicTable::execRow(const char *name, const std::shared_ptr<QSqlQuery> &statement,
+                                  const Binding &binding, const Row row, const qsizetype width) const
+    {
+        if (static_cast<qsizetype>(row.size()) != width)
+        {
+            throw SQLError(QString("The row has %1 values but %2 are expected.").arg(row.size()).arg(width));
+        }
+        ProfiledQuery profile(m_database, name, m_name);
+        for (const auto &placeholder: binding)
+        {
+            statement->bindValue(placeholder.name, row[placeholder.column]);
+        }
+        if (!profile.exec(*statement))
+        {
+            throw SQLError(statement->lastError().text());
+        }
+        return profile.name();
+    }
+
+    void DynamicTable::execRows(const char *name, const std::shared_ptr<QSqlQuery> &statement,
+                                const Binding &binding, const std::span<const QVariantList> columns,
+                                const qsizetype width, const qsizetype chunkSize) const
+    {
+        if (static_cast<qsizetype>(columns.size()) != width)
+        {
+            throw SQLError(QString("The batch has %1 columns but %2 are expected.").arg(columns.size()).arg(width));
+        }
+        if (columns.empty())
+        {
+            return;
+        }
+        const auto rows = columns.front().size();
+        for (const auto &values: columns)
+        {
+            if (values.size() != rows)
+            {
+                throw SQLError("All the columns of a batch must have the same number of rows.");
+            }
+        }
+
+        execChunks(name, *statement, rows, chunkSize,
+                   [&statement, &binding, columns](const qsizetype offset, const qsizetype size)
+                   {
+                       for (const auto &placeholder: binding)
+                       {
+                           statement->bindValue(placeholder.name, columns[placeholder.column].mid(offset, size));
+                       }
+                   });
+    }
+
+    void DynamicTable::execChunks(const char *name, QSqlQuery &statement, const qsizetype rows,
+                                  const qsizetype chunkSize,
+                                  const std::function<void(qsizetype offset, qsizetype size)> &bind) const
+    {
+        if (rows == 0)
+        {
+            return;
+        }
+
+        const auto  chunk = chunkSize > 0 ? chunkSize : rows;
+        Transaction transaction(m_database);
+        for (qsizetype offset = 0; offset < rows; offset += chunk)
+        {
+            ProfiledQuery profile(m_database, name, m_name);
+            bind(offset, chunk);
+            if (!profile.execBatch(statement))
+            {
+                throw SQLError(statement.lastError().text());
+            }
+        }
+        transaction.commit();
     }
 
 } // namespace core::db
@@ -14,12 +14,17 @@
 #pragma once
 
 #include "column.h"
+#include "cursor.h"
 #include "db_exception.h"
 #include "sql_builder.h"
+#include "table_schema.h"
 
 #include <QMap>
 #include <QSqlQuery>
 #include <QSqlRecord>
+#include <array>
+#include <functional>
+#include <span>
 
 namespace core::db
 {
@@ -36,12 +41,37 @@ namespace core::db
     class CORE_API DynamicTable
     {
     public:
-        static constexpr auto CREATE    = "create"; ///< Represents the CREATE statement type.
-        static constexpr auto INSERT    = "insert"; ///< Represents the INSERT statement type.
-        static constexpr auto DELETE    = "delete"; ///< Represents the DELETE statement type.
-        static constexpr auto UPDATE    = "update"; ///< Represents the UPDATE statement type.
-        static constexpr auto SELECT    = "select"; ///< Represents the SELECT statement type.
-        static constexpr auto SELECT_PK = "select_pk"; ///< Represents the SELECT_PK statement type.
+        static constexpr auto CREATE           = "create"; ///< Represents the CREATE statement type.
+        static constexpr auto INSERT           = "insert"; ///< Represents the INSERT statement type.
+        static constexpr auto DELETE           = "delete"; ///< Represents the DELETE statement type.
+        static constexpr auto UPDATE           = "update"; ///< Represents the UPDATE statement type.
+        static constexpr auto UPSERT           = "upsert"; ///< Represents the UPSERT statement type.
+        static constexpr auto SELECT           = "select"; ///< Represents the SELECT statement type.
+        static constexpr auto SELECT_PK        = "select_pk"; ///< Represents the SELECT_PK statement type.
+        static constexpr auto SELECT_PAGE      = "select_page"; ///< Represents the first page statement type.
+        static constexpr auto SELECT_NEXT_PAGE = "select_next_page"; ///< Represents the next page statement type.
+
+        static constexpr qsizetype DEFAULT_CHUNK_SIZE = 500; ///< Default number of rows bound per batch execution.
+
+        /**
+         * @brief Values of a row, bound by position.
+         *
+         * The values follow the order of the columns of the schema, or the order of the key columns
+         * for the methods that locate rows by key. A std::array, as returned by row(), or a
+         * QVarLengthArray holds them without allocating.
+         */
+        using Row = std::span<const QVariant>;
+
+        /**
+         * @brief Packs the values of a row in a fixed size array.
+         * @param values The values, in the order of the columns.
+         * @return The array of values, to be passed as a Row.
+         */
+        template<typename... Values>
+        [[nodiscard]] static std::array<QVariant, sizeof...(Values)> row(Values &&...values)
+        {
+            return {QVariant(std::forward<Values>(values))...};
+        }
 
         /**
          * @brief Constructs a DynamicTable with a specified name and columns.
@@ -53,16 +83,35 @@ namespace core::db
                               std::initializer_list<std::shared_ptr<db::Column>> columns);
 
         /**
-         * @brief Retrieves the list of columns associated with the table.
-         * @return A constant vector of shared pointers to Column objects.
+         * @brief Constructs a DynamicTable with a specified name and schema.
+         * @param database A reference to the active database connection.
+         * @param name The name of the table.
+         * @param schema The flat schema of the columns.
+         */
+        explicit DynamicTable(const QSqlDatabase &database, QString name, TableSchema schema);
+
+        /**
+         * @brief Retrieves the columns of the table.
+         * @return A constant reference to the flat schema of the columns.
          */
-        [[nodiscard]] const QVector<std::shared_ptr<Column>> &columns() const;
+        [[nodiscard]] const TableSchema &schema() const;
+
+        /**
+         * @brief Retrieves the database connection used by the table.
+         * @return The connection, for instance to take a Transaction on it.
+         */
+        [[nodiscard]] const QSqlDatabase &database() const
+        {
+            return m_database;
+        }
 
         /**
          * @brief Executes SQL to create the table based on its defined columns.
          *
          * Generates and executes a SQL CREATE statement to initialize the table
-         * structure in the database.
+         * structure in the database, then creates its indexes.
+         *
+         * @throws SQLError if a statement fails.
          */
         void create();
 
@@ -86,6 +135,16 @@ namespace core::db
          */
         void update(const QMap<QString, QVariant> &columns);
 
+        /**
+         * @brief Inserts a row, or updates it when its primary key already exists.
+         *
+         * Constructs and executes an SQL UPSERT statement using the provided
+         * column-value mappings.
+         *
+         * @param columns A map of column names to values for insertion or updating.
+         */
+        void upsert(const QMap<QString, QVariant> &columns);
+
         /**
          * @brief Deletes rows from the table based on specified conditions.
          *
@@ -96,11 +155,113 @@ namespace core::db
          */
         void deleteRows(const QMap<QString, QVariant> &columns);
 
+        /**
+         * @brief Inserts a columnar batch of rows into the table.
+         *
+         * Binds every column list to the cached INSERT statement and executes it through
+         * QSqlQuery::execBatch, splitting the rows in chunks of @p chunkSize. The whole batch
+         * runs inside a single transaction, so either every row is stored or none is.
+         *
+         * @param columns A map of column names to the list of values of each row.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void insertMany(const QMap<QString, QVariantList> &columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Updates a columnar batch of rows in the table.
+         *
+         * Same as insertMany() but using the cached UPDATE statement, each row is located by its primary key.
+         *
+         * @param columns A map of column names to the list of values of each row.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void updateMany(const QMap<QString, QVariantList> &columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Inserts or updates a columnar batch of rows in the table.
+         *
+         * Same as insertMany() but using the cached UPSERT statement, so existing rows are updated.
+         *
+         * @param columns A map of column names to the list of values of each row.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void upsertMany(const QMap<QString, QVariantList> &columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Deletes a columnar batch of rows from the table.
+         *
+         * Same as insertMany() but using the cached DELETE statement, only the primary key columns are required.
+         *
+         * @param columns A map of primary key column names to the list of values of each row.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void deleteMany(const QMap<QString, QVariantList> &columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Inserts a row given by position.
+         *
+         * Same as insert() but the values are bound by position to the placeholders resolved when
+         * the statements of the schema were generated, so binding them allocates nothing. The
+         * values of the autoincrement columns and of the columns with a default value are ignored.
+         *
+         * @param row One value per column of the schema.
+         */
+        void insertRow(Row row);
+
+        /**
+         * @brief Updates a row given by position, located by its primary key.
+         * @param row One value per column of the schema.
+         */
+        void updateRow(Row row);
+
+        /**
+         * @brief Inserts or updates a row given by position.
+         * @param row One value per column of the schema.
+         */
+        void upsertRow(Row row);
+
+        /**
+         * @brief Deletes the rows matching a key given by position.
+         * @param key One value per key column.
+         */
+        void removeRow(Row key);
+
+        /**
+         * @brief Inserts a columnar batch of rows given by position.
+         *
+         * Same as insertMany() but each value list is bound by position.
+         *
+         * @param columns One value list per column of the schema.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void insertRows(std::span<const QVariantList> columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Updates a columnar batch of rows given by position.
+         * @param columns One value list per column of the schema.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void updateRows(std::span<const QVariantList> columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Inserts or updates a columnar batch of rows given by position.
+         * @param columns One value list per column of the schema.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void upsertRows(std::span<const QVariantList> columns, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
+        /**
+         * @brief Deletes a columnar batch of keys given by position.
+         * @param keys One value list per key column.
+         * @param chunkSize The maximum number of rows bound per execution, a value lower than one binds all of them.
+         */
+        void removeRows(std::span<const QVariantList> keys, qsizetype chunkSize = DEFAULT_CHUNK_SIZE);
+
         /**
          * @brief Selects rows from the table using the primary key values.
          *
          * Constructs and executes a SELECT query to retrieve rows that match
-         * the specified primary key values.
+         * the specified primary key values. Convenience wrapper that materializes scanPk().
          *
          * @param columns A map of primary key column names to their values.
          * @return A list of QSqlRecord objects containing the selected rows.
@@ -111,17 +272,112 @@ namespace core::db
          * @brief Selects all rows from the table.
          *
          * Executes a SELECT query to retrieve all records in the table.
+         * Convenience wrapper that materializes scan().
          *
          * @return A list of QSqlRecord objects containing all rows in the table.
          */
         QList<QSqlRecord> select();
 
+        /**
+         * @brief Streams all rows of the table.
+         *
+         * Executes the forward-only SELECT statement and returns a cursor that fetches the rows
+         * one at a time, so large tables are processed in constant memory and the caller can stop
+         * early. The selects of a DynamicTable are prepared on a query of their own, not taken from
+         * the statement cache, so other objects on the same connection do not disturb the cursor,
+         * but running the same select again on this object while it is being iterated invalidates it.
+         *
+         * @return A Cursor over the rows of the table.
+         */
+        [[nodiscard]] Cursor scan();
+
+        /**
+         * @brief Streams the rows matching the primary key values.
+         *
+         * Same as scan() but using the SELECT statement filtered by primary key.
+         *
+         * @param columns A map of primary key column names to their values.
+         * @return A Cursor over the selected rows.
+         */
+        [[nodiscard]] Cursor scanPk(const QMap<QString, QVariant> &columns);
+
+        /**
+         * @brief Selects the rows matching a key given by position.
+         *
+         * Same as selectPk() but binding the key by position.
+         *
+         * @param key One value per key column.
+         * @return A list of QSqlRecord objects containing the selected rows.
+         */
+        QList<QSqlRecord> selectByKey(Row key);
+
+        /**
+         * @brief Streams the rows matching a key given by position.
+         * @param key One value per key column.
+         * @return A Cursor over the selected rows.
+         */
+        [[nodiscard]] Cursor scanByKey(Row key);
+
+        /**
+         * @brief Retrieves the columns a keyset pagination is ordered by.
+         * @param index The name of the index to order by, empty for the primary key.
+         * @return The columns whose values locate the page after a row, see pageKeyOf().
+         * @throws SQLError if the table has no primary key or no such index.
+         */
+        [[nodiscard]] const QStringList &pageKey(const QString &index = {}) const;
+
+        /**
+         * @brief Retrieves the key a page starts after.
+         * @param record The last row of the previous page.
+         * @param index The name of the index the pages are ordered by, empty for the primary key.
+         * @return The values of the key columns of the row, to be passed to selectPage().
+         * @throws SQLError if the table has no primary key or no such index.
+         */
+        [[nodiscard]] QVariantList pageKeyOf(const QSqlRecord &record, const QString &index = {}) const;
+
+        /**
+         * @brief Selects a page of rows using keyset pagination.
+         *
+         * The rows are ordered by the primary key, or by the columns of an index followed by the
+         * primary key, and the page holds the @p limit rows after @p afterKey. Each page is an
+         * index range scan that costs the same whatever its position, unlike OFFSET, which reads
+         * and discards every previous row. Convenience wrapper that materializes scanPage().
+         *
+         * @param afterKey The key of the last row of the previous page, see pageKeyOf(), empty for the first page.
+         * @param limit The maximum number of rows of the page.
+         * @param index The name of the index to order by, empty for the primary key.
+         * @return A list of QSqlRecord objects containing the rows of the page.
+         * @throws SQLError if the table has no primary key or no such index, or the key has not one value per column.
+         */
+        QList<QSqlRecord> selectPage(Row afterKey, qsizetype limit, const QString &index = {});
+
+        /**
+         * @brief Streams a page of rows using keyset pagination.
+         *
+         * Same as selectPage() but returning a cursor over the rows of the page.
+         *
+         * @param afterKey The key of the last row of the previous page, empty for the first page.
+         * @param limit The maximum number of rows of the page.
+         * @param index The name of the index to order by, empty for the primary key.
+         * @return A Cursor over the rows of the page.
+         */
+        [[nodiscard]] Cursor scanPage(Row afterKey, qsizetype limit, const QString &index = {});
+
     private:
+        /**
+         * @brief Retrieves the statements of a keyset pagination.
+         * @param index The name of the index, empty for the primary key.
+         * @return The statements of the pagination.
+         * @throws SQLError if the table has no primary key or no such index.
+         */
+        [[nodiscard]] const PageStatements &page(const QString &index) const;
+
         /**
          * @brief Ensures that a prepared statement exists for the given SQL operation.
          *
          * Checks for an existing prepared statement for the specified SQL statement type,
-         * creating and storing it if it does not already exist.
+         * taking it from the statement cache of the connection if it does not already exist.
+         * Statements are forward-only, so the driver does not cache the rows already fetched.
          *
          * @param name The name of the SQL statement type (e.g., INSERT, UPDATE).
          * @param statement The SQL query to prepare (optional).
@@ -129,22 +385,92 @@ namespace core::db
          */
         std::shared_ptr<QSqlQuery> ensureStatementExists(const QString &name, const QString &statement = "");
 
+        /**
+         * @brief Ensures that a prepared SELECT owned by this object exists, for the statements read through a Cursor.
+         *
+         * A Cursor keeps reading its statement after the call that executed it, so the statement is
+         * prepared on a query of its own instead of the one shared through the statement cache.
+         *
+         * @param name The name of the SQL statement type (e.g., SELECT, SELECT_PK).
+         * @param statement The SQL query to prepare.
+         * @return A shared pointer to the prepared QSqlQuery object.
+         */
+        std::shared_ptr<QSqlQuery> ensureCursorExists(const QString &name, const QString &statement);
+
         /**
          * @brief Executes a prepared SQL statement with the specified bound values.
          *
          * Binds each column name to its corresponding value in the provided map,
          * then executes the SQL statement.
          *
+         * @param name The name the execution is profiled with, see QueryProfiler.
          * @param statement A shared pointer to the QSqlQuery object to execute.
          * @param columns A map of column names and their values to bind to the statement.
+         * @return The profiled name of the statement, empty while the profiler is disabled.
+         */
+        QString exec(const char *name, const std::shared_ptr<QSqlQuery> &statement,
+                     const QMap<QString, QVariant> &columns) const;
+
+        /**
+         * @brief Executes a prepared SQL statement once per row of a columnar batch.
+         *
+         * Opens a Transaction on the table connection, binds the value lists in chunks and runs
+         * QSqlQuery::execBatch for each chunk. The transaction is rolled back if any chunk fails,
+         * inside an outer transaction only the rows of the batch are.
+         *
+         * @param name The name the executions are profiled with, see QueryProfiler.
+         * @param statement A shared pointer to the QSqlQuery object to execute.
+         * @param columns A map of column names and the list of values to bind to the statement.
+         * @param chunkSize The maximum number of rows bound per execution.
+         */
+        void execBatch(const char *name, const std::shared_ptr<QSqlQuery> &statement,
+                       const QMap<QString, QVariantList> &columns, qsizetype chunkSize) const;
+
+        /**
+         * @brief Executes a prepared SQL statement with the values of a row bound by position.
+         *
+         * @param name The name the execution is profiled with, see QueryProfiler.
+         * @param statement A shared pointer to the QSqlQuery object to execute.
+         * @param binding The placeholders of the statement and the position of their values.
+         * @param row The values, @p width of them.
+         * @param width The number of values the statement expects.
+         * @return The profiled name of the statement, empty while the profiler is disabled.
+         */
+        QString execRow(const char *name, const std::shared_ptr<QSqlQuery> &statement, const Binding &binding,
+                        Row row, qsizetype width) const;
+
+        /**
+         * @brief Executes a prepared SQL statement once per row of a columnar batch bound by position.
+         *
+         * Same as execBatch() but binding the value lists by position.
+         *
+         * @param name The name the executions are profiled with, see QueryProfiler.
+         * @param statement A shared pointer to the QSqlQuery object to execute.
+         * @param binding The placeholders of the statement and the position of their value lists.
+         * @param columns The value lists, @p width of them.
+         * @param width The number of value lists the statement expects.
+         * @param chunkSize The maximum number of rows bound per execution.
+         */
+        void execRows(const char *name, const std::shared_ptr<QSqlQuery> &statement, const Binding &binding,
+                      std::span<const QVariantList> columns, qsizetype width, qsizetype chunkSize) const;
+
+        /**
+         * @brief Executes a batch in chunks inside a Transaction on the table connection.
+         *
+         * @param name The name the executions are profiled with, see QueryProfiler.
+         * @param statement The statement to execute.
+         * @param rows The number of rows of the batch.
+         * @param chunkSize The maximum number of rows bound per execution.
+         * @param bind Binds the rows of a chunk given its offset and size.
          */
-        static void exec(const std::shared_ptr<QSqlQuery> &statement, const QMap<QString, QVariant> &columns);
+        void execChunks(const char *name, QSqlQuery &statement, qsizetype rows, qsizetype chunkSize,
+                        const std::function<void(qsizetype offset, qsizetype size)> &bind) const;
 
-        const QSqlDatabase         &m_database; ///< Reference to the database connection used by the table.
-        QString                     m_name; ///< Name of the table.
-        std::shared_ptr<SQLBuilder> m_builder; ///< SQLBuilder instance adapted to the QSqlDatabase::driverName().
+        const QSqlDatabase                       &m_database; ///< Database connection used by the table.
+        QString                                   m_name; ///< Name of the table.
+        TableSchema                               m_schema; ///< Columns of the table.
+        std::shared_ptr<const TableStatements>    m_sentences; ///< SQL of the table, shared by identical schemas.
         QMap<QString, std::shared_ptr<QSqlQuery>> m_statements; ///< Map of SQL statements prepared for this table.
-        QMap<QString, QString>                    m_sentences; ///< Map of raw SQL sentence strings for the table.
     };
 
 } // namespace core::db
@@ -34,6 +34,49 @@ namespace core::db
         return nullptr;
     }
 
+    std::shared_ptr<const TableStatements> Factory::statements(const QString &dbType, const QString &tableName,
+                                                               const TableSchema &schema)
+    {
+        const auto fingerprint = dbType + '\x1f' + tableName + schema.fingerprint();
+
+        auto &self = factory();
+        {
+            QMutexLocker locker(&self.m_mutex);
+            if (const auto it = self.m_statements.constFind(fingerprint); it != self.m_statements.cend())
+            {
+                return it.value();
+            }
+        }
+
+        // Generated outside the lock, a concurrent miss of the same schema keeps the first set
+        const auto sqlBuilder = builder(dbType);
+        sqlBuilder->setTableName(tableName);
+        sqlBuilder->setSchema(schema);
+        auto statements = std::make_shared<const TableStatements>(sqlBuilder->statements());
+
+        QMutexLocker locker(&self.m_mutex);
+        auto        &cached = self.m_statements[fingerprint];
+        if (!cached)
+        {
+            cached = std::move(statements);
+        }
+        return cached;
+    }
+
+    qsizetype Factory::cachedStatements()
+    {
+        auto        &self = factory();
+        QMutexLocker locker(&self.m_mutex);
+        return self.m_statements.size();
+    }
+
+    void Factory::clearStatements()
+    {
+        auto        &self = factory();
+        QMutexLocker locker(&self.m_mutex);
+        self.m_statements.clear();
+    }
+
     Factory::Factory() = default;
 
 } // namespace core::db
@@ -3,7 +3,8 @@
  * @brief Header file for the Factory class.
  *
  * This file declares the Factory class, a singleton responsible for providing access
- * to essential database components, such as the SQL builder.
+ * to essential database components, such as the SQL builder and the statements shared by
+ * the tables with the same definition.
  *
  * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
  * @author Manel Jimeno <manel.jimeno@gmail.com>
@@ -16,6 +17,8 @@
 #include "dynamic_table.h"
 #include "sql_builder.h"
 
+#include <QHash>
+#include <QMutex>
 #include <memory>
 
 namespace core::db
@@ -65,6 +68,32 @@ namespace core::db
          */
         [[nodiscard]] static std::shared_ptr<SQLBuilder> builder(const QString &dbType);
 
+        /**
+         * @brief Provides the statements of a table, generating them only for a new definition.
+         *
+         * The statements are cached by a fingerprint of the database type, the table name and the
+         * definition of every column, so the tables with the same schema share one immutable set
+         * and opening them again does not repeat the SQL generation.
+         *
+         * @param dbType The type of database (e.g., "QSQLITE").
+         * @param tableName The name of the table.
+         * @param schema The columns of the table.
+         * @return The shared statements of the table.
+         */
+        [[nodiscard]] static std::shared_ptr<const TableStatements>
+        statements(const QString &dbType, const QString &tableName, const TableSchema &schema);
+
+        /**
+         * @brief Retrieves the number of table definitions whose statements are cached.
+         * @return The number of cached statement sets.
+         */
+        [[nodiscard]] static qsizetype cachedStatements();
+
+        /**
+         * @brief Discards the cached statements, the tables already opened keep theirs.
+         */
+        static void clearStatements();
+
     private:
         /**
          * @brief Private constructor to prevent instantiating multiple instances.
@@ -73,6 +102,9 @@ namespace core::db
          * exists, following the Singleton design pattern.
          */
         Factory();
+
+        QMutex                                                 m_mutex; ///< Tables are opened from any thread.
+        QHash<QString, std::shared_ptr<const TableStatements>> m_statements; ///< Statements by schema fingerprint.
     };
 
 } // namespace core::db
@@ -0,0 +1,348 @@
+/**
+ * @file query_profiler.cpp
+ * @brief Implementation file for the QueryProfiler and ProfiledQuery classes.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "query_profiler.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QRandomGenerator>
+#include <QSqlRecord>
+#include <QStringList>
+#include <QVariant>
+#include <algorithm>
+
+namespace core::db
+{
+    std::atomic_bool QueryProfiler::s_enabled = false;
+
+    namespace
+    {
+        /**
+         * @brief Statistics of a statement and its latency reservoir.
+         */
+        struct Entry
+        {
+            QueryProfiler::Statistics statistics; ///< Counters of the statement.
+            QList<qint64>             samples; ///< Reservoir of execution times.
+            bool                      explained = false; ///< Whether the plan was captured or is being.
+        };
+
+        /**
+         * @brief Statistics of every statement.
+         */
+        struct Profiler
+        {
+            QMutex                mutex; ///< Statements are executed from any thread.
+            QHash<QString, Entry> entries; ///< Statistics by statement name.
+            std::atomic<qint64>   explainThreshold = 0; ///< Nanoseconds, 0 to never explain.
+        };
+
+        Profiler &profiler()
+        {
+            static Profiler self;
+            return self;
+        }
+
+        /**
+         * @brief Reads the steady clock.
+         */
+        qint64 now()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+        }
+
+        /**
+         * @brief Computes the percentiles of the reservoir of an entry.
+         */
+        QueryProfiler::Statistics snapshot(const Entry &entry)
+        {
+            auto statistics = entry.statistics;
+            auto samples    = entry.samples;
+            if (!samples.isEmpty())
+            {
+                std::sort(samples.begin(), samples.end());
+                const auto percentile = [&samples](const double rank)
+                { return samples[static_cast<qsizetype>(rank * static_cast<double>(samples.size() - 1))]; };
+                statistics.p50 = percentile(0.50);
+                statistics.p90 = percentile(0.90);
+                statistics.p99 = percentile(0.99);
+            }
+            return statistics;
+        }
+
+        /**
+         * @brief Runs EXPLAIN QUERY PLAN for a statement.
+         * @return The detail of every step of the plan, one per line.
+         */
+        QString explain(const QSqlDatabase &database, const QString &sql)
+        {
+            QSqlQuery query(database);
+            query.setForwardOnly(true);
+            // Unbound placeholders are NULL, which does not change the plan
+            if (!query.prepare("EXPLAIN QUERY PLAN " + sql) || !query.exec())
+            {
+                return {};
+            }
+            QStringList steps;
+            while (query.next())
+            {
+                steps.append(query.value(query.record().count() - 1).toString());
+            }
+            return steps.join('\n');
+        }
+
+        /**
+         * @brief Converts nanoseconds to microseconds.
+         */
+        double microseconds(const qint64 nanoseconds)
+        {
+            return static_cast<double>(nanoseconds) / 1000.0;
+        }
+
+        /**
+         * @brief Quotes a CSV field.
+         */
+        QString csvField(QString value)
+        {
+            return '"' + value.replace('"', "\"\"") + '"';
+        }
+    } // namespace
+
+    void QueryProfiler::enable(const std::chrono::microseconds explainThreshold)
+    {
+        profiler().explainThreshold.store(std::chrono::nanoseconds(explainThreshold).count());
+        s_enabled.store(true);
+    }
+
+    void QueryProfiler::disable()
+    {
+        s_enabled.store(false);
+    }
+
+    void QueryProfiler::record(const QSqlDatabase &database, const QString &name, const QSqlQuery &query,
+                               const qint64 bindTime, const qint64 execTime, const quint64 rows, const bool succeeded)
+    {
+        auto      &self      = profiler();
+        const auto threshold = self.explainThreshold.load(std::memory_order_relaxed);
+        bool       explainIt = false;
+        {
+            QMutexLocker locker(&self.mutex);
+            auto        &entry      = self.entries[name];
+            auto        &statistics = entry.statistics;
+            if (statistics.executions == 0)
+            {
+                statistics.name    = name;
+                statistics.sql     = query.lastQuery();
+                statistics.minTime = execTime;
+            }
+            statistics.executions++;
+            statistics.errors += succeeded ? 0 : 1;
+            statistics.rows += rows;
+            statistics.totalTime += execTime;
+            statistics.bindTime += bindTime;
+            statistics.minTime = std::min(statistics.minTime, execTime);
+            statistics.maxTime = std::max(statistics.maxTime, execTime);
+
+            // Reservoir sampling keeps every execution with the same probability
+            if (entry.samples.size() < SAMPLES)
+            {
+                entry.samples.append(execTime);
+            }
+            else if (const auto slot = static_cast<qsizetype>(
+                             QRandomGenerator::global()->bounded(static_cast<quint64>(statistics.executions)));
+                     slot < SAMPLES)
+            {
+                entry.samples[slot] = execTime;
+            }
+
+            if (succeeded && threshold > 0 && execTime > threshold && !entry.explained)
+            {
+                entry.explained = true;
+                explainIt       = true;
+            }
+        }
+
+        if (explainIt)
+        {
+            // Explained outside the lock, the plan of a statement is captured only once
+            const auto plan = explain(database, query.lastQuery());
+            QMutexLocker locker(&self.mutex);
+            self.entries[name].statistics.plan = plan;
+        }
+    }
+
+    void QueryProfiler::addRows(const QString &name, const quint64 rows)
+    {
+        if (!isEnabled())
+        {
+            return;
+        }
+        auto        &self = profiler();
+        QMutexLocker locker(&self.mutex);
+        if (const auto it = self.entries.find(name); it != self.entries.end())
+        {
+            it->statistics.rows += rows;
+        }
+    }
+
+    QueryProfiler::Statistics QueryProfiler::statistics(const QString &name)
+    {
+        auto        &self = profiler();
+        QMutexLocker locker(&self.mutex);
+        const auto   it = self.entries.constFind(name);
+        if (it == self.entries.cend())
+        {
+            Statistics statistics;
+            statistics.name = name;
+            return statistics;
+        }
+        return snapshot(*it);
+    }
+
+    QList<QueryProfiler::Statistics> QueryProfiler::statistics()
+    {
+        QList<Statistics> result;
+        {
+            auto        &self = profiler();
+            QMutexLocker locker(&self.mutex);
+            result.reserve(self.entries.size());
+            for (const auto &entry: self.entries)
+            {
+                result.append(snapshot(entry));
+            }
+        }
+        std::sort(result.begin(), result.end(),
+                  [](const Statistics &left, const Statistics &right) { return left.totalTime > right.totalTime; });
+        return result;
+    }
+
+    void QueryProfiler::clear()
+    {
+        auto        &self = profiler();
+        QMutexLocker locker(&self.mutex);
+        self.entries.clear();
+    }
+
+    QByteArray QueryProfiler::toJson()
+    {
+        QJsonArray array;
+        for (const auto &statistics: QueryProfiler::statistics())
+        {
+            const auto executions = std::max<quint64>(statistics.executions, 1);
+            array.append(QJsonObject{{"name", statistics.name},
+                                     {"sql", statistics.sql},
+                                     {"executions", static_cast<qint64>(statistics.executions)},
+                                     {"errors", static_cast<qint64>(statistics.errors)},
+                                     {"rows", static_cast<qint64>(statistics.rows)},
+                                     {"totalUs", microseconds(statistics.totalTime)},
+                                     {"meanUs", microseconds(statistics.totalTime) / static_cast<double>(executions)},
+                                     {"minUs", microseconds(statistics.minTime)},
+                                     {"p50Us", microseconds(statistics.p50)},
+                                     {"p90Us", microseconds(statistics.p90)},
+                                     {"p99Us", microseconds(statistics.p99)},
+                                     {"maxUs", microseconds(statistics.maxTime)},
+                                     {"bindUs", microseconds(statistics.bindTime)},
+                                     {"plan", statistics.plan}});
+        }
+        return QJsonDocument(array).toJson(QJsonDocument::Indented);
+    }
+
+    QByteArray QueryProfiler::toCsv()
+    {
+        QStringList lines{"name,executions,errors,rows,total_us,mean_us,min_us,p50_us,p90_us,p99_us,max_us,bind_us,sql,"
+                          "plan"};
+        for (const auto &statistics: QueryProfiler::statistics())
+        {
+            const auto executions = std::max<quint64>(statistics.executions, 1);
+            const auto mean       = microseconds(statistics.totalTime) / static_cast<double>(executions);
+            lines.append(QStringList{csvField(statistics.name), QString::number(statistics.executions),
+                                     QString::number(statistics.errors), QString::number(statistics.rows),
+                                     QString::number(microseconds(statistics.totalTime)), QString::number(mean),
+                                     QString::number(microseconds(statistics.minTime)),
+                                     QString::number(microseconds(statistics.p50)),
+                                     QString::number(microseconds(statistics.p90)),
+                                     QString::number(microseconds(statistics.p99)),
+                                     QString::number(microseconds(statistics.maxTime)),
+                                     QString::number(microseconds(statistics.bindTime)), csvField(statistics.sql),
+                                     csvField(statistics.plan)}
+                                 .join(','));
+        }
+        return (lines.join('\n') + '\n').toUtf8();
+    }
+
+    bool QueryProfiler::write(const QString &path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        const auto content = QFileInfo(path).suffix().compare("csv", Qt::CaseInsensitive) == 0 ? toCsv() : toJson();
+        return file.write(content) == content.size();
+    }
+
+    ProfiledQuery::ProfiledQuery(const QSqlDatabase &database, const char *name, const QString &detail) :
+        m_database(database), m_start(QueryProfiler::isEnabled() ? now() : -1)
+    {
+        if (m_start >= 0)
+        {
+            m_name = QString::fromLatin1(name);
+            if (!detail.isEmpty())
+            {
+                m_name += '[' + detail + ']';
+            }
+        }
+    }
+
+    bool ProfiledQuery::exec(QSqlQuery &query)
+    {
+        if (m_start < 0)
+        {
+            return query.exec();
+        }
+        const auto bound     = now();
+        const auto succeeded = query.exec();
+        const auto rows      = succeeded && !query.isSelect() ? std::max(query.numRowsAffected(), 0) : 0;
+        record(query, bound, static_cast<quint64>(rows), succeeded);
+        return succeeded;
+    }
+
+    bool ProfiledQuery::execBatch(QSqlQuery &query)
+    {
+        if (m_start < 0)
+        {
+            return query.execBatch();
+        }
+        const auto bound     = now();
+        const auto succeeded = query.execBatch();
+        const auto values    = query.boundValues();
+        const auto rows      = succeeded && !values.isEmpty() ? values.first().toList().size() : 0;
+        record(query, bound, static_cast<quint64>(rows), succeeded);
+        return succeeded;
+    }
+
+    const QString &ProfiledQuery::name() const
+    {
+        return m_name;
+    }
+
+    void ProfiledQuery::record(const QSqlQuery &query, const qint64 bound, const quint64 rows,
+                               const bool succeeded) const
+    {
+        QueryProfiler::record(m_database, m_name, query, bound - m_start, now() - bound, rows, succeeded);
+    }
+
+} // namespace core::db
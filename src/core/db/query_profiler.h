@@ -0,0 +1,213 @@
+/**
+ * @file query_profiler.h
+ * @brief Header file for the QueryProfiler and ProfiledQuery classes.
+ *
+ * This file declares an opt-in profiler of the statements executed by DynamicTable and the
+ * generated classes: executions, latency percentiles, rows and bind time by statement name,
+ * with the query plan of the statements slower than a threshold.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <atomic>
+#include <chrono>
+#include "dllexports.h"
+
+namespace core::db
+{
+
+    /**
+     * @class QueryProfiler
+     * @brief Process-wide statistics of the executed statements.
+     *
+     * The profiler is disabled by default, then profiling a statement only costs the relaxed
+     * load of a flag. Latencies are kept in a reservoir of SAMPLES executions per statement, so
+     * the percentiles use bounded memory however many times a statement runs.
+     */
+    class CORE_API QueryProfiler
+    {
+    public:
+        static constexpr qsizetype SAMPLES = 1024; ///< Latencies kept per statement for the percentiles.
+
+        /**
+         * @brief Statistics of a statement, times in nanoseconds.
+         */
+        struct Statistics
+        {
+            QString name; ///< Name of the statement, such as Users::findUserByEmail.
+            QString sql; ///< SQL of the statement.
+            quint64 executions = 0; ///< Successful and failed executions.
+            quint64 errors     = 0; ///< Failed executions.
+            quint64 rows       = 0; ///< Rows affected by the writes and fetched from the selects.
+            qint64  totalTime  = 0; ///< Sum of the execution times.
+            qint64  minTime    = 0; ///< Fastest execution.
+            qint64  maxTime    = 0; ///< Slowest execution.
+            qint64  bindTime   = 0; ///< Sum of the times spent binding the values.
+            qint64  p50        = 0; ///< Median execution time.
+            qint64  p90        = 0; ///< 90th percentile of the execution time.
+            qint64  p99        = 0; ///< 99th percentile of the execution time.
+            QString plan; ///< EXPLAIN QUERY PLAN of the first execution over the threshold.
+        };
+
+        /**
+         * @brief Starts profiling, the statistics already recorded are kept.
+         * @param explainThreshold Executions slower than this capture the query plan of their
+         * statement once, zero to never capture it.
+         */
+        static void enable(std::chrono::microseconds explainThreshold = std::chrono::microseconds::zero());
+
+        /**
+         * @brief Stops profiling.
+         */
+        static void disable();
+
+        /**
+         * @brief Checks whether the statements are profiled.
+         * @return true if the profiler is enabled.
+         */
+        [[nodiscard]] static bool isEnabled() noexcept
+        {
+            return s_enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Records an execution, ProfiledQuery calls it.
+         * @param database The connection of the statement, used to explain it.
+         * @param name The name of the statement.
+         * @param query The executed statement.
+         * @param bindTime Nanoseconds spent binding the values.
+         * @param execTime Nanoseconds spent executing.
+         * @param rows Rows affected, or 0 for the selects, which add the fetched ones with addRows().
+         * @param succeeded Whether the execution succeeded.
+         */
+        static void record(const QSqlDatabase &database, const QString &name, const QSqlQuery &query, qint64 bindTime,
+                           qint64 execTime, quint64 rows, bool succeeded);
+
+        /**
+         * @brief Adds the rows fetched from a select.
+         * @param name The name of the statement.
+         * @param rows The rows fetched.
+         */
+        static void addRows(const char *name, const quint64 rows)
+        {
+            if (isEnabled())
+            {
+                addRows(QString::fromLatin1(name), rows);
+            }
+        }
+
+        /**
+         * @brief Adds the rows fetched from a select.
+         * @param name The name of the statement.
+         * @param rows The rows fetched.
+         */
+        static void addRows(const QString &name, quint64 rows);
+
+        /**
+         * @brief Retrieves the statistics of a statement.
+         * @param name The name of the statement.
+         * @return The statistics, with no executions if the statement was not profiled.
+         */
+        [[nodiscard]] static Statistics statistics(const QString &name);
+
+        /**
+         * @brief Retrieves the statistics of every profiled statement.
+         * @return The statistics, the statements with the highest total time first.
+         */
+        [[nodiscard]] static QList<Statistics> statistics();
+
+        /**
+         * @brief Discards the recorded statistics.
+         */
+        static void clear();
+
+        /**
+         * @brief Serializes the statistics as a JSON array, times in microseconds.
+         * @return The JSON document.
+         */
+        [[nodiscard]] static QByteArray toJson();
+
+        /**
+         * @brief Serializes the statistics as CSV with a header row, times in microseconds.
+         * @return The CSV text.
+         */
+        [[nodiscard]] static QByteArray toCsv();
+
+        /**
+         * @brief Writes the statistics to a file, as CSV if its suffix is csv and as JSON otherwise.
+         * @param path The file path.
+         * @return true if the file was written.
+         */
+        static bool write(const QString &path);
+
+    private:
+        static std::atomic_bool s_enabled; ///< Whether the statements are profiled.
+    };
+
+    /**
+     * @class ProfiledQuery
+     * @brief Times the binding and the execution of a statement for the QueryProfiler.
+     *
+     * Construct it right before binding the values and execute the statement through it.
+     * Whether it profiles is decided when it is constructed.
+     */
+    class CORE_API ProfiledQuery
+    {
+    public:
+        /**
+         * @brief Starts timing the binding of a statement.
+         * @param database The connection of the statement.
+         * @param name The name of the statement, a string literal.
+         * @param detail Optional qualifier of the name, such as the table of a DynamicTable.
+         */
+        ProfiledQuery(const QSqlDatabase &database, const char *name, const QString &detail = {});
+
+        ProfiledQuery(const ProfiledQuery &)            = delete;
+        ProfiledQuery &operator=(const ProfiledQuery &) = delete;
+
+        /**
+         * @brief Executes the statement.
+         * @param query The prepared statement with its values bound.
+         * @return The result of QSqlQuery::exec().
+         */
+        bool exec(QSqlQuery &query);
+
+        /**
+         * @brief Executes the statement with lists of values bound.
+         * @param query The prepared statement with its value lists bound.
+         * @return The result of QSqlQuery::execBatch().
+         */
+        bool execBatch(QSqlQuery &query);
+
+        /**
+         * @brief Retrieves the name the execution is recorded with.
+         * @return The name, empty if the profiler was disabled when this object was constructed.
+         */
+        [[nodiscard]] const QString &name() const;
+
+    private:
+        /**
+         * @brief Records an execution.
+         * @param query The executed statement.
+         * @param bound Time when the binding ended.
+         * @param rows Rows affected.
+         * @param succeeded Whether the execution succeeded.
+         */
+        void record(const QSqlQuery &query, qint64 bound, quint64 rows, bool succeeded) const;
+
+        const QSqlDatabase &m_database; ///< Connection of the statement.
+        QString             m_name; ///< Name of the statement, empty while not profiling.
+        qint64              m_start; ///< Start of the binding, negative while not profiling.
+    };
+
+} // namespace core::db
@@ -13,10 +13,73 @@
 
 namespace core::db
 {
+    namespace
+    {
+        /**
+         * @brief Finds the distinct named placeholders of a statement, skipping the quoted literals.
+         */
+        QStringList placeholders(const QString &sql)
+        {
+            QStringList names;
+            QChar       quote;
+            for (qsizetype i = 0; i < sql.size(); i++)
+            {
+                const auto character = sql[i];
+                if (!quote.isNull())
+                {
+                    quote = character == quote ? QChar() : quote;
+                }
+                else if (character == '\'' || character == '"')
+                {
+                    quote = character;
+                }
+                else if (character == ':')
+                {
+                    auto end = i + 1;
+                    while (end < sql.size() && (sql[end].isLetterOrNumber() || sql[end] == '_'))
+                    {
+                        end++;
+                    }
+                    if (const auto name = sql.mid(i, end - i); end > i + 1 && !names.contains(name))
+                    {
+                        names << name;
+                    }
+                    i = end - 1;
+                }
+            }
+            return names;
+        }
+
+        /**
+         * @brief Resolves the placeholders of a statement to the position of their column in a row.
+         */
+        Binding resolve(const QString &sql, const QVector<QString> &columns)
+        {
+            Binding binding;
+            for (const auto &name: placeholders(sql))
+            {
+                binding.append({name, columns.indexOf(name.mid(1))});
+            }
+            return binding;
+        }
+    } // namespace
+
+    void SQLBuilder::addColumn(const std::shared_ptr<Column> &column)
+    {
+        column->addTo(m_schema);
+        m_revision++;
+    }
+
+    void SQLBuilder::addIndex(TableIndex index)
+    {
+        m_schema.addIndex(std::move(index));
+        m_revision++;
+    }
 
-    void SQLBuilder::addColumn(std::shared_ptr<Column> column)
+    void SQLBuilder::setSchema(TableSchema schema)
     {
-        m_columns.push_back(std::move(column));
+        m_schema = std::move(schema);
+        m_revision++;
     }
 
     void SQLBuilder::setTableName(QString tableName)
@@ -29,9 +92,74 @@ namespace core::db
         return m_tableName;
     }
 
-    const QVector<std::shared_ptr<Column>> &SQLBuilder::columns() const
+    const TableSchema &SQLBuilder::schema() const
+    {
+        return m_schema;
+    }
+
+    TableStatements SQLBuilder::statements() const
+    {
+        TableStatements statements{createTable(),  createIndexes(), createInsert(), createUpdate(),
+                                   createUpsert(), createDelete(),  createSelect(), createSelectPk(),
+                                   createSelectCount()};
+        statements.insertBinding = resolve(statements.insert, m_schema.names());
+        statements.updateBinding = resolve(statements.update, m_schema.names());
+        statements.upsertBinding = resolve(statements.upsert, m_schema.names());
+        // The key rows hold the key columns in the order of the WHERE clause
+        auto keys = placeholders(statements.remove);
+        for (auto &key: keys)
+        {
+            key.remove(0, 1);
+        }
+        statements.keyBinding = resolve(statements.remove, keys);
+
+        // One pagination by primary key, the empty index name, and one per index
+        QStringList indexes{QString()};
+        for (qsizetype column = 0; column < m_schema.size(); column++)
+        {
+            const auto &index = m_schema.attribute(column, TableSchema::Attribute::Index);
+            if (!index.isEmpty() && !indexes.contains(index))
+            {
+                indexes << index;
+            }
+        }
+        for (const auto &index: m_schema.indexes())
+        {
+            if (!indexes.contains(index.name))
+            {
+                indexes << index.name;
+            }
+        }
+        for (const auto &index: indexes)
+        {
+            const auto key = pageKey(index);
+            if (key.isEmpty())
+            {
+                continue;
+            }
+            const auto     where = pageWhere(index);
+            PageStatements page{key, createSelectPage(key, false, where), createSelectPage(key, true, where), {}};
+            for (qsizetype column = 0; column < key.size(); column++)
+            {
+                page.afterBinding.append({AFTER + key[column], column});
+            }
+            statements.pages.insert(index, std::move(page));
+        }
+        return statements;
+    }
+
+    QString SQLBuilder::pageWhere(const QString &index, const QString &where) const
     {
-        return m_columns;
+        const auto *declared = index.isEmpty() ? nullptr : m_schema.findIndex(index);
+        if (declared == nullptr || declared->where.isEmpty())
+        {
+            return where;
+        }
+        if (where.isEmpty())
+        {
+            return declared->where;
+        }
+        return "(" + where + ") AND (" + declared->where + ")";
     }
 
     SQLBuilder::SQLBuilder(QString dbType) : m_dbTypeName(std::move(dbType))
@@ -15,14 +15,70 @@
 
 #pragma once
 
+#include <QHash>
 #include <QJsonObject>
+#include <QStringList>
 #include <QVector>
 #include <memory>
 #include "column.h"
+#include "table_schema.h"
 
 namespace core::db
 {
 
+    /**
+     * @struct Placeholder
+     * @brief A placeholder of a statement and the value of a row bound to it.
+     */
+    struct Placeholder
+    {
+        QString   name; ///< Placeholder as written in the statement, such as :name.
+        qsizetype column; ///< Position of the bound value in the row.
+    };
+
+    using Binding = QVector<Placeholder>; ///< The distinct placeholders of a statement, in order of appearance.
+
+    /**
+     * @struct PageStatements
+     * @brief The SELECT statements of a keyset pagination.
+     *
+     * The pages are ordered by the key columns and each page starts after the key of the last row
+     * of the previous one, so fetching a page costs the same whatever its position instead of
+     * skipping the previous rows as OFFSET does.
+     */
+    struct PageStatements
+    {
+        QStringList key; ///< Columns the pages are ordered by.
+        QString     first; ///< SELECT statement of the first page.
+        QString     next; ///< SELECT statement of the page after a key.
+        Binding     afterBinding; ///< Placeholders of next, bound from the key columns.
+    };
+
+    /**
+     * @struct TableStatements
+     * @brief The SQL statements generated for a table.
+     *
+     * Built once by SQLBuilder::statements() and shared, immutable, by every table with the same
+     * definition, see Factory::statements().
+     */
+    struct TableStatements
+    {
+        QString                        create; ///< CREATE TABLE statement.
+        QVector<QString>               indexes; ///< CREATE INDEX statements.
+        QString                        insert; ///< INSERT statement.
+        QString                        update; ///< UPDATE statement filtered by primary key.
+        QString                        upsert; ///< INSERT ... ON CONFLICT statement.
+        QString                        remove; ///< DELETE statement filtered by primary key.
+        QString                        select; ///< SELECT statement of every row.
+        QString                        selectPk; ///< SELECT statement filtered by primary key.
+        QString                        selectCount; ///< SELECT COUNT statement.
+        Binding                        insertBinding; ///< Placeholders of insert, bound from the columns of the schema.
+        Binding                        updateBinding; ///< Placeholders of update, bound from the columns of the schema.
+        Binding                        upsertBinding; ///< Placeholders of upsert, bound from the columns of the schema.
+        Binding                        keyBinding; ///< Placeholders of remove and selectPk, bound from the key columns.
+        QHash<QString, PageStatements> pages; ///< Keyset paginations by index name, empty for the primary key.
+    };
+
     /**
      * @class SQLBuilder
      * @brief Generates SQL statements based on the provided table structure and database type.
@@ -35,6 +91,9 @@ namespace core::db
     class CORE_API SQLBuilder
     {
     public:
+        static constexpr auto PAGE_SIZE = ":page_size"; ///< Placeholder of the number of rows of a page.
+        static constexpr auto AFTER     = ":after_"; ///< Prefix of the placeholders of the key a page starts after.
+
         /**
          * @brief Destructor for SQLBuilder.
          *
@@ -45,12 +104,28 @@ namespace core::db
         /**
          * @brief Adds a column to the table definition.
          *
-         * Adds a new column to the internal list of columns that will be included in the
-         * generated SQL statements (e.g., CREATE TABLE, INSERT).
+         * Appends the column to the schema of the table, see Column::addTo(), to be included in
+         * the generated SQL statements (e.g., CREATE TABLE, INSERT).
          *
          * @param column A shared pointer to a Column object representing the new column.
          */
-        void addColumn(std::shared_ptr<Column> column);
+        void addColumn(const std::shared_ptr<Column> &column);
+
+        /**
+         * @brief Adds an index declared apart from the columns to the table definition.
+         *
+         * The index is created by createIndexes() after the indexes named by the columns.
+         *
+         * @param index The index, whose terms and covering columns are not validated.
+         */
+        void addIndex(TableIndex index);
+
+        /**
+         * @brief Replaces the columns of the table definition.
+         *
+         * @param schema The flat schema of the columns.
+         */
+        void setSchema(TableSchema schema);
 
         /**
          * @brief Sets the name of the table.
@@ -71,25 +146,11 @@ namespace core::db
         [[nodiscard]] QString name() const;
 
         /**
-         * @brief Retrieves the list of columns in the table.
-         *
-         * Returns a constant reference to the list of columns in the table, where each column
-         * is represented as a shared pointer to a Column object.
-         *
-         * @return A const reference to a QVector of shared pointers to Column objects.
-         */
-        [[nodiscard]] const QVector<std::shared_ptr<Column>> &columns() const;
-
-        /**
-         * @brief Finds a column by name within a vector of Column shared pointers.
-         *
-         * Searches through the list of columns to find a column by its name and returns
-         * a shared pointer to the matching column, if found.
+         * @brief Retrieves the columns of the table.
          *
-         * @param columnName The name of the column to search for.
-         * @return An optional containing a shared pointer to the Column if found; otherwise, std::nullopt.
+         * @return A const reference to the flat schema of the columns.
          */
-        [[nodiscard]] virtual std::optional<std::shared_ptr<core::db::Column>> column(const QString &columnName) = 0;
+        [[nodiscard]] const TableSchema &schema() const;
 
         /**
          * @brief Generates a CREATE TABLE statement for the given table.
@@ -105,7 +166,7 @@ namespace core::db
          * @brief Generates SQL statements to create indices for the table, if any.
          *
          * Returns a list of SQL statements to create indices on the table columns if any
-         * are defined.
+         * are defined, followed by the indexes added with addIndex().
          *
          * @return A QVector of SQL statements (each as a QString) to create indices.
          */
@@ -130,6 +191,16 @@ namespace core::db
          */
         [[nodiscard]] virtual QString createUpdate() const = 0;
 
+        /**
+         * @brief Creates the SQL UPSERT statement for the table.
+         *
+         * Generates an SQL INSERT statement that updates the row instead when its primary key
+         * already exists.
+         *
+         * @return The generated UPSERT statement as a QString.
+         */
+        [[nodiscard]] virtual QString createUpsert() const = 0;
+
         /**
          * @brief Creates the SQL SELECT statement for the table.
          *
@@ -167,6 +238,45 @@ namespace core::db
          */
         [[nodiscard]] virtual QString createDelete() const = 0;
 
+        /**
+         * @brief Retrieves the columns a keyset pagination is ordered by.
+         *
+         * The columns of the index followed by the primary key columns that are not part of it,
+         * which makes the key of every row unique. The rows with NULL in a key column come first.
+         *
+         * @param index The name of the index, empty to order by the primary key. An index added with
+         * addIndex() only orders pages if its terms are ascending columns.
+         * @return The key columns, empty if the table has no such index or no primary key.
+         */
+        [[nodiscard]] virtual QStringList pageKey(const QString &index = {}) const = 0;
+
+        /**
+         * @brief Creates the SQL SELECT statement of a page of a keyset pagination.
+         *
+         * The rows are ordered by the key columns and limited to PAGE_SIZE rows. The statement of
+         * the following pages only returns the rows after the key bound to the AFTER placeholders,
+         * one per key column.
+         *
+         * @param key The columns the pages are ordered by, see pageKey().
+         * @param after false for the first page, true for the pages after a key.
+         * @param where Optional condition of the rows, as written after WHERE.
+         * @return The generated SELECT statement as a QString.
+         */
+        [[nodiscard]] virtual QString createSelectPage(const QStringList &key, bool after,
+                                                       const QString &where = {}) const = 0;
+
+        /**
+         * @brief Retrieves the condition of the rows of the pages ordered by an index.
+         *
+         * The rows left out of a partial index must also be left out of its pages, so its
+         * condition is added to the given one.
+         *
+         * @param index The name of the index, empty to order by the primary key.
+         * @param where Optional condition of the rows, as written after WHERE.
+         * @return The condition to pass to createSelectPage(), empty if there is none.
+         */
+        [[nodiscard]] QString pageWhere(const QString &index, const QString &where = {}) const;
+
         /**
          * @brief Creates the SQL WHERE clause for the table.
          *
@@ -177,6 +287,16 @@ namespace core::db
          */
         [[nodiscard]] virtual QString whereClause() const = 0;
 
+        /**
+         * @brief Generates every statement of the table.
+         *
+         * Also resolves the placeholders of the statements that bind rows, so the values of a row
+         * are bound by position without looking up the column of each placeholder again.
+         *
+         * @return The statements, as returned by the create methods.
+         */
+        [[nodiscard]] TableStatements statements() const;
+
         /**
          * @brief Retrieves the header name of the parent class.
          *
@@ -202,9 +322,10 @@ namespace core::db
          */
         explicit SQLBuilder(QString dbType);
 
-        QString                          m_dbTypeName; ///< Name of the database type (e.g., "QSQLITE").
-        QString                          m_tableName; ///< Name of the table for which SQL will be generated.
-        QVector<std::shared_ptr<Column>> m_columns; ///< List of columns in the table.
+        QString     m_dbTypeName; ///< Name of the database type (e.g., "QSQLITE").
+        QString     m_tableName; ///< Name of the table for which SQL will be generated.
+        TableSchema m_schema; ///< Columns of the table.
+        quint64     m_revision = 0; ///< Incremented whenever the columns change.
     };
 
 } // namespace core::db
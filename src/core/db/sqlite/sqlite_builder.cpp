@@ -11,143 +11,179 @@
 #include "db/factory.h"
 
 #include <QtCore/QJsonArray>
+#include <array>
+#include <map>
 
 namespace core::db
 {
+    namespace
+    {
+        /**
+         * @brief Retrieves the value written to a column, its default value or its placeholder.
+         */
+        QString valueOf(const TableSchema &schema, const qsizetype column)
+        {
+            if (schema.hasAttribute(column, TableSchema::Attribute::Default))
+            {
+                return schema.attribute(column, TableSchema::Attribute::Default);
+            }
+            return ":" + schema.name(column);
+        }
+    } // namespace
 
-    std::optional<std::shared_ptr<core::db::Column>> SQLiteBuilder::column(const QString &columnName)
+    QString SQLiteBuilder::columnDefinition(const TableSchema &schema, const qsizetype column)
     {
-        for (const auto &column: m_columns)
+        using Attribute = TableSchema::Attribute;
+
+        static const std::array<std::pair<SQLiteModifier, const char *>, 4> modifiers = {
+                {{SQLiteModifier::isNotNull, " NOT NULL"},
+                 {SQLiteModifier::isPrimaryKey, " PRIMARY KEY"},
+                 {SQLiteModifier::isAutoIncrement, " AUTOINCREMENT"},
+                 {SQLiteModifier::isUnique, " UNIQUE"}}};
+
+        QString definition = schema.name(column) + " " + schema.dataType(column);
+        for (const auto &[modifier, clause]: modifiers)
         {
-            if (column && column->columnName() == columnName)
+            if (schema.hasModifier(column, modifier))
             {
-                return column;
+                definition += clause;
             }
         }
-        return std::nullopt;
+        if (schema.hasAttribute(column, Attribute::Check))
+        {
+            definition += " CHECK(" + schema.attribute(column, Attribute::Check) + ")";
+        }
+        if (schema.hasAttribute(column, Attribute::Default))
+        {
+            definition += " DEFAULT " + schema.attribute(column, Attribute::Default);
+        }
+        if (schema.hasAttribute(column, Attribute::Collate))
+        {
+            definition += " COLLATE " + schema.attribute(column, Attribute::Collate);
+        }
+        return definition;
     }
 
     QString SQLiteBuilder::createTable() const
     {
-        QString foreignKeyClause;
-        QString query = "CREATE TABLE IF NOT EXISTS " + name() + " ( ";
-        for (auto it = m_columns.begin(); it != m_columns.end(); ++it)
+        QStringList definitions;
+        QStringList foreignKeys;
+        for (qsizetype column = 0; column < m_schema.size(); column++)
         {
-            query += (*it)->columnDefinition();
-            if (std::next(it) != m_columns.end())
+            definitions << columnDefinition(m_schema, column);
+            if (m_schema.hasAttribute(column, TableSchema::Attribute::ForeignKey))
             {
-                query += ", ";
-            }
-            if ((*it)->foreignKey().has_value())
-            {
-                if (!foreignKeyClause.isEmpty())
-                {
-                    foreignKeyClause += ", ";
-                }
-                foreignKeyClause +=
-                        QString("FOREIGN KEY (%1) REFERENCES %2").arg((*it)->columnName(), (*it)->foreignKey().value());
+                foreignKeys << QString("FOREIGN KEY (%1) REFERENCES %2")
+                                       .arg(m_schema.name(column),
+                                            m_schema.attribute(column, TableSchema::Attribute::ForeignKey));
             }
         }
-        if (!foreignKeyClause.isEmpty())
-        {
-            query += ", " + foreignKeyClause;
-        }
-        query += " );";
-        return query;
+        definitions << foreignKeys;
+        return "CREATE TABLE IF NOT EXISTS " + name() + " ( " + definitions.join(", ") + " );";
     }
 
     QVector<QString> SQLiteBuilder::createIndexes() const
     {
-        QVector<QString>                    queries;
-        std::map<QString, QVector<QString>> indexes;
-        for (const auto &column: m_columns)
+        QVector<QString>               queries;
+        std::map<QString, QStringList> indexes;
+        for (qsizetype column = 0; column < m_schema.size(); column++)
         {
-            if (column->indexName().has_value())
+            if (m_schema.hasAttribute(column, TableSchema::Attribute::Index))
             {
-                indexes[column->indexName().value()].push_back(column->columnName());
+                indexes[m_schema.attribute(column, TableSchema::Attribute::Index)].append(m_schema.name(column));
             }
         }
 
         for (const auto &[indexName, fields]: indexes)
         {
-            QString query = "CREATE INDEX IF NOT EXISTS " + indexName + " ON " + m_tableName.toLower() + "(";
-            for (auto it = fields.begin(); it != fields.end(); ++it)
+            queries.append("CREATE INDEX IF NOT EXISTS " + indexName + " ON " + m_tableName.toLower() + "(" +
+                           fields.join(", ") + ");");
+        }
+
+        for (const auto &index: m_schema.indexes())
+        {
+            QStringList terms;
+            for (const auto &term: index.terms)
             {
-                query += (*it);
-                if (std::next(it) != fields.end())
+                terms << (term.descending ? term.expression + " DESC" : term.expression);
+            }
+            // The covering columns already in the key add nothing to the index
+            for (const auto &column: index.include)
+            {
+                if (!terms.contains(column))
                 {
-                    query += ", ";
+                    terms << column;
                 }
             }
-            query += ");";
-            queries.append(query);
+            auto query = QString(index.unique ? "CREATE UNIQUE INDEX" : "CREATE INDEX") + " IF NOT EXISTS " +
+                         index.name + " ON " + m_tableName.toLower() + "(" + terms.join(", ") + ")";
+            if (!index.where.isEmpty())
+            {
+                query += " WHERE " + index.where;
+            }
+            queries.append(query + ";");
         }
         return queries;
     }
 
     QString SQLiteBuilder::createInsert() const
     {
-        QString     query = "INSERT INTO " + m_tableName + " (";
         QStringList columnsList;
         QStringList valuesList;
-        for (const auto &item: m_columns)
+        for (const auto column: partitions().values)
         {
-            auto column = std::dynamic_pointer_cast<SQLiteColumn>(item);
-            if (!column->hasModifier(SQLiteModifier::isAutoIncrement))
-            {
-                columnsList << column->columnName();
-                if (column->defaultValue() != std::nullopt)
-                {
-                    valuesList << column->defaultValue().value();
-                }
-                else
-                {
-                    valuesList << ":" + column->columnName();
-                }
-            }
+            columnsList << m_schema.name(column);
+            valuesList << valueOf(m_schema, column);
         }
-        query += columnsList.join(", ") + ") VALUES (" + valuesList.join(", ") + ");";
-        return query;
+        return "INSERT INTO " + m_tableName + " (" + columnsList.join(", ") + ") VALUES (" + valuesList.join(", ") +
+               ");";
     }
 
     QString SQLiteBuilder::createUpdate() const
     {
-        QString     query = "UPDATE " + m_tableName + " SET ";
         QStringList setList;
-        QStringList whereList;
-        for (const auto &item: m_columns)
+        for (const auto column: partitions().values)
         {
-            auto column = std::dynamic_pointer_cast<SQLiteColumn>(item);
-            if (!column->hasModifier(SQLiteModifier::isAutoIncrement))
+            // The immutable columns, such as the creation stamps, keep the value of the insert
+            if (!m_schema.hasModifier(column, SQLiteModifier::isImmutable))
             {
-                if (column->defaultValue() != std::nullopt)
-                {
-                    setList << column->columnName() + "=" + column->defaultValue().value();
-                }
-                else
-                {
-                    setList << column->columnName() + "=:" + column->columnName();
-                }
+                setList << m_schema.name(column) + "=" + valueOf(m_schema, column);
             }
-            if (column->indexName() != std::nullopt)
+        }
+        return "UPDATE " + m_tableName + " SET " + setList.join(", ") + partitions().where + ";";
+    }
+
+    QString SQLiteBuilder::createUpsert() const
+    {
+        const auto &keys  = partitions().primaryKeys;
+        auto        query = createInsert();
+        if (keys.empty())
+        {
+            return query;
+        }
+
+        QStringList setList;
+        for (const auto column: partitions().values)
+        {
+            if (!m_schema.hasModifier(column, SQLiteModifier::isPrimaryKey | SQLiteModifier::isImmutable))
             {
-                whereList << column->columnName() + "=:" + column->columnName();
+                setList << m_schema.name(column) + "=excluded." + m_schema.name(column);
             }
         }
-        query += setList.join(", ");
-        query += whereClause() + ";";
-
+        query.chop(1);
+        query += " ON CONFLICT(" + keys.join(", ") + ")";
+        query += setList.empty() ? " DO NOTHING;" : " DO UPDATE SET " + setList.join(", ") + ";";
         return query;
     }
 
     QString SQLiteBuilder::createDelete() const
     {
-        return "DELETE FROM " + m_tableName + whereClause() + ";";
+        return "DELETE FROM " + m_tableName + partitions().where + ";";
     }
 
     QString SQLiteBuilder::createSelectPk() const
     {
-        return createSelect() + whereClause() + ";";
+        return createSelect() + partitions().where + ";";
     }
 
     QString SQLiteBuilder::createSelectCount() const
@@ -160,35 +196,110 @@ namespace core::db
         return "SELECT * FROM " + m_tableName;
     }
 
-    QString SQLiteBuilder::whereClause() const
+    QStringList SQLiteBuilder::pageKey(const QString &index) const
     {
-        QStringList whereList;
-
-        for (const auto &item: m_columns)
+        // Without a primary key the rows may share their key and a page would skip them
+        QStringList key;
+        if (partitions().primaryKeys.empty())
         {
-            auto column = std::dynamic_pointer_cast<SQLiteColumn>(item);
-            if (column->hasModifier(SQLiteModifier::isPrimaryKey))
+            return key;
+        }
+        if (!index.isEmpty())
+        {
+            for (qsizetype column = 0; column < m_schema.size(); column++)
+            {
+                if (m_schema.attribute(column, TableSchema::Attribute::Index) == index)
+                {
+                    key << m_schema.name(column);
+                }
+            }
+            if (const auto *declared = m_schema.findIndex(index); key.empty() && declared != nullptr)
+            {
+                // The row value comparison of the pages only follows ascending columns
+                for (const auto &term: declared->terms)
+                {
+                    if (term.descending || !m_schema.indexOf(term.expression).has_value())
+                    {
+                        return {};
+                    }
+                    key << term.expression;
+                }
+            }
+            if (key.empty())
+            {
+                return key;
+            }
+        }
+        for (const auto &primaryKey: partitions().primaryKeys)
+        {
+            if (!key.contains(primaryKey))
             {
-                whereList << column->columnName() + "=:" + column->columnName();
+                key << primaryKey;
             }
         }
-        if (whereList.empty())
+        return key;
+    }
+
+    bool SQLiteBuilder::isNullable(const QString &column) const
+    {
+        const auto position = m_schema.indexOf(column);
+        return position.has_value() && !m_schema.hasModifier(*position, SQLiteModifier::isNotNull) &&
+               !m_schema.hasModifier(*position, SQLiteModifier::isPrimaryKey);
+    }
+
+    QString SQLiteBuilder::createSelectPage(const QStringList &key, const bool after, const QString &where) const
+    {
+        QStringList conditions;
+        if (!where.isEmpty())
         {
-            for (const auto &column: m_columns)
+            conditions << (after ? "(" + where + ")" : where);
+        }
+        if (after)
+        {
+            QStringList placeholders;
+            bool        nullable = false;
+            for (const auto &column: key)
+            {
+                placeholders << AFTER + column;
+                nullable = nullable || isNullable(column);
+            }
+            if (!nullable)
+            {
+                conditions << (key.size() == 1 ? key.front() + " > " + placeholders.front()
+                                               : "(" + key.join(", ") + ") > (" + placeholders.join(", ") + ")");
+            }
+            else
             {
-                if (column->indexName().has_value())
+                // A comparison with NULL is never true, and NULL sorts first, so a page ending on a NULL
+                // is followed by the rows sharing the key up to a column and after it in that column
+                QStringList alternatives;
+                QStringList equal;
+                for (qsizetype column = 0; column < key.size(); column++)
                 {
-                    whereList << column->columnName() + "=:" + column->columnName();
+                    const auto &name        = key[column];
+                    const auto &placeholder = placeholders[column];
+                    auto        greater     = name + " > " + placeholder;
+                    if (isNullable(name))
+                    {
+                        greater = "(" + greater + " OR (" + placeholder + " IS NULL AND " + name + " IS NOT NULL))";
+                    }
+                    alternatives << (equal.empty() ? greater : equal.join(" AND ") + " AND " + greater);
+                    equal << name + (isNullable(name) ? " IS " : " = ") + placeholder;
                 }
+                conditions << "(" + alternatives.join(" OR ") + ")";
             }
         }
-
-        if (!whereList.empty())
+        auto query = createSelect();
+        if (!conditions.empty())
         {
-            return " WHERE " + whereList.join(" and ");
+            query += " WHERE " + conditions.join(" AND ");
         }
+        return query + " ORDER BY " + key.join(", ") + " LIMIT " + PAGE_SIZE + ";";
+    }
 
-        return {};
+    QString SQLiteBuilder::whereClause() const
+    {
+        return partitions().where;
     }
 
     QString SQLiteBuilder::headerParentClass() const
@@ -201,4 +312,44 @@ namespace core::db
         return "core::db::SQLiteDbApi";
     }
 
+    const SQLiteBuilder::Partitions &SQLiteBuilder::partitions() const
+    {
+        if (m_partitions.revision == m_revision)
+        {
+            return m_partitions;
+        }
+
+        Partitions  partitions;
+        QStringList indexed;
+        for (qsizetype column = 0; column < m_schema.size(); column++)
+        {
+            if (m_schema.hasModifier(column, SQLiteModifier::isPrimaryKey))
+            {
+                partitions.primaryKeys << m_schema.name(column);
+            }
+            if (!m_schema.hasModifier(column, SQLiteModifier::isAutoIncrement))
+            {
+                partitions.values.append(column);
+            }
+            if (m_schema.hasAttribute(column, TableSchema::Attribute::Index))
+            {
+                indexed << m_schema.name(column);
+            }
+        }
+
+        // Without a primary key the rows are located by their indexed columns
+        QStringList whereList;
+        for (const auto &columnName: partitions.primaryKeys.empty() ? indexed : partitions.primaryKeys)
+        {
+            whereList << columnName + "=:" + columnName;
+        }
+        if (!whereList.empty())
+        {
+            partitions.where = " WHERE " + whereList.join(" and ");
+        }
+        partitions.revision = m_revision;
+        m_partitions        = std::move(partitions);
+        return m_partitions;
+    }
+
 } // namespace core::db
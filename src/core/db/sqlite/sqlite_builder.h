@@ -40,16 +40,15 @@ namespace core::db
         SQLiteBuilder() : SQLBuilder(DBManager::QSQLITE) {};
 
         /**
-         * @brief Finds a column by name within a vector of Column shared pointers.
+         * @brief Generates the SQL definition of a column of a schema.
          *
-         * Searches through the vector of columns and returns a shared pointer to
-         * the column with the specified name, if it exists.
+         * The name and type of the column followed by its constraints, as written in CREATE TABLE.
          *
-         * @param columnName The name of the column to search for.
-         * @return std::optional<std::shared_ptr<core::db::Column>> The shared pointer to the Column if found;
-         * otherwise, std::nullopt.
+         * @param schema The schema of the table.
+         * @param column The position of the column.
+         * @return QString The definition of the column.
          */
-        [[nodiscard]] std::optional<std::shared_ptr<core::db::Column>> column(const QString &columnName) override;
+        [[nodiscard]] static QString columnDefinition(const TableSchema &schema, qsizetype column);
 
         /**
          * @brief Generates a SQL CREATE TABLE statement.
@@ -64,8 +63,10 @@ namespace core::db
         /**
          * @brief Generates SQL statements to create indices for columns.
          *
-         * Creates a set of SQL statements to create indexes for columns that have index names defined.
-         * These statements are returned as a vector of individual SQL commands.
+         * Creates a set of SQL statements to create indexes for columns that have index names defined,
+         * followed by one per index declared apart from the columns, as CREATE UNIQUE INDEX if unique,
+         * with its terms in order, the covering columns after them and the WHERE clause of a partial
+         * index. These statements are returned as a vector of individual SQL commands.
          *
          * @return QVector<QString> A vector of SQL statements, each creating an index.
          */
@@ -91,6 +92,17 @@ namespace core::db
          */
         [[nodiscard]] QString createUpdate() const override;
 
+        /**
+         * @brief Generates the SQL UPSERT statement for inserting or updating a row.
+         *
+         * Same as createInsert() followed by an ON CONFLICT clause on the primary key columns
+         * that updates the remaining columns with the excluded values. Without a primary key the
+         * statement is a plain INSERT.
+         *
+         * @return QString A SQL query to insert or update data in the table.
+         */
+        [[nodiscard]] QString createUpsert() const override;
+
         /**
          * @brief Generates the SQL SELECT statement to retrieve all rows.
          *
@@ -131,6 +143,32 @@ namespace core::db
          */
         [[nodiscard]] QString createDelete() const override;
 
+        /**
+         * @brief Retrieves the columns a keyset pagination is ordered by.
+         *
+         * The columns of the index, in table order, or the terms of an index declared apart from the
+         * columns if they are ascending columns, followed by the primary key columns.
+         *
+         * @param index The name of the index, empty to order by the primary key.
+         * @return QStringList The key columns, empty if there is no such index or no primary key.
+         */
+        [[nodiscard]] QStringList pageKey(const QString &index = {}) const override;
+
+        /**
+         * @brief Generates the SQL SELECT statement of a page of a keyset pagination.
+         *
+         * The key is compared as a row value, (a, b) > (:after_a, :after_b), which SQLite resolves
+         * with a range scan of the index the key starts with. A row value comparison with a NULL is
+         * never true, so a key with nullable columns is compared column by column, NULL first.
+         *
+         * @param key The columns the pages are ordered by.
+         * @param after false for the first page, true for the pages after a key.
+         * @param where Optional condition of the rows.
+         * @return QString A SQL query to select a page of rows.
+         */
+        [[nodiscard]] QString createSelectPage(const QStringList &key, bool after,
+                                               const QString &where = {}) const override;
+
         /**
          * @brief Generates the WHERE clause for SQL queries.
          *
@@ -154,6 +192,35 @@ namespace core::db
          * @return The parent class name as a QString.
          */
         [[nodiscard]] QString parentClass() const override;
+
+    private:
+        /**
+         * @brief The columns of the table grouped by their role in the statements.
+         */
+        struct Partitions
+        {
+            QVector<qsizetype> values; ///< Positions of the columns written by INSERT and UPDATE.
+            QStringList        primaryKeys; ///< Names of the primary key columns.
+            QString            where; ///< WHERE clause on the key or indexed columns.
+            quint64            revision = 0; ///< Revision of the columns they were computed from.
+        };
+
+        /**
+         * @brief Retrieves the partitions of the columns, computing them once per change of the columns.
+         *
+         * @return The partitions of the current columns.
+         */
+        [[nodiscard]] const Partitions &partitions() const;
+
+        /**
+         * @brief Checks whether a column of the table may hold NULL.
+         *
+         * @param column The name of the column.
+         * @return true if the column is neither NOT NULL nor part of the primary key.
+         */
+        [[nodiscard]] bool isNullable(const QString &column) const;
+
+        mutable Partitions m_partitions; ///< Partitions of the columns, see partitions().
     };
 
 } // namespace core::db
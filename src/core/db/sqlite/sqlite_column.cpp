@@ -9,7 +9,8 @@
 
 #include "db/sqlite/sqlite_column.h"
 
-#include "db/sql_builder.h"
+#include "db/sqlite/sqlite_builder.h"
+#include "db/table_schema.h"
 
 #include <QMap>
 
@@ -85,7 +86,8 @@ namespace core::db
                 {"is_primary_key", SQLiteModifier::isPrimaryKey},
                 {"is_auto_increment", SQLiteModifier::isAutoIncrement},
                 {"is_unique", SQLiteModifier::isUnique},
-                {"is_not_null", SQLiteModifier::isNotNull}};
+                {"is_not_null", SQLiteModifier::isNotNull},
+                {"is_immutable", SQLiteModifier::isImmutable}};
 
         // Iterate over each modifier string and update the mask
         for (const auto &modifier: modifiers)
@@ -102,31 +104,19 @@ namespace core::db
 
     QString SQLiteColumn::columnDefinition()
     {
-        QString definition;
-
-        QVector<std::function<QString()>> modifiers = {
-                {[modifier = this->hasModifier(SQLiteModifier::isNotNull)]() { return modifier ? " NOT NULL" : ""; }},
-                {[modifier = this->hasModifier(SQLiteModifier::isPrimaryKey)]()
-                 { return modifier ? " PRIMARY KEY" : ""; }},
-                {[modifier = this->hasModifier(SQLiteModifier::isAutoIncrement)]()
-                 { return modifier ? " AUTOINCREMENT" : ""; }},
-                {[modifier = this->hasModifier(SQLiteModifier::isUnique)]() { return modifier ? " UNIQUE" : ""; }},
-                {[modifier = m_customConstraint.has_value(), this]()
-                 { return modifier ? QString(" CHECK(%1)").arg(m_customConstraint.value()) : ""; }},
-                {[modifier = m_defaultValue.has_value(), this]()
-                 { return modifier ? QString(" DEFAULT %1").arg(m_defaultValue.value()) : ""; }},
-                {[modifier = m_customConstraint.has_value(), this]()
-                 { return modifier ? QString(" COLLATE %1").arg(m_collate.value()) : ""; }},
-        };
-
-        definition += m_columnName + " " + m_dataType;
+        TableSchema schema;
+        return SQLiteBuilder::columnDefinition(schema, addTo(schema));
+    }
 
-        for (const auto &modifier: modifiers)
+    qsizetype SQLiteColumn::addTo(TableSchema &schema) const
+    {
+        const auto column = Column::addTo(schema);
+        schema.setTypeCode(column, static_cast<int>(m_columnType));
+        if (m_collate.has_value())
         {
-            definition += modifier();
+            schema.setAttribute(column, TableSchema::Attribute::Collate, m_collate.value());
         }
-
-        return definition;
+        return column;
     }
 
     QString SQLiteColumn::columnToCppType()
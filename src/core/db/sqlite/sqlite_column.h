@@ -31,6 +31,7 @@ namespace core::db
         isAutoIncrement = 1 << 1, ///< Enables auto-increment for the column.
         isUnique        = 1 << 2, ///< Enforces uniqueness for values in the column.
         isNotNull       = 1 << 3, ///< Prevents null values in the column.
+        isImmutable     = 1 << 4, ///< Keeps the value written by INSERT, left out of UPDATE and upsert.
     };
 
     // Enable bitwise operations for SQLiteModifier
@@ -112,6 +113,16 @@ namespace core::db
          */
         [[nodiscard]] bool hasModifier(SQLiteModifiers modifier) const;
 
+        /**
+         * @brief Appends the column to the flat schema of a table.
+         *
+         * Same as Column::addTo() plus the SQLite data type as type code and the collation.
+         *
+         * @param schema The schema to append the column to.
+         * @return The position of the column in the schema.
+         */
+        qsizetype addTo(TableSchema &schema) const override;
+
         /**
          * @brief Converts an SQLiteDataType enum value to a corresponding SQL type string.
          *
@@ -155,7 +166,8 @@ namespace core::db
         /**
          * @brief Generates the SQL definition of the column, including SQLite-specific properties.
          *
-         * Constructs the complete SQL column definition with properties such as type, modifiers, and constraints.
+         * Constructs the complete SQL column definition with properties such as type, modifiers, and constraints,
+         * see SQLiteBuilder::columnDefinition().
          *
          * @return A QString containing the SQL column definition.
          */
@@ -9,31 +9,126 @@
 
 #include "sqlite_db_api.h"
 
+#include <QList>
+#include <QMap>
+#include <QReadWriteLock>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <atomic>
 
 #include "db/db_exception.h"
+#include "db/db_manager.h"
+#include "db/query_profiler.h"
+#include "db/transaction.h"
 
 
 namespace core::db
 {
+    namespace
+    {
+        /**
+         * @brief Listeners of the table writes, shared by every generated class.
+         */
+        struct TableListeners
+        {
+            QReadWriteLock                              lock; ///< Writes can happen in any thread.
+            QMap<qsizetype, SQLiteDbApi::TableListener> listeners; ///< Listeners by handle.
+            qsizetype                                   nextHandle = 0; ///< Handle of the next listener.
+            std::atomic<qsizetype>                      size       = 0; ///< Listeners, read without the lock.
+        };
+
+        TableListeners &tableListeners()
+        {
+            static TableListeners self;
+            return self;
+        }
+    } // namespace
+
     SQLiteDbApi::SQLiteDbApi(const QSqlDatabase &db) : m_database(db)
     {
     }
 
-    long long SQLiteDbApi::getLastInsertRowId() const
+    long long SQLiteDbApi::lastInsertRowId(const QSqlQuery &query)
+    {
+        return query.lastInsertId().toLongLong();
+    }
+
+    qsizetype SQLiteDbApi::addTableListener(TableListener listener)
+    {
+        auto        &self = tableListeners();
+        QWriteLocker locker(&self.lock);
+        const auto   handle = self.nextHandle++;
+        self.listeners.insert(handle, std::move(listener));
+        self.size = self.listeners.size();
+        return handle;
+    }
+
+    void SQLiteDbApi::removeTableListener(const qsizetype handle)
+    {
+        auto        &self = tableListeners();
+        QWriteLocker locker(&self.lock);
+        self.listeners.remove(handle);
+        self.size = self.listeners.size();
+    }
+
+    void SQLiteDbApi::notifyTableChanged(const QString &table)
     {
-        QSqlQuery query(m_database);
-        if (query.exec("SELECT last_insert_rowid();"))
+        auto &self = tableListeners();
+        // Writes without listeners, the usual case, do not take the lock
+        if (self.size.load(std::memory_order_relaxed) == 0)
         {
-            if (query.next())
-            {
-                return query.value(0).toLongLong();
-            }
-            return 0;
+            return;
+        }
+        // Called on a copy, after the lock is released, so a listener can add or remove listeners
+        QList<TableListener> listeners;
+        {
+            QReadLocker locker(&self.lock);
+            listeners = self.listeners.values();
+        }
+        for (const auto &listener: listeners)
+        {
+            listener(table);
         }
-        throw core::db::SQLError(query.lastError().text());
     }
 
+    std::shared_ptr<QSqlQuery> SQLiteDbApi::prepare(const QAnyStringView sql) const
+    {
+        return DBManager::manager().statementCache(m_database)->acquire(sql.toString());
+    }
+
+    void SQLiteDbApi::ensurePrepared(std::shared_ptr<QSqlQuery> &statement, const QAnyStringView sql) const
+    {
+        if (!statement)
+        {
+            statement = prepare(sql);
+        }
+    }
+
+    std::shared_ptr<QSqlQuery> SQLiteDbApi::prepareCursor(const QAnyStringView sql) const
+    {
+        auto statement = std::make_shared<QSqlQuery>(m_database);
+        statement->setForwardOnly(true);
+        statement->prepare(sql.toString());
+        return statement;
+    }
+
+    void SQLiteDbApi::ensurePreparedCursor(std::shared_ptr<QSqlQuery> &statement, const QAnyStringView sql) const
+    {
+        if (!statement)
+        {
+            statement = prepareCursor(sql);
+        }
+    }
+
+    void SQLiteDbApi::execBatch(QSqlQuery &query, const char *name)
+    {
+        Transaction   transaction(m_database);
+        ProfiledQuery profile(m_database, name);
+        if (!profile.execBatch(query))
+        {
+            throw core::db::SQLError(query.lastError().text());
+        }
+        transaction.commit();
+    }
 
 } // namespace core::db
@@ -12,11 +12,44 @@
  */
 
 #pragma once
+#include <QAnyStringView>
+#include <QDateTime>
 #include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <array>
+#include <functional>
+#include <memory>
 #include "dllexports.h"
+#include "db/sqlite/sqlite_column.h"
 
 namespace core::db
 {
+    /**
+     * @struct ColumnDescriptor
+     * @brief Compile-time description of a column of a generated table.
+     *
+     * Generated classes keep a constexpr array of descriptors, one per column in table order,
+     * instead of building their description at runtime.
+     */
+    struct ColumnDescriptor
+    {
+        const char                  *name; ///< Name of the column.
+        SQLiteColumn::SQLiteDataType type; ///< Type of the column.
+        std::size_t                  ordinal; ///< Position of the column in the table.
+        SQLiteModifiers              flags; ///< Modifiers of the column.
+
+        /**
+         * @brief Checks if the column has a modifier.
+         * @param modifier The modifier to check.
+         * @return true if the column has it.
+         */
+        [[nodiscard]] constexpr bool hasModifier(const SQLiteModifier modifier) const
+        {
+            return flags.testFlag(modifier);
+        }
+    };
+
     /**
      * @class SQLiteDbApi
      * @brief Encapsulates SQLite-specific database operations.
@@ -35,16 +68,173 @@ namespace core::db
         explicit SQLiteDbApi(const QSqlDatabase &db);
 
         /**
-         * @brief Retrieves the row ID of the last inserted row.
+         * @brief Retrieves the row ID of the row inserted by the last execution of a statement.
          *
-         * This method provides a SQLite-specific operation to fetch the `rowid` of the last
-         * successfully inserted row in the connected database.
+         * Reads the id kept by the driver, sqlite3_last_insert_rowid() for SQLite, so it does not
+         * execute any statement nor allocate memory.
          *
+         * @param query The insert statement that has just been executed.
          * @return The ID of the last inserted row as a long long integer.
          */
-        long long getLastInsertRowId() const;
+        static long long lastInsertRowId(const QSqlQuery &query);
+
+        /**
+         * @brief Function called with the name of a table after a generated class writes to it.
+         */
+        using TableListener = std::function<void(const QString &table)>;
+
+        /**
+         * @brief Registers a function called after every insert, update or delete of the generated classes.
+         *
+         * Caches of table rows use it to drop their copies. The function runs in the thread that
+         * wrote, right after the statement, so it must be thread safe and cheap. It may add or
+         * remove listeners, itself included.
+         *
+         * @param listener The function.
+         * @return The handle to pass to removeTableListener().
+         */
+        static qsizetype addTableListener(TableListener listener);
+
+        /**
+         * @brief Unregisters a function registered with addTableListener().
+         *
+         * A notification that already started in another thread may still call it once.
+         *
+         * @param handle The handle returned by addTableListener().
+         */
+        static void removeTableListener(qsizetype handle);
 
     protected:
+        using DataType = SQLiteColumn::SQLiteDataType; ///< Type of the column descriptors.
+        using Modifier = SQLiteModifier; ///< Modifiers of the column descriptors.
+
+        /**
+         * @brief Retrieves a prepared statement from the statement cache of the connection.
+         *
+         * Generated classes share their compiled statements with every other instance on the same
+         * connection, so constructing a table object does not compile its statements again.
+         *
+         * @param sql The SQL text of the statement.
+         * @return The prepared, forward-only statement.
+         */
+        [[nodiscard]] std::shared_ptr<QSqlQuery> prepare(QAnyStringView sql) const;
+
+        /**
+         * @brief Prepares a statement on its first use.
+         *
+         * Generated classes only prepare their hot statements in the constructor, the rest are
+         * taken from the statement cache the first time one of their methods runs.
+         *
+         * @param statement The statement member, prepared if it is still empty.
+         * @param sql The SQL text of the statement.
+         */
+        void ensurePrepared(std::shared_ptr<QSqlQuery> &statement, QAnyStringView sql) const;
+
+        /**
+         * @brief Prepares a statement owned by this instance, outside the statement cache.
+         *
+         * The selects iterated through a next method keep their result set between calls, so they
+         * cannot share their query with the other instances on the same connection.
+         *
+         * @param sql The SQL text of the statement.
+         * @return The prepared, forward-only statement.
+         */
+        [[nodiscard]] std::shared_ptr<QSqlQuery> prepareCursor(QAnyStringView sql) const;
+
+        /**
+         * @brief Prepares a statement owned by this instance on its first use, see prepareCursor().
+         *
+         * @param statement The statement member, prepared if it is still empty.
+         * @param sql The SQL text of the statement.
+         */
+        void ensurePreparedCursor(std::shared_ptr<QSqlQuery> &statement, QAnyStringView sql) const;
+
+        /**
+         * @brief Executes a prepared statement with column vectors bound, inside a single transaction.
+         *
+         * Runs QSqlQuery::execBatch on the already bound statement. The transaction is committed when
+         * every row succeeds and rolled back otherwise, throwing an SQLError with the driver message.
+         *
+         * @param query The prepared statement with a list of values bound to each placeholder.
+         * @param name The name the execution is profiled with, see QueryProfiler.
+         */
+        void execBatch(QSqlQuery &query, const char *name = "SQLiteDbApi::execBatch");
+
+        /**
+         * @brief Calls the table listeners after a write, generated classes call it from their write methods.
+         * @param table The name of the table written.
+         */
+        static void notifyTableChanged(const QString &table);
+
+        /**
+         * @brief Resolves the ordinals of a statement's result columns the first time it returns a row.
+         *
+         * Generated classes read the row values by position instead of by name. The ordinals are
+         * looked up once with QSqlRecord::indexOf, the first element set to -1 marks them as unresolved.
+         *
+         * @param query The executed statement positioned on a valid row.
+         * @param ordinals The cache of ordinals of the statement, initialized with -1 in the first element.
+         * @param columns The descriptors of the columns in the order they are read.
+         * @return A constant reference to the resolved ordinals.
+         */
+        template<std::size_t N>
+        static const std::array<int, N> &resolveFields(const QSqlQuery &query, std::array<int, N> &ordinals,
+                                                       const std::array<ColumnDescriptor, N> &columns)
+        {
+            if (ordinals.front() < 0)
+            {
+                const auto record = query.record();
+                for (std::size_t i = 0; i < N; i++)
+                {
+                    ordinals[i] = record.indexOf(columns[i].name);
+                }
+            }
+            return ordinals;
+        }
+
+        /**
+         * @brief Converts a value read from a statement to the C++ type of a column.
+         *
+         * Generated classes instantiate it with the type of their column descriptors, so the
+         * conversion is chosen at compile time.
+         *
+         * @tparam Type The type of the column.
+         * @param value The value read.
+         * @return The value as the member type of the generated record.
+         */
+        template<DataType Type>
+        static auto fromVariant(const QVariant &value)
+        {
+            if constexpr (Type == DataType::INTEGER)
+            {
+                return value.toLongLong();
+            }
+            else if constexpr (Type == DataType::REAL)
+            {
+                return value.toDouble();
+            }
+            else if constexpr (Type == DataType::BLOB)
+            {
+                return value.toByteArray();
+            }
+            else if constexpr (Type == DataType::BOOLEAN)
+            {
+                return value.toBool();
+            }
+            else if constexpr (Type == DataType::DATETIME)
+            {
+                return value.toDateTime();
+            }
+            else if constexpr (Type == DataType::NULL_TYPE)
+            {
+                return value;
+            }
+            else
+            {
+                return value.toString();
+            }
+        }
+
         QSqlDatabase m_database; ///< The QSqlDatabase object representing the SQLite connection.
     };
 } // namespace core::db
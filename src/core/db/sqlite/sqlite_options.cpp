@@ -0,0 +1,77 @@
+/**
+ * @file sqlite_options.cpp
+ * @brief Implementation file for the SQLiteOptions structure.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "sqlite_options.h"
+
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "db/db_exception.h"
+
+namespace core::db
+{
+    static constexpr qint64 MEBIBYTE = 1024 * 1024;
+
+    SQLiteOptions SQLiteOptions::interactive()
+    {
+        SQLiteOptions options;
+        options.journalMode  = JournalMode::WAL;
+        options.synchronous  = Synchronous::NORMAL;
+        options.mmapSize     = 256 * MEBIBYTE;
+        options.cacheSizeKiB = 16 * 1024;
+        options.tempStore    = TempStore::IN_MEMORY;
+        options.busyTimeout  = std::chrono::milliseconds(5000);
+        options.foreignKeys  = true;
+        return options;
+    }
+
+    SQLiteOptions SQLiteOptions::bulkLoad()
+    {
+        SQLiteOptions options;
+        options.journalMode  = JournalMode::WAL;
+        options.synchronous  = Synchronous::OFF;
+        options.mmapSize     = 256 * MEBIBYTE;
+        options.cacheSizeKiB = 64 * 1024;
+        options.tempStore    = TempStore::IN_MEMORY;
+        options.busyTimeout  = std::chrono::milliseconds(30000);
+        options.foreignKeys  = false;
+        return options;
+    }
+
+    QStringList SQLiteOptions::pragmas() const
+    {
+        static const QStringList journalModes     = {"DELETE", "TRUNCATE", "MEMORY", "WAL", "OFF"};
+        static const QStringList synchronousModes = {"OFF", "NORMAL", "FULL", "EXTRA"};
+
+        return {
+                QString("PRAGMA journal_mode = %1;").arg(journalModes[static_cast<int>(journalMode)]),
+                QString("PRAGMA synchronous = %1;").arg(synchronousModes[static_cast<int>(synchronous)]),
+                QString("PRAGMA mmap_size = %1;").arg(mmapSize),
+                // A negative cache_size is read by SQLite as KiB instead of pages
+                QString("PRAGMA cache_size = -%1;").arg(cacheSizeKiB),
+                QString("PRAGMA temp_store = %1;").arg(static_cast<int>(tempStore)),
+                QString("PRAGMA busy_timeout = %1;").arg(busyTimeout.count()),
+                QString("PRAGMA foreign_keys = %1;").arg(foreignKeys ? "ON" : "OFF"),
+        };
+    }
+
+    void SQLiteOptions::apply(const QSqlDatabase &database) const
+    {
+        QSqlQuery query(database);
+        for (const auto &pragma: pragmas())
+        {
+            if (!query.exec(pragma))
+            {
+                throw SQLError(QString("%1 %2").arg(pragma, query.lastError().text()));
+            }
+            query.finish();
+        }
+    }
+
+} // namespace core::db
@@ -0,0 +1,101 @@
+/**
+ * @file sqlite_options.h
+ * @brief Declares the SQLiteOptions structure used to tune SQLite connections.
+ *
+ * The options are applied as PRAGMA sentences right after the connection is opened,
+ * see DBManager::connect().
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "dllexports.h"
+
+#include <QSqlDatabase>
+#include <QStringList>
+#include <chrono>
+
+namespace core::db
+{
+
+    /**
+     * @struct SQLiteOptions
+     * @brief Per-connection SQLite tuning.
+     *
+     * A default constructed object keeps the SQLite defaults, interactive() and bulkLoad()
+     * return the presets used by the application.
+     */
+    struct CORE_API SQLiteOptions
+    {
+        /**
+         * @brief Values of PRAGMA journal_mode.
+         */
+        enum class JournalMode
+        {
+            DELETE_MODE, ///< Rollback journal deleted at the end of each transaction, the SQLite default.
+            TRUNCATE, ///< Rollback journal truncated instead of deleted.
+            MEMORY, ///< Rollback journal kept in memory.
+            WAL, ///< Write-ahead log, readers do not block the writer.
+            OFF, ///< No journal, a crash can corrupt the database.
+        };
+
+        /**
+         * @brief Values of PRAGMA synchronous.
+         */
+        enum class Synchronous
+        {
+            OFF, ///< No fsync, the operating system is trusted.
+            NORMAL, ///< Fsync at the critical moments only, safe in WAL mode.
+            FULL, ///< Fsync on every commit, the SQLite default.
+            EXTRA, ///< FULL plus the fsync of the directory of the journal.
+        };
+
+        /**
+         * @brief Values of PRAGMA temp_store.
+         */
+        enum class TempStore
+        {
+            DEFAULT, ///< Decided at compile time.
+            ON_DISK, ///< Temporary tables and indexes are stored in files.
+            IN_MEMORY, ///< Temporary tables and indexes are stored in memory.
+        };
+
+        JournalMode               journalMode  = JournalMode::DELETE_MODE; ///< PRAGMA journal_mode.
+        Synchronous               synchronous  = Synchronous::FULL; ///< PRAGMA synchronous.
+        qint64                    mmapSize     = 0; ///< PRAGMA mmap_size, in bytes, 0 disables memory mapping.
+        qint64                    cacheSizeKiB = 2000; ///< PRAGMA cache_size, in KiB.
+        TempStore                 tempStore    = TempStore::DEFAULT; ///< PRAGMA temp_store.
+        std::chrono::milliseconds busyTimeout{5000}; ///< PRAGMA busy_timeout.
+        bool                      foreignKeys = false; ///< PRAGMA foreign_keys.
+
+        /**
+         * @brief Preset for the application: concurrent readers, safe and fast commits.
+         * @return WAL journal, synchronous NORMAL, 256 MiB memory map, 16 MiB cache, foreign keys enforced.
+         */
+        static SQLiteOptions interactive();
+
+        /**
+         * @brief Preset for imports: durability is traded for insert throughput.
+         * @return WAL journal, synchronous OFF, 256 MiB memory map, 64 MiB cache, foreign keys not enforced.
+         */
+        static SQLiteOptions bulkLoad();
+
+        /**
+         * @brief Builds the PRAGMA sentences of the options.
+         * @return The sentences, in the order they are applied.
+         */
+        [[nodiscard]] QStringList pragmas() const;
+
+        /**
+         * @brief Applies the options to an opened connection.
+         * @param database The connection, it must be opened.
+         * @throws SQLError if any of the sentences fails.
+         */
+        void apply(const QSqlDatabase &database) const;
+    };
+
+} // namespace core::db
@@ -0,0 +1,61 @@
+/**
+ * @file statement_cache.cpp
+ * @brief Implementation file for the StatementCache class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "statement_cache.h"
+
+#include <algorithm>
+#include "tools/trace.h"
+
+namespace core::db
+{
+
+    StatementCache::StatementCache(QSqlDatabase database, const qsizetype capacity) :
+        m_database(std::move(database)), m_statements(std::max<qsizetype>(1, capacity))
+    {
+    }
+
+    std::shared_ptr<QSqlQuery> StatementCache::acquire(const QString &sql)
+    {
+        if (const auto *cached = m_statements.object(sql))
+        {
+            m_hits++;
+            return *cached;
+        }
+
+        m_misses++;
+        const tools::ScopedSpan span("db.prepare", "db", sql);
+        auto                    statement = std::make_shared<QSqlQuery>(m_database);
+        statement->setForwardOnly(true);
+        if (statement->prepare(sql))
+        {
+            if (m_statements.size() >= m_statements.maxCost())
+            {
+                m_evictions++;
+            }
+            m_statements.insert(sql, new std::shared_ptr<QSqlQuery>(statement));
+        }
+        return statement;
+    }
+
+    void StatementCache::clear()
+    {
+        m_statements.clear();
+    }
+
+    qsizetype StatementCache::size() const
+    {
+        return m_statements.size();
+    }
+
+    qsizetype StatementCache::capacity() const
+    {
+        return m_statements.maxCost();
+    }
+
+} // namespace core::db
@@ -0,0 +1,116 @@
+/**
+ * @file statement_cache.h
+ * @brief Header file for the StatementCache class.
+ *
+ * This file declares the StatementCache class, a bounded cache of prepared statements of a
+ * connection keyed by their SQL text, so the compiled statements are reused across the
+ * DynamicTable and generated table instances that work on the same connection.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "dllexports.h"
+
+#include <QCache>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <memory>
+
+namespace core::db
+{
+
+    /**
+     * @class StatementCache
+     * @brief Least recently used cache of the prepared statements of a connection.
+     *
+     * The statements are forward-only and shared by all the holders of the same SQL text, on any
+     * object of the connection, so a holder must not expect its result set to survive a call made
+     * by another holder: only the statements whose rows are read right away belong here, and the
+     * ones iterated across calls, such as cursors, are prepared on their own query. Like the
+     * connection itself, a cache must only be used from the thread that opened the connection.
+     * Use DBManager::statementCache() to get the cache of a connection.
+     */
+    class CORE_API StatementCache
+    {
+    public:
+        static constexpr qsizetype DEFAULT_CAPACITY = 64; ///< Default number of statements kept per connection.
+
+        /**
+         * @brief Constructs an empty cache.
+         * @param database The connection the statements are prepared on.
+         * @param capacity Maximum number of statements kept, the least recently used one is dropped first.
+         */
+        explicit StatementCache(QSqlDatabase database, qsizetype capacity = DEFAULT_CAPACITY);
+
+        StatementCache(const StatementCache &)            = delete;
+        StatementCache &operator=(const StatementCache &) = delete;
+
+        /**
+         * @brief Retrieves the prepared statement of a SQL text, preparing it on a miss.
+         *
+         * A statement that fails to prepare, for instance because its table does not exist yet,
+         * is returned without being cached, so that the next call tries again.
+         *
+         * @param sql The SQL text of the statement.
+         * @return The prepared statement.
+         */
+        [[nodiscard]] std::shared_ptr<QSqlQuery> acquire(const QString &sql);
+
+        /**
+         * @brief Drops all the cached statements.
+         */
+        void clear();
+
+        /**
+         * @brief Retrieves the number of cached statements.
+         * @return The number of statements.
+         */
+        [[nodiscard]] qsizetype size() const;
+
+        /**
+         * @brief Retrieves the maximum number of cached statements.
+         * @return The capacity of the cache.
+         */
+        [[nodiscard]] qsizetype capacity() const;
+
+        /**
+         * @brief Retrieves the number of calls to acquire() served from the cache.
+         * @return The number of hits.
+         */
+        [[nodiscard]] quint64 hits() const
+        {
+            return m_hits;
+        }
+
+        /**
+         * @brief Retrieves the number of calls to acquire() that had to prepare the statement.
+         * @return The number of misses.
+         */
+        [[nodiscard]] quint64 misses() const
+        {
+            return m_misses;
+        }
+
+        /**
+         * @brief Retrieves the number of statements dropped to respect the capacity.
+         * @return The number of evictions.
+         */
+        [[nodiscard]] quint64 evictions() const
+        {
+            return m_evictions;
+        }
+
+    private:
+        QSqlDatabase                                m_database; ///< The connection the statements belong to.
+        QCache<QString, std::shared_ptr<QSqlQuery>> m_statements; ///< Prepared statements by SQL text.
+        quint64                                     m_hits      = 0; ///< Calls served from the cache.
+        quint64                                     m_misses    = 0; ///< Calls that prepared the statement.
+        quint64                                     m_evictions = 0; ///< Statements dropped by the LRU policy.
+    };
+
+} // namespace core::db
@@ -0,0 +1,132 @@
+/**
+ * @file table_schema.cpp
+ * @brief Implementation file for the TableSchema class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "table_schema.h"
+#include "column.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace core::db
+{
+
+    TableSchema::TableSchema(const std::initializer_list<std::shared_ptr<Column>> columns)
+    {
+        for (const auto &column: columns)
+        {
+            column->addTo(*this);
+        }
+    }
+
+    qsizetype TableSchema::addColumn(const QString &name, const QString &dataType, const int typeCode,
+                                     const unsigned int modifiers)
+    {
+        m_names.append(name);
+        m_types.append(intern(dataType));
+        m_typeCodes.append(typeCode);
+        m_modifiers.append(modifiers);
+        for (auto &attribute: m_attributes)
+        {
+            attribute.append(-1);
+        }
+        return m_names.size() - 1;
+    }
+
+    void TableSchema::setAttribute(const qsizetype column, const Attribute attribute, const QString &value)
+    {
+        m_attributes[static_cast<std::size_t>(attribute)][column] = intern(value);
+    }
+
+    void TableSchema::setTypeCode(const qsizetype column, const int typeCode)
+    {
+        m_typeCodes[column] = typeCode;
+    }
+
+    const QString &TableSchema::attribute(const qsizetype column, const Attribute attribute) const
+    {
+        static const QString none;
+        const auto           id = m_attributes[static_cast<std::size_t>(attribute)][column];
+        return id < 0 ? none : m_strings[id];
+    }
+
+    std::optional<QString> TableSchema::optionalAttribute(const qsizetype column, const Attribute attribute) const
+    {
+        if (!hasAttribute(column, attribute))
+        {
+            return std::nullopt;
+        }
+        return TableSchema::attribute(column, attribute);
+    }
+
+    void TableSchema::addIndex(TableIndex index)
+    {
+        m_indexes.append(std::move(index));
+    }
+
+    const TableIndex *TableSchema::findIndex(const QString &name) const
+    {
+        const auto it = std::ranges::find(m_indexes, name, &TableIndex::name);
+        return it == m_indexes.cend() ? nullptr : &*it;
+    }
+
+    std::optional<qsizetype> TableSchema::indexOf(const QString &name) const
+    {
+        if (const auto column = m_names.indexOf(name); column >= 0)
+        {
+            return column;
+        }
+        return std::nullopt;
+    }
+
+    QString TableSchema::fingerprint() const
+    {
+        QString fingerprint;
+        for (qsizetype column = 0; column < size(); column++)
+        {
+            fingerprint += '\x1e' + m_names[column] + '\x1f' + dataType(column) + '\x1f' +
+                           QString::number(m_typeCodes[column]) + '\x1f' + QString::number(m_modifiers[column]);
+            for (const auto &attribute: m_attributes)
+            {
+                // The unset properties are told apart from the empty ones
+                if (attribute[column] < 0)
+                {
+                    fingerprint += '\x1d';
+                }
+                else
+                {
+                    fingerprint += '\x1f' + m_strings[attribute[column]];
+                }
+            }
+        }
+        for (const auto &index: m_indexes)
+        {
+            fingerprint += '\x1c' + index.name + '\x1f' + (index.unique ? '1' : '0') + '\x1f' + index.where;
+            for (const auto &term: index.terms)
+            {
+                fingerprint += '\x1f' + term.expression + (term.descending ? " DESC" : "");
+            }
+            fingerprint += '\x1d' + index.include.join('\x1f');
+        }
+        return fingerprint;
+    }
+
+    qint32 TableSchema::intern(const QString &value)
+    {
+        const auto it = m_stringIds.constFind(value);
+        if (it != m_stringIds.cend())
+        {
+            return it.value();
+        }
+        const auto id = static_cast<qint32>(m_strings.size());
+        m_strings.append(value);
+        m_stringIds.insert(value, id);
+        return id;
+    }
+
+} // namespace core::db
@@ -0,0 +1,280 @@
+/**
+ * @file table_schema.h
+ * @brief Header file for the TableSchema class.
+ *
+ * This file declares TableSchema, the flat description of the columns of a table that the SQL
+ * builders, DynamicTable and the code generator iterate by position, and TableIndex, the
+ * indexes declared apart from the columns.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+#include <array>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include "dllexports.h"
+
+namespace core::db
+{
+    class Column;
+
+    /**
+     * @struct TableIndex
+     * @brief An index of a table declared apart from its columns.
+     *
+     * Unlike the index name of a column, which groups the columns sharing it in table order, it
+     * sets the order of its terms and may be unique, partial, sorted in descending order or built
+     * on expressions. SQLite has no INCLUDE clause, so the covering columns are appended after the
+     * key, which lets the queries reading only indexed columns skip the table.
+     */
+    struct TableIndex
+    {
+        /**
+         * @brief A term of the key of an index.
+         */
+        struct Term
+        {
+            QString expression; ///< Name of a column, or an expression such as lower(email).
+            bool    descending = false; ///< Whether the term is sorted in descending order.
+        };
+
+        QString       name; ///< Name of the index.
+        QVector<Term> terms; ///< Key of the index, in order.
+        QStringList   include; ///< Covering columns appended after the key, not allowed in a unique index.
+        bool          unique = false; ///< Whether the key is unique.
+        QString       where; ///< Condition of a partial index, empty to index every row.
+    };
+
+    /**
+     * @class TableSchema
+     * @brief Struct-of-arrays description of the columns of a table.
+     *
+     * Every property of the columns is kept in its own contiguous array indexed by the position of
+     * the column, and the optional strings (index, default value, foreign key, check condition and
+     * collation) are interned, so the statement builders read plain values instead of calling the
+     * virtual accessors of each Column. Column objects are still accepted and copied in through
+     * Column::addTo().
+     */
+    class CORE_API TableSchema
+    {
+    public:
+        /**
+         * @brief Optional string properties of a column.
+         */
+        enum class Attribute
+        {
+            Index, ///< Name of the index the column belongs to.
+            Default, ///< Default value, written instead of a placeholder.
+            ForeignKey, ///< Referenced table and column.
+            Check, ///< Condition of the CHECK constraint.
+            Collate, ///< Collation sequence.
+        };
+
+        static constexpr std::size_t ATTRIBUTES = 5; ///< Number of values of Attribute.
+
+        /**
+         * @brief Constructs an empty schema.
+         */
+        TableSchema() = default;
+
+        /**
+         * @brief Constructs the schema of a list of columns.
+         * @param columns The columns, in table order.
+         */
+        TableSchema(std::initializer_list<std::shared_ptr<Column>> columns);
+
+        /**
+         * @brief Appends a column.
+         * @param name The name of the column.
+         * @param dataType The SQL data type of the column.
+         * @param typeCode The data type as the enumeration of the database backend.
+         * @param modifiers Bitmask of the modifiers of the backend.
+         * @return The position of the column.
+         */
+        qsizetype addColumn(const QString &name, const QString &dataType, int typeCode = 0, unsigned int modifiers = 0);
+
+        /**
+         * @brief Sets an optional property of a column.
+         * @param column The position of the column.
+         * @param attribute The property.
+         * @param value The value of the property.
+         */
+        void setAttribute(qsizetype column, Attribute attribute, const QString &value);
+
+        /**
+         * @brief Sets the backend data type of a column.
+         * @param column The position of the column.
+         * @param typeCode The data type as the enumeration of the database backend.
+         */
+        void setTypeCode(qsizetype column, int typeCode);
+
+        /**
+         * @brief Retrieves the number of columns.
+         * @return The number of columns.
+         */
+        [[nodiscard]] qsizetype size() const
+        {
+            return m_names.size();
+        }
+
+        /**
+         * @brief Checks whether the schema has no columns.
+         * @return true if there are no columns.
+         */
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_names.isEmpty();
+        }
+
+        /**
+         * @brief Retrieves the names of the columns.
+         * @return The names, in table order.
+         */
+        [[nodiscard]] const QVector<QString> &names() const
+        {
+            return m_names;
+        }
+
+        /**
+         * @brief Retrieves the name of a column.
+         * @param column The position of the column.
+         * @return The name of the column.
+         */
+        [[nodiscard]] const QString &name(const qsizetype column) const
+        {
+            return m_names[column];
+        }
+
+        /**
+         * @brief Retrieves the SQL data type of a column.
+         * @param column The position of the column.
+         * @return The data type, such as INTEGER.
+         */
+        [[nodiscard]] const QString &dataType(const qsizetype column) const
+        {
+            return m_strings[m_types[column]];
+        }
+
+        /**
+         * @brief Retrieves the backend data type of a column.
+         * @param column The position of the column.
+         * @return The data type as the enumeration of the database backend.
+         */
+        [[nodiscard]] int typeCode(const qsizetype column) const
+        {
+            return m_typeCodes[column];
+        }
+
+        /**
+         * @brief Retrieves the modifiers of a column.
+         * @param column The position of the column.
+         * @return The bitmask of the modifiers.
+         */
+        [[nodiscard]] unsigned int modifiers(const qsizetype column) const
+        {
+            return m_modifiers[column];
+        }
+
+        /**
+         * @brief Checks whether a column has any of the given modifiers.
+         * @param column The position of the column.
+         * @param modifier The modifiers of the backend, such as SQLiteModifier values.
+         * @return true if the column has any of them.
+         */
+        template<typename Modifier>
+        [[nodiscard]] bool hasModifier(const qsizetype column, const Modifier modifier) const
+        {
+            return (m_modifiers[column] & static_cast<unsigned int>(modifier)) != 0;
+        }
+
+        /**
+         * @brief Checks whether a column has an optional property.
+         * @param column The position of the column.
+         * @param attribute The property.
+         * @return true if the property is set.
+         */
+        [[nodiscard]] bool hasAttribute(const qsizetype column, const Attribute attribute) const
+        {
+            return m_attributes[static_cast<std::size_t>(attribute)][column] >= 0;
+        }
+
+        /**
+         * @brief Retrieves an optional property of a column.
+         * @param column The position of the column.
+         * @param attribute The property.
+         * @return The value of the property, empty if it is not set.
+         */
+        [[nodiscard]] const QString &attribute(qsizetype column, Attribute attribute) const;
+
+        /**
+         * @brief Retrieves an optional property of a column.
+         * @param column The position of the column.
+         * @param attribute The property.
+         * @return The value of the property, or std::nullopt if it is not set.
+         */
+        [[nodiscard]] std::optional<QString> optionalAttribute(qsizetype column, Attribute attribute) const;
+
+        /**
+         * @brief Appends an index declared apart from the columns.
+         * @param index The index.
+         */
+        void addIndex(TableIndex index);
+
+        /**
+         * @brief Retrieves the indexes declared apart from the columns.
+         * @return The indexes, in declaration order.
+         */
+        [[nodiscard]] const QVector<TableIndex> &indexes() const
+        {
+            return m_indexes;
+        }
+
+        /**
+         * @brief Finds an index declared apart from the columns by name.
+         * @param name The name of the index.
+         * @return The index, or nullptr if there is none with that name.
+         */
+        [[nodiscard]] const TableIndex *findIndex(const QString &name) const;
+
+        /**
+         * @brief Finds a column by name.
+         * @param name The name of the column.
+         * @return The position of the column, or std::nullopt if there is none with that name.
+         */
+        [[nodiscard]] std::optional<qsizetype> indexOf(const QString &name) const;
+
+        /**
+         * @brief Builds a key that is equal for the schemas with the same columns and indexes.
+         * @return The fingerprint of the columns and every property of them, then of the indexes.
+         */
+        [[nodiscard]] QString fingerprint() const;
+
+    private:
+        /**
+         * @brief Stores a string once.
+         * @param value The string.
+         * @return The position of the string in the pool.
+         */
+        qint32 intern(const QString &value);
+
+        QVector<QString>                        m_names; ///< Name of each column.
+        QVector<qint32>                         m_types; ///< Interned SQL data type of each column.
+        QVector<int>                            m_typeCodes; ///< Backend data type of each column.
+        QVector<unsigned int>                   m_modifiers; ///< Modifier bitmask of each column.
+        std::array<QVector<qint32>, ATTRIBUTES> m_attributes; ///< Interned properties of each column, -1 if unset.
+        QVector<QString>                        m_strings; ///< Pool of the interned strings.
+        QHash<QString, qint32>                  m_stringIds; ///< Position of each interned string.
+        QVector<TableIndex>                     m_indexes; ///< Indexes declared apart from the columns.
+    };
+
+} // namespace core::db
@@ -0,0 +1,126 @@
+/**
+ * @file transaction.cpp
+ * @brief Implementation file for the Transaction class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "transaction.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QSqlError>
+#include <QSqlQuery>
+
+#include "db_exception.h"
+
+namespace core::db
+{
+    namespace
+    {
+        // A connection is only used from the thread that opened it, so the nesting levels are per thread
+        thread_local QHash<QString, int> transactionLevels;
+    } // namespace
+
+    Transaction::Transaction(QSqlDatabase database) : m_database(std::move(database))
+    {
+        auto &level = transactionLevels[m_database.connectionName()];
+        m_level     = level;
+        if (m_level == 0)
+        {
+            if (!m_database.transaction())
+            {
+                throw SQLError(m_database.lastError().text());
+            }
+        }
+        else
+        {
+            m_savepoint = QString("savepoint_%1").arg(m_level);
+            exec(QString("SAVEPOINT %1;").arg(m_savepoint));
+        }
+        level++;
+    }
+
+    Transaction::~Transaction()
+    {
+        if (m_active)
+        {
+            try
+            {
+                rollback();
+            }
+            catch (const SQLError &error)
+            {
+                qWarning() << "Failed to roll back the transaction:" << error.what();
+                finish();
+            }
+        }
+    }
+
+    void Transaction::commit()
+    {
+        if (!m_active)
+        {
+            return;
+        }
+        if (m_savepoint.isEmpty())
+        {
+            if (!m_database.commit())
+            {
+                throw SQLError(m_database.lastError().text());
+            }
+        }
+        else
+        {
+            exec(QString("RELEASE SAVEPOINT %1;").arg(m_savepoint));
+        }
+        finish();
+    }
+
+    void Transaction::rollback()
+    {
+        if (!m_active)
+        {
+            return;
+        }
+        if (m_savepoint.isEmpty())
+        {
+            if (!m_database.rollback())
+            {
+                throw SQLError(m_database.lastError().text());
+            }
+        }
+        else
+        {
+            // ROLLBACK TO keeps the savepoint open, release it so the outer level continues normally
+            exec(QString("ROLLBACK TO SAVEPOINT %1;").arg(m_savepoint));
+            exec(QString("RELEASE SAVEPOINT %1;").arg(m_savepoint));
+        }
+        finish();
+    }
+
+    void Transaction::exec(const QString &sql) const
+    {
+        QSqlQuery query(m_database);
+        if (!query.exec(sql))
+        {
+            throw SQLError(query.lastError().text());
+        }
+    }
+
+    void Transaction::finish()
+    {
+        m_active = false;
+        if (m_level == 0)
+        {
+            transactionLevels.remove(m_database.connectionName());
+        }
+        else
+        {
+            transactionLevels[m_database.connectionName()] = m_level;
+        }
+    }
+
+} // namespace core::db
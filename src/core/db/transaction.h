@@ -0,0 +1,97 @@
+/**
+ * @file transaction.h
+ * @brief Header file for the Transaction class.
+ *
+ * This file declares the Transaction class, a scope guard that groups the statements run on a
+ * connection into a single transaction, nesting through SAVEPOINTs.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include "dllexports.h"
+
+#include <QSqlDatabase>
+
+namespace core::db
+{
+
+    /**
+     * @class Transaction
+     * @brief RAII guard of a transaction, rolled back unless it is committed.
+     *
+     * The outermost guard of a connection begins a transaction, the guards created while it is
+     * alive open a SAVEPOINT instead, so a function can take a guard without knowing whether
+     * its caller already did. Call commit() once the work succeeds, if the scope is left by an
+     * exception the guard rolls back its part of the work.
+     *
+     * @code
+     * core::db::Transaction transaction(database);
+     * table.insert(...);
+     * table.update(...);
+     * transaction.commit();
+     * @endcode
+     */
+    class CORE_API Transaction
+    {
+    public:
+        /**
+         * @brief Begins a transaction, or a savepoint if the connection is already inside one.
+         * @param database The connection, as returned by DBManager.
+         * @throws SQLError if the transaction cannot begin.
+         */
+        explicit Transaction(QSqlDatabase database);
+
+        Transaction(const Transaction &)            = delete;
+        Transaction &operator=(const Transaction &) = delete;
+
+        /**
+         * @brief Rolls back the work if the transaction was not committed.
+         */
+        ~Transaction();
+
+        /**
+         * @brief Commits the transaction, or releases the savepoint.
+         * @throws SQLError if the commit fails, the transaction is rolled back when the guard is destroyed.
+         */
+        void commit();
+
+        /**
+         * @brief Rolls back the transaction, or the work done since the savepoint.
+         * @throws SQLError if the rollback fails.
+         */
+        void rollback();
+
+        /**
+         * @brief Retrieves the nesting level of the guard.
+         * @return 0 for the outermost transaction, the savepoint level otherwise.
+         */
+        [[nodiscard]] int level() const
+        {
+            return m_level;
+        }
+
+    private:
+        /**
+         * @brief Runs a savepoint sentence on the connection.
+         * @param sql The sentence.
+         * @throws SQLError if the sentence fails.
+         */
+        void exec(const QString &sql) const;
+
+        /**
+         * @brief Leaves the nesting level of the guard.
+         */
+        void finish();
+
+        QSqlDatabase m_database; ///< The connection of the transaction.
+        QString      m_savepoint; ///< Name of the savepoint, empty for the outermost transaction.
+        int          m_level  = 0; ///< Nesting level of the guard.
+        bool         m_active = true; ///< true until the transaction is committed or rolled back.
+    };
+
+} // namespace core::db
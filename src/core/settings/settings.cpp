@@ -9,7 +9,101 @@ namespace core::settings
 {
     QVariant &Settings::operator[](const QString &key)
     {
+        m_dirty.insert(key);
+        m_removed.remove(key);
         return m_values[key];
     }
 
+    QVariant Settings::value(const QString &key, const QVariant &defaultValue) const
+    {
+        return m_values.value(key, defaultValue);
+    }
+
+    void Settings::setValue(const QString &key, const QVariant &value)
+    {
+        const auto it = m_values.constFind(key);
+        if (it != m_values.cend() && it.value() == value)
+        {
+            return;
+        }
+        m_values[key] = value;
+        m_dirty.insert(key);
+        m_removed.remove(key);
+    }
+
+    bool Settings::remove(const QString &key)
+    {
+        if (m_values.remove(key) == 0)
+        {
+            return false;
+        }
+        m_dirty.remove(key);
+        m_removed.insert(key);
+        return true;
+    }
+
+    bool Settings::contains(const QString &key) const
+    {
+        return m_values.contains(key);
+    }
+
+    bool Settings::isDirty() const
+    {
+        return !m_dirty.isEmpty() || !m_removed.isEmpty();
+    }
+
+    void Settings::markClean()
+    {
+        m_dirty.clear();
+        m_removed.clear();
+    }
+
+    std::shared_ptr<const SettingsSnapshot> Settings::snapshot() const
+    {
+#if defined(__cpp_lib_atomic_shared_ptr)
+        return m_snapshot.load(std::memory_order_acquire);
+#else
+        return std::atomic_load_explicit(&m_snapshot, std::memory_order_acquire);
+#endif
+    }
+
+    void Settings::publish()
+    {
+        QVector<QVariant> values(m_slots.size());
+        for (qsizetype slot = 0; slot < m_slots.size(); ++slot)
+        {
+            const auto it = m_values.constFind(m_slots[slot].name);
+            if (it == m_values.cend() || !it.value().isValid())
+            {
+                continue;
+            }
+            // Convert once here so the readers get the value without a conversion
+            QVariant value = it.value();
+            if (value.metaType() == m_slots[slot].type || value.convert(m_slots[slot].type))
+            {
+                values[slot] = std::move(value);
+            }
+        }
+
+        auto snapshot = std::make_shared<const SettingsSnapshot>(std::move(values), ++m_version);
+#if defined(__cpp_lib_atomic_shared_ptr)
+        m_snapshot.store(std::move(snapshot), std::memory_order_release);
+#else
+        std::atomic_store_explicit(&m_snapshot, std::move(snapshot), std::memory_order_release);
+#endif
+    }
+
+    qsizetype Settings::registerSlot(const QString &name, const QMetaType type)
+    {
+        if (const auto it = m_slotIndexes.constFind(name); it != m_slotIndexes.cend())
+        {
+            return it.value();
+        }
+        const auto slot = m_slots.size();
+        m_slots.append({name, type});
+        m_slotIndexes.insert(name, slot);
+        publish();
+        return slot;
+    }
+
 }; // namespace core::settings
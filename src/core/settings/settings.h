@@ -10,8 +10,15 @@
 #pragma once
 
 // Include necessary headers
+#include <QHash>
+#include <QMap>
+#include <QMetaType>
+#include <QSet>
 #include <QVariant>
+#include <atomic>
+#include <memory>
 #include "dllexports.h"
+#include "settings_snapshot.h"
 
 namespace core::settings
 {
@@ -23,6 +30,11 @@ namespace core::settings
      * The `Settings` class provides a common interface for handling application settings.
      * It defines the basic operations of reading and writing settings, as well as a way
      * to access individual settings by key. It uses a `QMap` to store settings values.
+     *
+     * The keys changed or removed since the last read() or write() are tracked, so that the
+     * derived classes only store the changes. The map is owned by the thread that reads and
+     * writes the settings, other threads read the published SettingsSnapshot through typed
+     * SettingKey handles instead.
      */
     class CORE_API Settings
     {
@@ -58,15 +70,129 @@ namespace core::settings
          * @brief Overloaded `operator[]` to access settings by key.
          *
          * This operator allows accessing settings using the `[]` syntax, enabling users
-         * to directly retrieve or modify values stored in the settings map.
+         * to directly retrieve or modify values stored in the settings map. As the returned
+         * reference may be written, the key is marked as changed, use value() to only read it.
          *
          * @param key The key used to access the setting.
          * @return A reference to the setting value associated with the provided key.
          */
         QVariant &operator[](const QString &key);
 
+        /**
+         * @brief Retrieves the value of a setting without marking it as changed.
+         * @param key The key of the setting.
+         * @param defaultValue The value returned when the key does not exist.
+         * @return The value of the setting.
+         */
+        [[nodiscard]] QVariant value(const QString &key, const QVariant &defaultValue = {}) const;
+
+        /**
+         * @brief Sets the value of a setting, marking it as changed only if the value differs.
+         * @param key The key of the setting.
+         * @param value The new value.
+         */
+        void setValue(const QString &key, const QVariant &value);
+
+        /**
+         * @brief Removes a setting, it is deleted from the storage on the next write().
+         * @param key The key of the setting.
+         * @return true if the key existed.
+         */
+        bool remove(const QString &key);
+
+        /**
+         * @brief Checks whether a setting exists.
+         * @param key The key of the setting.
+         * @return true if the key exists.
+         */
+        [[nodiscard]] bool contains(const QString &key) const;
+
+        /**
+         * @brief Checks whether there are changes not written yet.
+         * @return true if any key was changed or removed since the last read() or write().
+         */
+        [[nodiscard]] bool isDirty() const;
+
+        /**
+         * @brief Registers a typed handle of a setting.
+         *
+         * The slot of the key is resolved here, so reading it through the handle does not look
+         * the key up again. Registering a key twice returns a handle to the same slot.
+         *
+         * @tparam T The type of the setting value.
+         * @param name The key of the setting.
+         * @param defaultValue The value read while the setting is not stored.
+         * @return The handle of the setting.
+         */
+        template <typename T> [[nodiscard]] SettingKey<T> registerKey(const QString &name, T defaultValue = T{})
+        {
+            return SettingKey<T>(registerSlot(name, QMetaType::fromType<T>()), name, std::move(defaultValue));
+        }
+
+        /**
+         * @brief Retrieves the last published snapshot, from any thread and without locks.
+         * @return The snapshot, it stays valid while the caller holds it.
+         */
+        [[nodiscard]] std::shared_ptr<const SettingsSnapshot> snapshot() const;
+
+        /**
+         * @brief Reads a setting from the last published snapshot, from any thread and without locks.
+         * @tparam T The type of the setting value.
+         * @param key The handle of the setting.
+         * @return The value, or the default value of the key if it is not stored.
+         */
+        template <typename T> [[nodiscard]] T get(const SettingKey<T> &key) const
+        {
+            return snapshot()->value(key);
+        }
+
     protected:
+        /**
+         * @brief Publishes a new snapshot built from the current values of the registered keys.
+         *
+         * Called by the derived classes once the values are read or written, the readers holding
+         * the previous snapshot keep it until they release it.
+         */
+        void publish();
+
+        /**
+         * @brief Forgets the tracked changes, called once they are stored.
+         */
+        void markClean();
+
         QMap<QString, QVariant> m_values; ///< A map storing the settings with their respective keys.
+        QSet<QString>           m_dirty; ///< Keys changed since the last read() or write().
+        QSet<QString>           m_removed; ///< Keys removed since the last read() or write().
+
+    private:
+        /**
+         * @brief Registered key of the snapshots.
+         */
+        struct Slot
+        {
+            QString   name; ///< Key of the setting.
+            QMetaType type; ///< Type the value is converted to.
+        };
+
+        /**
+         * @brief Resolves the slot of a key, registering it and publishing a new snapshot if it is new.
+         * @param name The key of the setting.
+         * @param type The type of the setting value.
+         * @return The slot index.
+         */
+        qsizetype registerSlot(const QString &name, QMetaType type);
+
+        QVector<Slot>             m_slots; ///< Registered keys by slot.
+        QHash<QString, qsizetype> m_slotIndexes; ///< Slot of each registered key.
+        quint64                   m_version = 0; ///< Number of the last published snapshot.
+#if defined(__cpp_lib_atomic_shared_ptr)
+        std::atomic<std::shared_ptr<const SettingsSnapshot>> m_snapshot{
+                std::make_shared<const SettingsSnapshot>()}; ///< Last published snapshot.
+#else
+        // Accessed through std::atomic_load/std::atomic_store where std::atomic<std::shared_ptr> is missing
+        std::shared_ptr<const SettingsSnapshot> m_snapshot{
+                std::make_shared<const SettingsSnapshot>()}; ///< Last published snapshot.
+#endif
     };
 
 } // namespace core::settings
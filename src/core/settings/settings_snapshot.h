@@ -0,0 +1,130 @@
+/**
+ * @file settings_snapshot.h
+ * @brief Header file for the SettingKey and SettingsSnapshot classes.
+ *
+ * This file declares the typed handles of the settings and the immutable snapshot they are
+ * read from, so hot paths on any thread can read a setting without locks nor string lookups.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QString>
+#include <QVariant>
+#include <QVector>
+
+namespace core::settings
+{
+
+    /**
+     * @class SettingKey
+     * @brief Typed handle of a setting, resolved once to its slot in the snapshots.
+     *
+     * Handles are obtained from Settings::registerKey() and are cheap to copy, keep them in
+     * the objects that read the setting.
+     *
+     * @tparam T The type of the setting value.
+     */
+    template <typename T> class SettingKey
+    {
+    public:
+        /**
+         * @brief Retrieves the slot of the setting in the snapshots.
+         * @return The slot index.
+         */
+        [[nodiscard]] qsizetype slot() const
+        {
+            return m_slot;
+        }
+
+        /**
+         * @brief Retrieves the key of the setting.
+         * @return The key.
+         */
+        [[nodiscard]] const QString &name() const
+        {
+            return m_name;
+        }
+
+        /**
+         * @brief Retrieves the value used when the setting is not stored.
+         * @return The default value.
+         */
+        [[nodiscard]] const T &defaultValue() const
+        {
+            return m_defaultValue;
+        }
+
+    private:
+        friend class Settings;
+
+        SettingKey(const qsizetype slot, QString name, T defaultValue) :
+            m_slot(slot), m_name(std::move(name)), m_defaultValue(std::move(defaultValue))
+        {
+        }
+
+        qsizetype m_slot; ///< Slot of the setting in the snapshots.
+        QString   m_name; ///< Key of the setting.
+        T         m_defaultValue; ///< Value used when the setting is not stored.
+    };
+
+    /**
+     * @class SettingsSnapshot
+     * @brief Immutable copy of the registered settings, indexed by slot.
+     *
+     * The values are converted to the type of their key when the snapshot is built, so reading
+     * one is an index into a vector. A snapshot never changes once published, the writers
+     * publish a new one instead.
+     */
+    class SettingsSnapshot
+    {
+    public:
+        SettingsSnapshot() = default;
+
+        /**
+         * @brief Constructs a snapshot.
+         * @param values The value of each slot, invalid for the settings not stored.
+         * @param version Number of the publication, increasing.
+         */
+        SettingsSnapshot(QVector<QVariant> values, const quint64 version) :
+            m_values(std::move(values)), m_version(version)
+        {
+        }
+
+        /**
+         * @brief Retrieves the value of a setting.
+         * @tparam T The type of the setting value.
+         * @param key The handle of the setting.
+         * @return The value, or the default value of the key if it is not stored.
+         */
+        template <typename T> [[nodiscard]] T value(const SettingKey<T> &key) const
+        {
+            if (key.slot() < m_values.size())
+            {
+                if (const auto &value = m_values[key.slot()]; value.isValid())
+                {
+                    return value.template value<T>();
+                }
+            }
+            return key.defaultValue();
+        }
+
+        /**
+         * @brief Retrieves the number of the publication.
+         * @return The version, 0 for the initial empty snapshot.
+         */
+        [[nodiscard]] quint64 version() const
+        {
+            return m_version;
+        }
+
+    private:
+        QVector<QVariant> m_values; ///< Value of each slot.
+        quint64           m_version = 0; ///< Number of the publication.
+    };
+
+} // namespace core::settings
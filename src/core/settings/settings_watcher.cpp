@@ -0,0 +1,53 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include "settings_watcher.h"
+
+#include <QDebug>
+
+namespace core::settings
+{
+
+    SettingsWatcher::SettingsWatcher(SQLiteSettings &settings, const std::chrono::milliseconds interval,
+                                     QObject *parent) :
+        QObject(parent), m_settings(settings), m_timer(this)
+    {
+        m_settings.enableChangeFeed();
+        m_timer.setInterval(interval);
+        connect(&m_timer, &QTimer::timeout, this, &SettingsWatcher::poll);
+        start();
+    }
+
+    void SettingsWatcher::start()
+    {
+        m_timer.start();
+    }
+
+    void SettingsWatcher::stop()
+    {
+        m_timer.stop();
+    }
+
+    void SettingsWatcher::poll()
+    {
+        QStringList changed;
+        try
+        {
+            changed = m_settings.reloadChanges();
+        }
+        catch (const db::SQLError &error)
+        {
+            // A busy or locked database is retried on the next poll
+            qWarning() << "Failed to reload the settings:" << error.what();
+            return;
+        }
+        for (const auto &key: changed)
+        {
+            emit settingChanged(key, m_settings.value(key));
+        }
+    }
+
+} // namespace core::settings
@@ -0,0 +1,80 @@
+/**
+ * @file settings_watcher.h
+ * @brief Header file for the SettingsWatcher class.
+ *
+ * This file declares the SettingsWatcher class, which reloads the settings changed by other
+ * processes and notifies every changed key through a Qt signal.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+#include <chrono>
+#include "dllexports.h"
+#include "sqlite_settings.h"
+
+namespace core::settings
+{
+
+    /**
+     * @class SettingsWatcher
+     * @brief Polls the change feed of a SQLiteSettings and signals the changed keys.
+     *
+     * The watcher enables the change feed of the settings and calls
+     * SQLiteSettings::reloadChanges() on a timer, so it must live in the thread that owns the
+     * settings connection. Readers on other threads see the reloaded values in the published
+     * snapshot.
+     */
+    class CORE_API SettingsWatcher final : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        static constexpr std::chrono::milliseconds DEFAULT_INTERVAL{1000}; ///< Default polling interval.
+
+        /**
+         * @brief Constructs a watcher and starts polling.
+         * @param settings The settings to keep up to date, they must outlive the watcher.
+         * @param interval The polling interval.
+         * @param parent The parent object.
+         * @throws SQLError if the change feed cannot be enabled.
+         */
+        explicit SettingsWatcher(SQLiteSettings &settings, std::chrono::milliseconds interval = DEFAULT_INTERVAL,
+                                 QObject *parent = nullptr);
+
+        /**
+         * @brief Starts polling.
+         */
+        void start();
+
+        /**
+         * @brief Stops polling.
+         */
+        void stop();
+
+    public slots:
+        /**
+         * @brief Reloads the changed settings now, emitting settingChanged() for each one.
+         */
+        void poll();
+
+    signals:
+        /**
+         * @brief Emitted for every key changed by another connection.
+         * @param key The key of the setting.
+         * @param value The new value, invalid if the setting was removed.
+         */
+        void settingChanged(const QString &key, const QVariant &value);
+
+    private:
+        SQLiteSettings &m_settings; ///< The watched settings.
+        QTimer          m_timer; ///< Timer of the polling.
+    };
+
+} // namespace core::settings
@@ -6,6 +6,9 @@
 
 #include "sqlite_settings.h"
 #include "db/sqlite/sqlite_column.h"
+#include "db/transaction.h"
+
+#include <QSqlError>
 
 namespace core::settings
 {
@@ -18,17 +21,43 @@ namespace core::settings
             std::make_shared<SQLiteColumn>("value", SQLiteColumn::SQLiteDataType::TEXT)};
 
     SQLiteSettings::SQLiteSettings(const QSqlDatabase &database, QString name) :
-        SQLSettings(database, std::move(name), settingsColumns)
+        SQLSettings(database, name, settingsColumns), m_name(std::move(name)), m_changeLog(m_name + "_changes")
     {
         m_table.create();
     }
 
     bool SQLiteSettings::write()
     {
-        for (auto it = m_values.cbegin(); it != m_values.cend(); ++it)
+        if (!isDirty())
+        {
+            return true;
+        }
+
+        Transaction transaction(m_table.database());
+        if (!m_removed.isEmpty())
+        {
+            QVariantList names;
+            for (const auto &key: m_removed)
+            {
+                names << key;
+            }
+            m_table.removeRows(std::array{names});
+        }
+        if (!m_dirty.isEmpty())
         {
-            m_table.insert({{"name", it.key()}, {"value", it.value()}});
+            QVariantList names;
+            QVariantList values;
+            for (const auto &key: m_dirty)
+            {
+                names << key;
+                values << m_values.value(key);
+            }
+            // Bound by position, in the order of settingsColumns
+            m_table.upsertRows(std::array{names, values});
         }
+        transaction.commit();
+        markClean();
+        publish();
         return true;
     }
 
@@ -37,8 +66,127 @@ namespace core::settings
         auto records = m_table.select();
         for (QSqlRecord &record: records)
         {
-            m_values[record.value("name").toString()] = record.value("value");
+            const auto key = record.value("name").toString();
+            m_values[key]  = record.value("value");
+            // The stored value replaces the pending change
+            m_dirty.remove(key);
+            m_removed.remove(key);
         }
+        publish();
         return true;
     }
+
+    void SQLiteSettings::enableChangeFeed()
+    {
+        // The row whose key is recorded by each trigger
+        static constexpr std::pair<const char *, const char *> triggers[] = {
+                {"INSERT", "NEW"}, {"UPDATE", "NEW"}, {"DELETE", "OLD"}};
+
+        Transaction transaction(m_table.database());
+        exec(QString("CREATE TABLE IF NOT EXISTS %1 (seq INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT NOT NULL);")
+                     .arg(m_changeLog));
+        for (const auto &[event, row]: triggers)
+        {
+            exec(QString("CREATE TRIGGER IF NOT EXISTS %1_%2 AFTER %2 ON %3 "
+                         "BEGIN INSERT INTO %1 (name) VALUES (%4.name); END;")
+                         .arg(m_changeLog, event, m_name, row));
+        }
+        auto last = exec(QString("SELECT IFNULL(MAX(seq), 0) FROM %1;").arg(m_changeLog));
+        m_lastChange = last.next() ? last.value(0).toLongLong() : 0;
+        transaction.commit();
+
+        m_dataVersion = dataVersion();
+        m_changeFeed  = true;
+    }
+
+    QStringList SQLiteSettings::reloadChanges()
+    {
+        QStringList changed;
+        if (!m_changeFeed)
+        {
+            return changed;
+        }
+        const auto version = dataVersion();
+        if (version == m_dataVersion)
+        {
+            return changed;
+        }
+        m_dataVersion = version;
+
+        // The keys written through this connection are in the log too, they are filtered out
+        // below as their stored value is the one already loaded.
+        QSet<QString> keys;
+        auto          first = exec(QString("SELECT IFNULL(MIN(seq), 0) FROM %1;").arg(m_changeLog));
+        if (first.next() && first.value(0).toLongLong() > m_lastChange + 1)
+        {
+            // The entries since the last reload were pruned, compare every key
+            for (const auto &record: m_table.select())
+            {
+                keys.insert(record.value("name").toString());
+            }
+            for (auto it = m_values.cbegin(); it != m_values.cend(); ++it)
+            {
+                keys.insert(it.key());
+            }
+        }
+        auto log = exec(QString("SELECT seq, name FROM %1 WHERE seq > %2 ORDER BY seq;")
+                                .arg(m_changeLog)
+                                .arg(m_lastChange));
+        while (log.next())
+        {
+            m_lastChange = log.value(0).toLongLong();
+            keys.insert(log.value(1).toString());
+        }
+
+        // The values are compared as text, the type the column stores them with
+        for (const auto &key: keys)
+        {
+            if (m_dirty.contains(key) || m_removed.contains(key))
+            {
+                continue;
+            }
+            const auto records = m_table.selectByKey(DynamicTable::row(key));
+            if (records.isEmpty())
+            {
+                if (m_values.remove(key) > 0)
+                {
+                    changed << key;
+                }
+            }
+            else if (const auto value = records.first().value("value");
+                     !m_values.contains(key) || m_values.value(key).toString() != value.toString())
+            {
+                m_values[key] = value;
+                changed << key;
+            }
+        }
+        if (m_lastChange > CHANGE_LOG_SIZE)
+        {
+            exec(QString("DELETE FROM %1 WHERE seq <= %2;").arg(m_changeLog).arg(m_lastChange - CHANGE_LOG_SIZE));
+        }
+
+        if (!changed.isEmpty())
+        {
+            publish();
+        }
+        return changed;
+    }
+
+    QSqlQuery SQLiteSettings::exec(const QString &sql) const
+    {
+        QSqlQuery query(m_table.database());
+        query.setForwardOnly(true);
+        if (!query.exec(sql))
+        {
+            throw SQLError(query.lastError().text());
+        }
+        return query;
+    }
+
+    qint64 SQLiteSettings::dataVersion() const
+    {
+        auto query = exec("PRAGMA data_version;");
+        return query.next() ? query.value(0).toLongLong() : -1;
+    }
+
 } // namespace core::settings
@@ -10,6 +10,8 @@
 #pragma once
 
 // Include necessary headers
+#include <QSqlQuery>
+#include <QStringList>
 #include "db/dynamic_table.h"
 #include "sql_settings.h"
 
@@ -51,8 +53,8 @@ namespace core::settings
         /**
          * @brief Implements the write function to store settings in the SQLite database.
          *
-         * This function writes the current settings to the SQLite database. It must be implemented
-         * in this class, as it is a pure virtual function in the base class `SQLSettings`.
+         * Only the keys changed or removed since the last read() or write() are stored, the changed
+         * ones through an UPSERT and the removed ones through a DELETE, inside a single transaction.
          *
          * @return A boolean value indicating whether the write operation was successful (`true`) or not (`false`).
          */
@@ -67,6 +69,53 @@ namespace core::settings
          * @return A boolean value indicating whether the read operation was successful (`true`) or not (`false`).
          */
         bool read() override;
+
+        /**
+         * @brief Enables the change feed, so the changes made by other connections can be reloaded.
+         *
+         * Creates, if they do not exist yet, a change log table and the triggers that record in it
+         * the key of every row inserted, updated or deleted by any connection or process. Call it
+         * before read() so no change is missed between both calls.
+         *
+         * @throws SQLError if the change log cannot be created.
+         */
+        void enableChangeFeed();
+
+        /**
+         * @brief Reloads the rows changed by other connections since the last call.
+         *
+         * Polls `PRAGMA data_version`, which only changes when another connection commits, so an
+         * idle database costs one pragma. Otherwise only the keys recorded in the change log are
+         * selected, the keys with changes not written yet keep their local value. A new snapshot
+         * is published when any value changes.
+         *
+         * @return The keys whose value changed or that were removed.
+         * @throws SQLError if the change log cannot be read.
+         */
+        QStringList reloadChanges();
+
+    private:
+        static constexpr qint64 CHANGE_LOG_SIZE = 1024; ///< Entries kept in the change log.
+
+        /**
+         * @brief Runs a query on the settings connection.
+         * @param sql The SQL text.
+         * @return The executed query, positioned before its first row.
+         * @throws SQLError if the query fails.
+         */
+        QSqlQuery exec(const QString &sql) const;
+
+        /**
+         * @brief Reads the current data version of the connection.
+         * @return The value of `PRAGMA data_version`.
+         */
+        qint64 dataVersion() const;
+
+        QString m_name; ///< Name of the settings table.
+        QString m_changeLog; ///< Name of the change log table.
+        bool    m_changeFeed  = false; ///< true once enableChangeFeed() was called.
+        qint64  m_dataVersion = -1; ///< Data version seen by the last reload.
+        qint64  m_lastChange  = 0; ///< Last change log entry reloaded.
     };
 
 } // namespace core::settings
@@ -9,14 +9,44 @@
 
 #include "db_class.h"
 #include <QProcess>
+#include <QRegularExpression>
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
+#include <algorithm>
+#include <array>
 #include <ranges>
 #include "db/factory.h"
 #include "fmt/args.h"
 #include "source_template.cpp"
 #include "tools/tools.h"
 
+namespace
+{
+    /**
+     * @brief Retrieves the name of a SQLiteDataType enumerator, as written in the generated code.
+     */
+    QString dataTypeName(const core::db::SQLiteColumn::SQLiteDataType type)
+    {
+        switch (type)
+        {
+            case core::db::SQLiteColumn::SQLiteDataType::INTEGER:
+                return "INTEGER";
+            case core::db::SQLiteColumn::SQLiteDataType::REAL:
+                return "REAL";
+            case core::db::SQLiteColumn::SQLiteDataType::BLOB:
+                return "BLOB";
+            case core::db::SQLiteColumn::SQLiteDataType::NULL_TYPE:
+                return "NULL_TYPE";
+            case core::db::SQLiteColumn::SQLiteDataType::BOOLEAN:
+                return "BOOLEAN";
+            case core::db::SQLiteColumn::SQLiteDataType::DATETIME:
+                return "DATETIME";
+            default:
+                return "TEXT";
+        }
+    }
+} // namespace
+
 DBClass::DBClass(const QSqlDatabase &database, const bool verbose) :
     m_verbose(verbose), m_database(database), m_builder(core::db::Factory::builder(m_database.driverName()))
 {
@@ -62,6 +92,29 @@ void DBClass::loadTable(const QJsonObject &table)
             qDebug() << "Parsed table definition:" << column;
         }
     }
+    loadIndexes(table[DBClass::INDEXES].toArray());
+}
+
+void DBClass::loadIndexes(const QJsonArray &indexes)
+{
+    const auto &schema = m_builder->schema();
+    for (const auto &value: indexes)
+    {
+        const auto object = value.toObject();
+        auto       index  = indexFromJSON(object);
+        const auto named  = [&index, &schema](const qsizetype column)
+        { return schema.attribute(column, core::db::TableSchema::Attribute::Index) == index.name; };
+        if (schema.findIndex(index.name) != nullptr ||
+            std::ranges::any_of(std::views::iota(qsizetype{0}, schema.size()), named))
+        {
+            throw InvalidJSON(QString("Duplicated index in '%1': %2").arg(DBClass::INDEXES, index.name));
+        }
+        m_builder->addIndex(std::move(index));
+        if (m_verbose)
+        {
+            qDebug() << "Parsed index definition:" << object;
+        }
+    }
 }
 
 void DBClass::loadStatements(const QJsonArray &statements)
@@ -70,7 +123,16 @@ void DBClass::loadStatements(const QJsonArray &statements)
     for (const auto &statement: statements)
     {
         auto object = statement.toObject();
-        m_statements.push_back(statementFromJSON(object));
+        auto parsed = statementFromJSON(object);
+        m_statements.push_back(parsed);
+        // A SELECT of several rows is also paginated
+        if (parsed && parsed->type() == Statement::SQLTypes::select && !parsed->isUnique())
+        {
+            if (auto page = pageStatementFromJSON(object, *parsed))
+            {
+                m_statements.push_back(std::move(page));
+            }
+        }
         if (m_verbose)
         {
             qDebug() << "Parsed SQL statement definition:" << object;
@@ -95,6 +157,13 @@ void DBClass::loadDefaultSentences()
                                                        Statement::SQLTypes::select));
     m_statements.push_back(std::make_shared<Statement>(DEFAULT_STATEMENT_COUNT, m_builder->createSelectCount(), true,
                                                        Statement::SQLTypes::count));
+    if (const auto key = m_builder->pageKey(); !key.isEmpty())
+    {
+        m_statements.push_back(std::make_shared<Statement>(DEFAULT_STATEMENT_PAGE,
+                                                           m_builder->createSelectPage(key, false),
+                                                           m_builder->createSelectPage(key, true), QVector<QString>{},
+                                                           key));
+    }
 }
 
 void DBClass::load(const QJsonDocument &document)
@@ -135,14 +204,42 @@ void DBClass::load(const QJsonDocument &document)
     {
         loadDefaultSentences();
     }
+
+    if (rootObj.contains(DBClass::EAGER_STATEMENTS))
+    {
+        loadEagerStatements(rootObj[DBClass::EAGER_STATEMENTS].toArray());
+    }
+}
+
+void DBClass::loadEagerStatements(const QJsonArray &names)
+{
+    for (const auto &value: names)
+    {
+        const auto name = value.toString();
+        const auto it   = std::ranges::find_if(m_statements, [&name](const std::shared_ptr<Statement> &statement)
+                                               { return statement && statement->name() == name; });
+        if (it == m_statements.end() || (*it)->type() == Statement::SQLTypes::create)
+        {
+            throw InvalidJSON(QString("Unknown statement in 'eager_statements': %1").arg(name));
+        }
+        (*it)->setEager(true);
+        if (m_verbose)
+        {
+            qDebug() << "Eager statement:" << name;
+        }
+    }
 }
 
 QString DBClass::getHeaderFile() const
 {
-    const std::string recordStruct =
-            std::accumulate(m_builder->columns().begin(), m_builder->columns().end(), std::string{},
-                            [](const std::string &acc, const std::shared_ptr<core::db::Column> &column)
-                            { return acc + column->columnToCppType().toStdString(); });
+    const auto &schema = m_builder->schema();
+    std::string recordStruct;
+    for (qsizetype column = 0; column < schema.size(); column++)
+    {
+        const auto type = core::db::SQLiteColumn::fromSQLiteType(schema.dataType(column));
+        recordStruct += fmt::format("{} m_{};\n", core::db::SQLiteColumn::dataTypeToCppType(type).toStdString(),
+                                    schema.name(column).toStdString());
+    }
     const std::string signatures =
             std::accumulate(m_statements.begin(), m_statements.end(), std::string{},
                             [](const std::string &acc, const std::shared_ptr<Statement> &statement)
@@ -156,7 +253,16 @@ QString DBClass::getHeaderFile() const
     const std::string sqlQuery =
             std::accumulate(m_statements.begin(), m_statements.end(), std::string{},
                             [&](const std::string &acc, const std::shared_ptr<Statement> &statement)
-                            { return acc + statement->sqlQuery().toStdString(); });
+                            {
+                                auto query = acc + statement->sqlQuery().toStdString();
+                                if (statement->type() == Statement::SQLTypes::select ||
+                                    statement->type() == Statement::SQLTypes::page)
+                                {
+                                    query += fmt::format("std::array<int, {}> m_{}Fields{{-1}};\n",
+                                                         schema.size(), statement->name().toStdString());
+                                }
+                                return query;
+                            });
 
     fmt::dynamic_format_arg_store<fmt::format_context> headerArgs;
     headerArgs.push_back(fmt::arg("header_parent_class_name", m_builder->headerParentClass().toStdString()));
@@ -166,6 +272,7 @@ QString DBClass::getHeaderFile() const
     headerArgs.push_back(fmt::arg("record", recordStruct));
     headerArgs.push_back(fmt::arg("public_signatures", signatures));
     headerArgs.push_back(fmt::arg("sentences", sentences));
+    headerArgs.push_back(fmt::arg("columns", getColumnDescriptors()));
     headerArgs.push_back(fmt::arg("sql_query", sqlQuery));
 
     const auto headerInput  = getHeaderTemplate();
@@ -175,13 +282,6 @@ QString DBClass::getHeaderFile() const
 
 QString DBClass::getSourceFile() const
 {
-    const std::string attributes =
-            std::accumulate(m_statements.begin(), m_statements.end(), std::string{},
-                            [&](const std::string &acc, const std::shared_ptr<Statement> &statement)
-                            {
-                                const std::string separator = (&statement == &m_statements.back()) ? "" : ",";
-                                return acc + statement->attributes().toStdString() + separator;
-                            });
     const std::string prepare             = std::accumulate(m_statements.begin(), m_statements.end(), std::string{},
                                                             [&](const std::string &acc, const std::shared_ptr<Statement> &statement)
                                                             { return acc + statement->prepare().toStdString(); });
@@ -196,7 +296,6 @@ QString DBClass::getSourceFile() const
     sourceArguments.push_back(fmt::arg("table_name", m_builder->name().toStdString()));
     sourceArguments.push_back(fmt::arg("class_name", m_className.toStdString()));
     sourceArguments.push_back(fmt::arg("parent_class_name", m_builder->parentClass().toStdString()));
-    sourceArguments.push_back(fmt::arg("attributes", attributes));
     sourceArguments.push_back(fmt::arg("prepare", prepare));
     sourceArguments.push_back(fmt::arg("create_sentences_size", createSentencesSize));
     sourceArguments.push_back(fmt::arg("create_sentences", createSentences));
@@ -209,99 +308,217 @@ QString DBClass::getSourceFile() const
 
 std::string DBClass::getAutoincrement(const std::shared_ptr<Statement> &shared) const
 {
+    const auto &schema = m_builder->schema();
     std::string autoincrement;
-    for (const auto &item: m_builder->columns())
+    for (qsizetype column = 0; column < schema.size(); column++)
     {
-        const auto column = std::dynamic_pointer_cast<core::db::SQLiteColumn>(item);
-        if (column->hasModifier(core::db::SQLiteModifier::isAutoIncrement))
+        if (schema.hasModifier(column, core::db::SQLiteModifier::isAutoIncrement))
         {
-            autoincrement = QString("record.m_%1 = getLastInsertRowId();").arg(column->columnName()).toStdString();
+            autoincrement = QString("record.m_%1 = lastInsertRowId(*m_%2);")
+                                    .arg(schema.name(column), shared->name())
+                                    .toStdString();
         }
     }
     return autoincrement;
 }
 
-std::string DBClass::getBindFields(const std::shared_ptr<Statement> &statement) const
+QVector<QString> DBClass::getBoundColumns(const std::shared_ptr<Statement> &statement) const
 {
-    auto getBindField = [&](const QString &statementName, const QString &columnName) -> std::string
-    {
-        auto name   = statementName.toStdString();
-        auto column = columnName.toStdString();
-        return fmt::format("m_{}.bindValue(\":{}\", record.m_{});", name, column, column);
-    };
-
+    QVector<QString> columns;
     switch (statement->type())
     {
         case Statement::SQLTypes::create:
             break;
         case Statement::SQLTypes::insert:
-            return std::accumulate(
-                    m_builder->columns().begin(), m_builder->columns().end(), std::string{},
-                    [&](const std::string &acc, const std::shared_ptr<core::db::Column> &column)
-                    {
-                        if (column->hasModifier(static_cast<unsigned int>(core::db::SQLiteModifier::isAutoIncrement)) ||
-                            column->defaultValue() != std::nullopt)
-                        {
-                            return acc;
-                        }
-                        return acc + getBindField(statement->name(), column->columnName());
-                    });
-        case Statement::SQLTypes::select:
-        case Statement::SQLTypes::count:
+        {
+            const auto &schema = m_builder->schema();
+            for (qsizetype column = 0; column < schema.size(); column++)
+            {
+                if (!schema.hasModifier(column, core::db::SQLiteModifier::isAutoIncrement) &&
+                    !schema.hasAttribute(column, core::db::TableSchema::Attribute::Default))
+                {
+                    columns.append(schema.name(column));
+                }
+            }
+            break;
+        }
         case Statement::SQLTypes::update:
         case Statement::SQLTypes::deleteRow:
-            auto list = statement->whereFields();
-            return std::accumulate(list.begin(), list.end(), std::string{},
-                                   [&](const std::string &acc, const QString &columnName)
-                                   { return acc + getBindField(statement->name(), columnName); });
+        case Statement::SQLTypes::select:
+        {
+            // The SET columns, the primary key of the default sentences or the WHERE fields, take them from the SQL
+            static const QRegularExpression placeholder(R"(:(\w+))");
+            auto                            it = placeholder.globalMatch(statement->sql());
+            while (it.hasNext())
+            {
+                const auto columnName = it.next().captured(1);
+                if (!columns.contains(columnName))
+                {
+                    columns.append(columnName);
+                }
+            }
+            break;
+        }
+        case Statement::SQLTypes::count:
+        case Statement::SQLTypes::page:
+            columns = statement->whereFields();
+            break;
     }
-    return {};
+    return columns;
 }
 
-std::string DBClass::getRecordToFields(const std::shared_ptr<Statement> &statement) const
+std::string DBClass::getBindFields(const std::shared_ptr<Statement> &statement, const std::string &sqlQuery) const
 {
-    std::string result;
-    for (const auto &item: m_builder->columns())
+    const auto columns = getBoundColumns(statement);
+    return std::accumulate(columns.begin(), columns.end(), std::string{},
+                           [&](const std::string &acc, const QString &columnName)
+                           {
+                               const auto column = columnName.toStdString();
+                               return acc + fmt::format("{}->bindValue(\":{}\", record.m_{});", sqlQuery, column,
+                                                        column);
+                           });
+}
+
+QString DBClass::batchMethod(const std::shared_ptr<Statement> &statement) const
+{
+    const auto  sqlQuery = QString("m_%1").arg(statement->name()).toStdString();
+    std::string declare;
+    std::string append;
+    std::string bind;
+    for (const auto &columnName: getBoundColumns(statement))
     {
-        const auto column = std::dynamic_pointer_cast<core::db::SQLiteColumn>(item);
-        auto       name   = column->columnName().toStdString();
+        const auto column = columnName.toStdString();
+        declare += fmt::format("QVariantList {}Values;\n{}Values.reserve(static_cast<qsizetype>(records.size()));\n",
+                               column, column);
+        append += fmt::format("{}Values << record.m_{};\n", column, column);
+        bind += fmt::format("{}->bindValue(\":{}\", {}Values);\n", sqlQuery, column, column);
+    }
 
-        switch (column->columnType())
+    std::string recoverAutoincrement;
+    if (statement->type() == Statement::SQLTypes::insert)
+    {
+        const auto &schema = m_builder->schema();
+        for (qsizetype column = 0; column < schema.size(); column++)
         {
-            case core::db::SQLiteColumn::SQLiteDataType::INTEGER:
-                result += fmt::format("record.m_{} = sqlRecord.value(\"{}\").toLongLong();\n", name, name);
-                break;
-            case core::db::SQLiteColumn::SQLiteDataType::REAL:
-                result += fmt::format("record.m_{} = sqlRecord.value(\"{}\").toDouble();\n", name, name);
-                break;
-            case core::db::SQLiteColumn::SQLiteDataType::BLOB:
-                result += fmt::format("record.m_{} = sqlRecord.value(\"{}\").toByteArray();\n", name, name);
-                break;
-            case core::db::SQLiteColumn::SQLiteDataType::BOOLEAN:
-                result += fmt::format("record.m_{} = sqlRecord.value(\"{}\").toBool();\n", name, name);
-                break;
-            case core::db::SQLiteColumn::SQLiteDataType::DATETIME:
-                result += fmt::format("record.m_{} = sqlRecord.value(\"{}\").toDateTime();\n", name, name);
-                break;
-            default:
-                result += fmt::format("record.m_{} = sqlRecord.value(\"{}\").toString();\n", name, name);
-                break;
+            if (schema.hasModifier(column, core::db::SQLiteModifier::isAutoIncrement))
+            {
+                recoverAutoincrement = fmt::format(
+                        "// The batch runs inside one transaction, so its rows get consecutive ids\n"
+                        "auto lastId = lastInsertRowId(*{}) - static_cast<long long>(records.size());\n"
+                        "for (auto& record : records)\n{{\nrecord.m_{} = ++lastId;\n}}\n",
+                        sqlQuery, schema.name(column).toStdString());
+            }
         }
     }
+
+    fmt::dynamic_format_arg_store<fmt::format_context> sourceArguments;
+    sourceArguments.push_back(fmt::arg("table_name", m_builder->name().toStdString()));
+    sourceArguments.push_back(fmt::arg("class_name", m_className.toStdString()));
+    sourceArguments.push_back(fmt::arg("method_name", statement->name().toStdString()));
+    sourceArguments.push_back(fmt::arg("sql_query", sqlQuery));
+    sourceArguments.push_back(fmt::arg("ensure_prepared", statement->ensurePrepared().toStdString()));
+    sourceArguments.push_back(fmt::arg("batch_declare", declare));
+    sourceArguments.push_back(fmt::arg("batch_append", append));
+    sourceArguments.push_back(fmt::arg("batch_bind", bind));
+    sourceArguments.push_back(fmt::arg("recover_batch_autoincrement", recoverAutoincrement));
+    const auto sourceOutput = fmt::vformat(getBatchMethod(), sourceArguments);
+
+    return sourceOutput.c_str();
+}
+
+std::string DBClass::getRecordToFields(const std::string &sqlQuery, const std::string &record) const
+{
+    std::string result;
+    std::size_t ordinal = 0;
+    for (const auto &columnName: m_builder->schema().names())
+    {
+        // The conversion is chosen at compile time from the type of the column descriptor
+        result += fmt::format("{}.m_{} = fromVariant<COLUMNS[{}].type>({}->value(fields[{}]));\n", record,
+                              columnName.toStdString(), ordinal, sqlQuery, ordinal);
+        ordinal++;
+    }
     return result;
 }
 
+std::string DBClass::getColumnDescriptors() const
+{
+    static const std::array<std::pair<core::db::SQLiteModifier, const char *>, 5> modifierNames = {
+            {{core::db::SQLiteModifier::isPrimaryKey, "isPrimaryKey"},
+             {core::db::SQLiteModifier::isAutoIncrement, "isAutoIncrement"},
+             {core::db::SQLiteModifier::isUnique, "isUnique"},
+             {core::db::SQLiteModifier::isNotNull, "isNotNull"},
+             {core::db::SQLiteModifier::isImmutable, "isImmutable"}}};
+
+    const auto &schema = m_builder->schema();
+    QStringList descriptors;
+    for (qsizetype column = 0; column < schema.size(); column++)
+    {
+        QStringList modifiers;
+        for (const auto &[modifier, name]: modifierNames)
+        {
+            if (schema.hasModifier(column, modifier))
+            {
+                modifiers << QString("Modifier::%1").arg(name);
+            }
+        }
+        if (modifiers.isEmpty())
+        {
+            modifiers << "Modifier::None";
+        }
+        descriptors << QString("{\"%1\", DataType::%2, %3, %4}")
+                               .arg(schema.name(column),
+                                    dataTypeName(static_cast<core::db::SQLiteColumn::SQLiteDataType>(
+                                            schema.typeCode(column))))
+                               .arg(descriptors.size())
+                               .arg(modifiers.join(" | "));
+    }
+    return fmt::format("static constexpr std::array<core::db::ColumnDescriptor, {}> COLUMNS = {{{{{}}}}};\n",
+                       descriptors.size(), descriptors.join(", ").toStdString());
+}
+
+QString DBClass::pageMethod(const std::shared_ptr<Statement> &statement) const
+{
+    std::string afterToBind;
+    for (const auto &columnName: statement->pageKey())
+    {
+        const auto column = columnName.toStdString();
+        afterToBind += fmt::format("query->bindValue(\"{}{}\", after->m_{});\n", core::db::SQLBuilder::AFTER, column,
+                                   column);
+    }
+
+    fmt::dynamic_format_arg_store<fmt::format_context> sourceArguments;
+    sourceArguments.push_back(fmt::arg("class_name", m_className.toStdString()));
+    sourceArguments.push_back(fmt::arg("method_name", statement->name().toStdString()));
+    sourceArguments.push_back(
+            fmt::arg("record_parameter", statement->whereFields().isEmpty() ? "" : "const Record& record, "));
+    sourceArguments.push_back(fmt::arg("ensure_prepared", statement->ensurePrepared().toStdString()));
+    sourceArguments.push_back(fmt::arg("record_to_bind", getBindFields(statement, "query")));
+    sourceArguments.push_back(fmt::arg("after_to_bind", afterToBind));
+    sourceArguments.push_back(fmt::arg("page_size", core::db::SQLBuilder::PAGE_SIZE));
+    sourceArguments.push_back(fmt::arg("record_to_structure", getRecordToFields("query", "row")));
+    const auto sourceOutput = fmt::vformat(getPageMethod(), sourceArguments);
+
+    return sourceOutput.c_str();
+}
+
 QString DBClass::method(const std::shared_ptr<Statement> &statement) const
 {
+    if (statement->type() == Statement::SQLTypes::page)
+    {
+        return pageMethod(statement);
+    }
+
     const char       *sourceInput          = nullptr;
-    const std::string recordToFields       = getRecordToFields(statement);
     const auto        sqlQuery             = QString("m_%1").arg(statement->name());
-    const std::string recordToBind         = getBindFields(statement);
+    const std::string recordToFields       = getRecordToFields(sqlQuery.toStdString(), "record");
+    const std::string recordToBind         = getBindFields(statement, sqlQuery.toStdString());
     const std::string recoverAutoincrement = getAutoincrement(statement);
 
     fmt::dynamic_format_arg_store<fmt::format_context> sourceArguments;
+    sourceArguments.push_back(fmt::arg("table_name", m_builder->name().toStdString()));
     sourceArguments.push_back(fmt::arg("class_name", m_className.toStdString()));
     sourceArguments.push_back(fmt::arg("method_name", statement->name().toStdString()));
+    sourceArguments.push_back(fmt::arg("ensure_prepared", statement->ensurePrepared().toStdString()));
     sourceArguments.push_back(fmt::arg("record_to_bind", recordToBind));
     sourceArguments.push_back(fmt::arg("recover_autoincrement", recoverAutoincrement));
     sourceArguments.push_back(fmt::arg("sql_query", sqlQuery.toStdString()));
@@ -336,6 +553,10 @@ QString DBClass::method(const std::shared_ptr<Statement> &statement) const
     }
     const auto sourceOutput = fmt::vformat(sourceInput, sourceArguments);
 
+    if (statement->type() == Statement::SQLTypes::insert || statement->type() == Statement::SQLTypes::update)
+    {
+        return QString(sourceOutput.c_str()) + batchMethod(statement);
+    }
     return sourceOutput.c_str();
 }
 
@@ -385,6 +606,68 @@ std::shared_ptr<core::db::Column> DBClass::columnFromJSON(const QJsonObject &col
                                                     checkCondition, collate);
 }
 
+core::db::TableIndex DBClass::indexFromJSON(const QJsonObject &index) const
+{
+    using Term = core::db::TableIndex::Term;
+
+    core::db::TableIndex result;
+    result.name   = index[DBClass::INDEX_NAME].toString();
+    result.unique = index[DBClass::INDEX_UNIQUE].toBool();
+    result.where  = index[DBClass::INDEX_WHERE].toString();
+
+    const auto columns = index[DBClass::INDEX_COLUMNS].toArray();
+    if (result.name.isEmpty() || columns.isEmpty())
+    {
+        throw InvalidJSON(QString("Missing required key in '%1': %2 and %3")
+                                  .arg(DBClass::INDEXES, DBClass::INDEX_NAME, DBClass::INDEX_COLUMNS));
+    }
+
+    const auto &schema      = m_builder->schema();
+    const auto  checkColumn = [&schema, &result](const QString &column)
+    {
+        if (!schema.indexOf(column).has_value())
+        {
+            throw InvalidJSON(QString("Unknown column in index %1: %2").arg(result.name, column));
+        }
+        return column;
+    };
+
+    for (const auto &value: columns)
+    {
+        // A term is the name of a column, or an object with the name or an expression and the order
+        if (value.isString())
+        {
+            result.terms.append(Term{checkColumn(value.toString())});
+            continue;
+        }
+        const auto term  = value.toObject();
+        const auto order = term[DBClass::INDEX_ORDER].toString("asc").toLower();
+        if (order != "asc" && order != "desc")
+        {
+            throw InvalidJSON(QString("Unknown order in index %1: %2").arg(result.name, order));
+        }
+        const auto expression = term.contains(DBClass::INDEX_EXPRESSION)
+                                        ? term[DBClass::INDEX_EXPRESSION].toString()
+                                        : checkColumn(term[DBClass::COLUMN_NAME].toString());
+        if (expression.isEmpty())
+        {
+            throw InvalidJSON(QString("Empty term in index %1").arg(result.name));
+        }
+        result.terms.append(Term{expression, order == "desc"});
+    }
+
+    for (const auto &value: index[DBClass::INDEX_INCLUDE].toArray())
+    {
+        result.include << checkColumn(value.toString());
+    }
+    // SQLite has no INCLUDE clause, the covering columns would become part of the unique key
+    if (result.unique && !result.include.isEmpty())
+    {
+        throw InvalidJSON(QString("The unique index %1 cannot include covering columns").arg(result.name));
+    }
+    return result;
+}
+
 std::shared_ptr<Statement> DBClass::statementFromJSON(const QJsonObject &statement) const
 {
     auto       name  = statement[DBClass::STATEMENT_NAME].toString();
@@ -402,9 +685,10 @@ std::shared_ptr<Statement> DBClass::statementFromJSON(const QJsonObject &stateme
         bool isUnique    = false;
         for (const auto &columnName: whereFields)
         {
-            auto column = m_builder->column(columnName);
-            if (column.has_value() && column.value()->hasModifier(core::db::SQLiteModifier::isUnique |
-                                                                  core::db::SQLiteModifier::isPrimaryKey))
+            const auto column = m_builder->schema().indexOf(columnName);
+            if (column.has_value() &&
+                m_builder->schema().hasModifier(column.value(), core::db::SQLiteModifier::isUnique |
+                                                                        core::db::SQLiteModifier::isPrimaryKey))
             {
                 isUnique = true;
             }
@@ -414,3 +698,22 @@ std::shared_ptr<Statement> DBClass::statementFromJSON(const QJsonObject &stateme
 
     return nullptr;
 }
+
+std::shared_ptr<Statement> DBClass::pageStatementFromJSON(const QJsonObject &statement, const Statement &select) const
+{
+    const auto index = statement[DBClass::STATEMENT_ORDER].toString();
+    const auto key   = m_builder->pageKey(index);
+    if (key.isEmpty())
+    {
+        if (!index.isEmpty())
+        {
+            throw InvalidJSON(QString("Unknown index in '%1' of %2: %3")
+                                      .arg(DBClass::STATEMENT_ORDER, select.name(), index));
+        }
+        // Without a primary key the rows have no unique key to start a page after
+        return nullptr;
+    }
+    const auto where = m_builder->pageWhere(index, statement[DBClass::STATEMENT_WHERE].toString());
+    return std::make_shared<Statement>(select.name() + "Page", m_builder->createSelectPage(key, false, where),
+                                       m_builder->createSelectPage(key, true, where), select.whereFields(), key);
+}
@@ -41,21 +41,31 @@ class DBClass final
 {
 public:
     // Constants representing JSON key literals for various database elements
-    static constexpr auto TABLE           = "table"; ///< Table information in JSON.
-    static constexpr auto TABLE_NAME      = "name"; ///< Table name in JSON.
-    static constexpr auto COLUMNS         = "columns"; ///< Columns information in JSON.
-    static constexpr auto COLUMN_NAME     = "name"; ///< Column name in JSON.
-    static constexpr auto COLUMN_TYPE     = "type"; ///< Column type in JSON.
-    static constexpr auto STATEMENTS      = "statements"; ///< SQL statements in JSON.
-    static constexpr auto STATEMENT_NAME  = "name"; ///< SQL statement name in JSON.
-    static constexpr auto STATEMENT_WHERE = "where"; ///< WHERE clause in SQL statements.
-    static constexpr auto STATEMENT_TYPE  = "type"; ///< SQL statement type (e.g., SELECT, INSERT).
-    static constexpr auto MODIFIERS       = "modifiers"; ///< Column modifiers (e.g., NOT NULL).
-    static constexpr auto INDEX           = "index"; ///< Column index in JSON.
-    static constexpr auto FOREIGN_KEY     = "foreignKey"; ///< Foreign key reference in JSON.
-    static constexpr auto CHECK_CONDITION = "checkCondition"; ///< Check condition for column.
-    static constexpr auto DEFAULT_VALUE   = "defaultValue"; ///< Default value for column.
-    static constexpr auto COLLATE         = "collate"; ///< Collation for column.
+    static constexpr auto TABLE            = "table"; ///< Table information in JSON.
+    static constexpr auto TABLE_NAME       = "name"; ///< Table name in JSON.
+    static constexpr auto COLUMNS          = "columns"; ///< Columns information in JSON.
+    static constexpr auto COLUMN_NAME      = "name"; ///< Column name in JSON.
+    static constexpr auto COLUMN_TYPE      = "type"; ///< Column type in JSON.
+    static constexpr auto STATEMENTS       = "statements"; ///< SQL statements in JSON.
+    static constexpr auto STATEMENT_NAME   = "name"; ///< SQL statement name in JSON.
+    static constexpr auto STATEMENT_WHERE  = "where"; ///< WHERE clause in SQL statements.
+    static constexpr auto STATEMENT_TYPE   = "type"; ///< SQL statement type (e.g., SELECT, INSERT).
+    static constexpr auto MODIFIERS        = "modifiers"; ///< Column modifiers (e.g., NOT NULL).
+    static constexpr auto INDEX            = "index"; ///< Column index in JSON.
+    static constexpr auto FOREIGN_KEY      = "foreignKey"; ///< Foreign key reference in JSON.
+    static constexpr auto CHECK_CONDITION  = "checkCondition"; ///< Check condition for column.
+    static constexpr auto DEFAULT_VALUE    = "defaultValue"; ///< Default value for column.
+    static constexpr auto COLLATE          = "collate"; ///< Collation for column.
+    static constexpr auto EAGER_STATEMENTS = "eager_statements"; ///< Statements prepared in the constructor.
+    static constexpr auto STATEMENT_ORDER  = "order_by"; ///< Index the pages of a SELECT statement are ordered by.
+    static constexpr auto INDEXES          = "indexes"; ///< Indexes declared apart from the columns in JSON.
+    static constexpr auto INDEX_NAME       = "name"; ///< Index name in JSON.
+    static constexpr auto INDEX_COLUMNS    = "columns"; ///< Ordered key of an index in JSON.
+    static constexpr auto INDEX_EXPRESSION = "expression"; ///< Expression term of an index key.
+    static constexpr auto INDEX_ORDER      = "order"; ///< Sort order of an index term, asc or desc.
+    static constexpr auto INDEX_INCLUDE    = "include"; ///< Covering columns appended after an index key.
+    static constexpr auto INDEX_UNIQUE     = "unique"; ///< Whether an index is unique.
+    static constexpr auto INDEX_WHERE      = "where"; ///< Condition of a partial index.
 
     // Constants for default SQL statement names
     static constexpr auto DEFAULT_STATEMENT_CREATE = "create"; ///< Default CREATE statement.
@@ -64,6 +74,7 @@ public:
     static constexpr auto DEFAULT_STATEMENT_DELETE = "deleteRow"; ///< Default DELETE statement.
     static constexpr auto DEFAULT_STATEMENT_SELECT = "selectPk"; ///< Default SELECT statement by primary key.
     static constexpr auto DEFAULT_STATEMENT_COUNT  = "countRows"; ///< Default COUNT statement.
+    static constexpr auto DEFAULT_STATEMENT_PAGE   = "selectPage"; ///< Default SELECT statement of a page.
 
 
     /**
@@ -89,12 +100,25 @@ public:
      * @brief Loads table information from a JSON object.
      *
      * Parses a JSON object representing the table structure, including columns,
-     * types, and other table-related information.
+     * types, indexes and other table-related information.
      *
      * @param table A QJsonObject containing the table structure.
      */
     void loadTable(const QJsonObject &table);
 
+    /**
+     * @brief Loads the indexes declared apart from the columns from a JSON array.
+     *
+     * Each index has a name and an ordered list of columns, where a term is either the name of a
+     * column or an object with the name or an expression and an optional order, asc or desc.
+     * The optional include, unique and where keys make it covering, unique or partial.
+     *
+     * @param indexes A QJsonArray containing the index definitions.
+     * @throws InvalidJSON if an index has no name or columns, reuses the name of another index,
+     * refers to a column the table does not have, or is unique with covering columns.
+     */
+    void loadIndexes(const QJsonArray &indexes);
+
     /**
      * @brief Loads statements (SQL operations) from a JSON array.
      *
@@ -113,6 +137,17 @@ public:
      */
     void loadDefaultSentences();
 
+    /**
+     * @brief Marks the hot statements to be prepared in the constructor.
+     *
+     * The rest of the statements are prepared on their first use, so constructing
+     * the class does not compile statements the caller never runs.
+     *
+     * @param names A QJsonArray with the names of the statements, default or user defined.
+     * @throws InvalidJSON if a name does not match any statement other than create.
+     */
+    void loadEagerStatements(const QJsonArray &names);
+
     /**
      * @brief Loads a full JSON document and processes it.
      *
@@ -166,6 +201,41 @@ public:
      */
     [[nodiscard]] QString method(const std::shared_ptr<Statement> &statement) const;
 
+    /**
+     * @brief Retrieves the columns bound as placeholders by a SQL statement.
+     *
+     * For INSERT statements these are the columns without autoincrement or default value, for UPDATE,
+     * DELETE and SELECT statements every placeholder of the sentence, such as the primary key of the
+     * default ones, and for the rest the fields of the WHERE clause.
+     *
+     * @param statement A shared pointer to a Statement object representing the SQL statement.
+     * @return The names of the bound columns, in order of appearance.
+     */
+    [[nodiscard]] QVector<QString> getBoundColumns(const std::shared_ptr<Statement> &statement) const;
+
+    /**
+     * @brief Generates the batch variant of an INSERT or UPDATE method.
+     *
+     * The generated method binds one value list per column and executes them with a single
+     * QSqlQuery::execBatch inside a transaction, back-filling the autoincrement ids for inserts.
+     *
+     * @param statement A shared pointer to a Statement object representing the SQL statement.
+     * @return The generated C++ method as a QString.
+     */
+    [[nodiscard]] QString batchMethod(const std::shared_ptr<Statement> &statement) const;
+
+    /**
+     * @brief Generates the method of a keyset pagination.
+     *
+     * The generated method returns the rows after the key of the @p after record, or the first
+     * rows when it is null, executing the statement of the first page or the one of the pages
+     * after a key.
+     *
+     * @param statement A shared pointer to a page Statement.
+     * @return The generated C++ method as a QString.
+     */
+    [[nodiscard]] QString pageMethod(const std::shared_ptr<Statement> &statement) const;
+
     /**
      * @brief Binds fields to a SQL statement.
      *
@@ -173,20 +243,36 @@ public:
      * with the given SQL statement (e.g., for prepared statements).
      *
      * @param statement A shared pointer to a Statement object representing the SQL statement.
+     * @param sqlQuery The expression of the QSqlQuery pointer the fields are bound to.
      * @return The binding code as a std::string.
      */
-    [[nodiscard]] std::string getBindFields(const std::shared_ptr<Statement> &statement) const;
+    [[nodiscard]] std::string getBindFields(const std::shared_ptr<Statement> &statement,
+                                            const std::string &sqlQuery) const;
 
     /**
      * @brief Converts record data to fields.
      *
      * This method converts a record object (representing a row of data) into
-     * individual field values for use in SQL statements.
+     * individual field values for use in SQL statements. Values are read by ordinal
+     * from the statement, using the ordinals resolved once by SQLiteDbApi::resolveFields,
+     * instead of copying the whole record and looking each field up by name. Each value is
+     * converted by SQLiteDbApi::fromVariant instantiated with the type of its column descriptor.
      *
-     * @param statement A shared pointer to a Statement object representing the SQL statement.
+     * @param sqlQuery The expression of the QSqlQuery pointer the values are read from.
+     * @param record The name of the record the values are written to.
      * @return The field conversion code as a std::string.
      */
-    [[nodiscard]] std::string getRecordToFields(const std::shared_ptr<Statement> &statement) const;
+    [[nodiscard]] std::string getRecordToFields(const std::string &sqlQuery, const std::string &record) const;
+
+    /**
+     * @brief Generates the constexpr table of column descriptors of the class.
+     *
+     * One core::db::ColumnDescriptor per column, in table order, with its name, type, ordinal
+     * and modifiers.
+     *
+     * @return The declaration of the COLUMNS member as a std::string.
+     */
+    [[nodiscard]] std::string getColumnDescriptors() const;
 
     /**
      * @brief Saves the generated C++ files to the specified output folder.
@@ -208,6 +294,30 @@ public:
      */
     [[nodiscard]] std::shared_ptr<Statement> statementFromJSON(const QJsonObject &statement) const;
 
+    /**
+     * @brief Creates the keyset pagination of a SELECT statement from its JSON data.
+     *
+     * The pages are ordered by the primary key, or by the index named in the optional order_by
+     * key followed by the primary key.
+     *
+     * @param statement A QJsonObject containing the statement data.
+     * @param select The SELECT statement created from the same data.
+     * @return A shared pointer to a page Statement named after the SELECT with the Page suffix,
+     * nullptr if the table has no primary key.
+     * @throws InvalidJSON if order_by does not name an index of the table.
+     */
+    [[nodiscard]] std::shared_ptr<Statement> pageStatementFromJSON(const QJsonObject &statement,
+                                                                   const Statement &select) const;
+
+    /**
+     * @brief Creates an index declared apart from the columns from the given JSON data.
+     *
+     * @param index A QJsonObject containing the index data, see loadIndexes().
+     * @return The index.
+     * @throws InvalidJSON if the index is not valid for the columns of the table.
+     */
+    [[nodiscard]] core::db::TableIndex indexFromJSON(const QJsonObject &index) const;
+
     /**
      * @brief Creates a Column object from the given JSON data.
      *
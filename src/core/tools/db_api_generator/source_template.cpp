@@ -23,8 +23,11 @@ constexpr const char *getHeaderTemplate()
 #include "db/db_manager.h"
 #include {header_parent_class_name}
 #include <QSqlQuery>
+#include <QUtf8StringView>
+#include <array>
 #include <memory>
 #include <qdatetime.h>
+#include <span>
 
 class {class_name} : public {parent_class_name}
 {{
@@ -41,6 +44,8 @@ class {class_name} : public {parent_class_name}
 
 {sentences}
 
+{columns}
+
 {sql_query}
 }};
 )";
@@ -60,23 +65,27 @@ constexpr const char *getSourceTemplate()
 
 #include "{table_name}.h"
 #include "db/db_exception.h"
+#include "db/query_profiler.h"
+#include "tools/trace.h"
 #include <QSqlError>
 #include <QSqlRecord>
 
 {class_name}::{class_name}(const QSqlDatabase& db)
-    : {parent_class_name}(db), {attributes}
+    : {parent_class_name}(db)
 {{
 {prepare}
 }}
 
 void {class_name}::create()
 {{
-    std::array<QString, {create_sentences_size}> sentences = {{ {create_sentences} }};
-    for (auto& sentence : sentences)
+    const core::tools::ScopedSpan span("{class_name}::create", "db");
+    constexpr std::array<QUtf8StringView, {create_sentences_size}> sentences = {{ {create_sentences} }};
+    QSqlQuery query(m_database);
+    for (const auto& sentence : sentences)
     {{
-        if (!m_create.exec(sentence))
+        if (!query.exec(sentence.toString()))
         {{
-            throw core::db::SQLError(m_create.lastError().text());
+            throw core::db::SQLError(query.lastError().text());
         }}
     }}
 }}
@@ -90,11 +99,14 @@ constexpr const char *getNoSelectMethod()
 {
     return R"(void {class_name}::{method_name}(Record& record)
 {{
+    {ensure_prepared}
+    core::db::ProfiledQuery profile(m_database, "{class_name}::{method_name}");
     {record_to_bind}
-    if (!{sql_query}.exec())
+    if (!profile.exec(*{sql_query}))
     {{
-        throw core::db::SQLError({sql_query}.lastError().text());
+        throw core::db::SQLError({sql_query}->lastError().text());
     }}
+    notifyTableChanged("{table_name}");
 }}
 
 )";
@@ -104,12 +116,38 @@ constexpr const char *getInsertMethod()
 {
     return R"(void {class_name}::{method_name}(Record& record)
 {{
+    {ensure_prepared}
+    core::db::ProfiledQuery profile(m_database, "{class_name}::{method_name}");
     {record_to_bind}
-    if (!{sql_query}.exec())
+    if (!profile.exec(*{sql_query}))
     {{
-        throw core::db::SQLError({sql_query}.lastError().text());
+        throw core::db::SQLError({sql_query}->lastError().text());
     }}
     {recover_autoincrement}
+    notifyTableChanged("{table_name}");
+}}
+
+)";
+}
+
+constexpr const char *getBatchMethod()
+{
+    return R"(void {class_name}::{method_name}Batch(std::span<Record> records)
+{{
+    if (records.empty())
+    {{
+        return;
+    }}
+    {batch_declare}
+    for (const auto& record : records)
+    {{
+        {batch_append}
+    }}
+    {ensure_prepared}
+    {batch_bind}
+    execBatch(*{sql_query}, "{class_name}::{method_name}Batch");
+    {recover_batch_autoincrement}
+    notifyTableChanged("{table_name}");
 }}
 
 )";
@@ -119,15 +157,19 @@ constexpr const char *getUniqueSelectMethod()
 {
     return R"(bool {class_name}::{method_name}(Record& record)
 {{
+    {ensure_prepared}
+    core::db::ProfiledQuery profile(m_database, "{class_name}::{method_name}");
     {record_to_bind}
-    if (!{sql_query}.exec())
+    if (!profile.exec(*{sql_query}))
     {{
-        throw core::db::SQLError({sql_query}.lastError().text());
+        throw core::db::SQLError({sql_query}->lastError().text());
     }}
-    if ({sql_query}.next())
+    if ({sql_query}->next())
     {{
-        const auto sqlRecord = {sql_query}.record();
+        core::db::QueryProfiler::addRows("{class_name}::{method_name}", 1);
+        const auto& fields = resolveFields(*{sql_query}, {sql_query}Fields, COLUMNS);
         {record_to_structure}
+        {sql_query}->finish();
         return true;
     }}
     return false;
@@ -140,17 +182,20 @@ constexpr const char *getSelectCount()
 {
     return R"(long long {class_name}::{method_name}()
 {{
+    {ensure_prepared}
+    core::db::ProfiledQuery profile(m_database, "{class_name}::{method_name}");
     {record_to_bind}
-    if (!{sql_query}.exec())
+    if (!profile.exec(*{sql_query}))
     {{
-        throw core::db::SQLError({sql_query}.lastError().text());
+        throw core::db::SQLError({sql_query}->lastError().text());
     }}
-    if ({sql_query}.next())
+    long long rows = 0;
+    if ({sql_query}->next())
     {{
-        const auto sqlRecord = {sql_query}.record();
-        return sqlRecord.value("rows").toLongLong();
+        rows = {sql_query}->value(0).toLongLong();
     }}
-    return 0;
+    {sql_query}->finish();
+    return rows;
 }}
 
 )";
@@ -160,19 +205,22 @@ constexpr const char *getSelectMethod()
 {
     return R"(bool {class_name}::{method_name}(Record& record)
 {{
+    {ensure_prepared}
+    core::db::ProfiledQuery profile(m_database, "{class_name}::{method_name}");
     {record_to_bind}
-    if (!{sql_query}.exec())
+    if (!profile.exec(*{sql_query}))
     {{
-        throw core::db::SQLError({sql_query}.lastError().text());
+        throw core::db::SQLError({sql_query}->lastError().text());
     }}
     return next{capitalized_method_name}(record);
 }}
 
 bool {class_name}::next{capitalized_method_name}(Record& record)
 {{
-    if ({sql_query}.next())
+    if ({sql_query} && {sql_query}->next())
     {{
-        const auto sqlRecord = {sql_query}.record();
+        core::db::QueryProfiler::addRows("{class_name}::{method_name}", 1);
+        const auto& fields = resolveFields(*{sql_query}, {sql_query}Fields, COLUMNS);
         {record_to_structure}
         return true;
     }}
@@ -181,3 +229,34 @@ bool {class_name}::next{capitalized_method_name}(Record& record)
 
 )";
 }
+
+constexpr const char *getPageMethod()
+{
+    return R"(QList<{class_name}::Record> {class_name}::{method_name}({record_parameter}const Record* after, qsizetype limit)
+{{
+    {ensure_prepared}
+    const auto& query = after == nullptr ? m_{method_name} : m_{method_name}After;
+    core::db::ProfiledQuery profile(m_database, "{class_name}::{method_name}");
+    {record_to_bind}
+    if (after != nullptr)
+    {{
+        {after_to_bind}
+    }}
+    query->bindValue("{page_size}", limit);
+    if (!profile.exec(*query))
+    {{
+        throw core::db::SQLError(query->lastError().text());
+    }}
+    QList<Record> records;
+    while (query->next())
+    {{
+        const auto& fields = resolveFields(*query, m_{method_name}Fields, COLUMNS);
+        auto& row = records.emplace_back();
+        {record_to_structure}
+    }}
+    core::db::QueryProfiler::addRows("{class_name}::{method_name}", static_cast<quint64>(records.size()));
+    return records;
+}}
+
+)";
+}
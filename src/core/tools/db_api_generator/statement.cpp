@@ -39,6 +39,16 @@ Statement::Statement(QString name, QVector<QString> sqlVector, const SQLTypes ty
     }
 }
 
+Statement::Statement(QString name, QString first, QString next, QVector<QString> whereFields,
+                     QVector<QString> pageKey) :
+    m_name(std::move(name)), m_type(SQLTypes::page), m_whereFields(std::move(whereFields)),
+    m_pageKey(std::move(pageKey)), m_isUnique(false)
+{
+    const auto constant = core::tools::upperSnake(m_name);
+    m_sqlVector.append({constant, std::move(first)});
+    m_sqlVector.append({constant + "_AFTER", std::move(next)});
+}
+
 QString Statement::name() const
 {
     return m_name;
@@ -59,6 +69,11 @@ QVector<QString> Statement::whereFields() const
     return m_whereFields;
 }
 
+QVector<QString> Statement::pageKey() const
+{
+    return m_pageKey;
+}
+
 QString Statement::signature() const
 {
     if (m_type == SQLTypes::create)
@@ -79,6 +94,12 @@ QString Statement::signature() const
         }
         case SQLTypes::count:
             return QString("long long %1();\n").arg(m_name);
+        case SQLTypes::page:
+            return QString("QList<Record> %1(%2const Record* after, qsizetype limit);\n")
+                    .arg(m_name, m_whereFields.isEmpty() ? "" : "const Record& record, ");
+        case SQLTypes::insert:
+        case SQLTypes::update:
+            return QString("void %1(Record& record);\nvoid %1Batch(std::span<Record> records);\n").arg(m_name);
     }
     return QString("void %1(Record& record);\n").arg(m_name);
 }
@@ -88,33 +109,58 @@ QString Statement::sentences() const
     QString sentences;
     for (const auto &[key, value]: m_sqlVector)
     {
-        sentences += QString("const QString %1 = \"%2\";\n").arg(key, value);
+        sentences += QString("static constexpr QUtf8StringView %1 = \"%2\";\n").arg(key, value);
     }
     return sentences;
 }
 
 QString Statement::sqlQuery() const
 {
-    return QString("QSqlQuery m_%1;\n").arg(m_name);
+    if (m_type == SQLTypes::create)
+    {
+        return {};
+    }
+    if (m_type == SQLTypes::page)
+    {
+        return QString("std::shared_ptr<QSqlQuery> m_%1;\nstd::shared_ptr<QSqlQuery> m_%1After;\n").arg(m_name);
+    }
+    return QString("std::shared_ptr<QSqlQuery> m_%1;\n").arg(m_name);
 }
 
-QString Statement::attributes() const
+QString Statement::prepare() const
 {
     QString attributes;
-    const auto &[key, value] = m_sqlVector.at(0);
-    attributes += QString("m_%1(m_database)").arg(m_name);
+    if (m_type != SQLTypes::create && m_isEager)
+    {
+        const auto &[key, value] = m_sqlVector.at(0);
+        attributes += QString(isCursor() ? "m_%1 = prepareCursor(%2);\n" : "m_%1 = prepare(%2);\n").arg(m_name, key);
+        if (m_type == SQLTypes::page)
+        {
+            attributes += QString("m_%1After = prepare(%2);\n").arg(m_name, m_sqlVector.at(1).first);
+        }
+    }
     return attributes;
 }
 
-QString Statement::prepare() const
+QString Statement::ensurePrepared() const
 {
-    QString attributes;
-    if (m_type != SQLTypes::create)
+    if (m_type == SQLTypes::create)
     {
-        const auto &[key, value] = m_sqlVector.at(0);
-        attributes += QString("m_%1.prepare(%2);\n").arg(m_name, key);
+        return {};
     }
-    return attributes;
+    const auto &[key, value] = m_sqlVector.at(0);
+    if (m_type == SQLTypes::page)
+    {
+        // Only the statement of the requested page is prepared
+        return QString("if (after == nullptr)\n{\nensurePrepared(m_%1, %2);\n}\nelse\n{\nensurePrepared(m_%1After, "
+                       "%3);\n}")
+                .arg(m_name, key, m_sqlVector.at(1).first);
+    }
+    if (isCursor())
+    {
+        return QString("ensurePreparedCursor(m_%1, %2);").arg(m_name, key);
+    }
+    return QString("ensurePrepared(m_%1, %2);").arg(m_name, key);
 }
 
 int Statement::sqlSize() const
@@ -136,3 +182,18 @@ bool Statement::isUnique() const
 {
     return m_isUnique;
 }
+
+bool Statement::isCursor() const
+{
+    return m_type == SQLTypes::select && !m_isUnique;
+}
+
+void Statement::setEager(const bool eager)
+{
+    m_isEager = eager;
+}
+
+bool Statement::isEager() const
+{
+    return m_isEager;
+}
@@ -37,6 +37,7 @@ public:
         create, ///< Represents a CREATE SQL statement.
         deleteRow, ///< Represents a DELETE SQL statement.
         count, ///< Represents a SELECT COUNT SQL statement.
+        page, ///< Represents the SELECT SQL statements of a keyset pagination.
     };
 
     /**
@@ -67,6 +68,21 @@ public:
      */
     explicit Statement(QString name, QVector<QString> sqlVector, SQLTypes type = SQLTypes::create);
 
+    /**
+     * @brief Constructor for the statements of a keyset pagination.
+     *
+     * Initializes a page Statement with the SQL of the first page and the SQL of the pages after
+     * a key, each one declared and prepared as its own query, the second one with the After suffix.
+     *
+     * @param name The name of the SQL statement (e.g., "selectPage").
+     * @param first The SQL query of the first page.
+     * @param next The SQL query of the pages after a key.
+     * @param whereFields A vector of fields used in the WHERE clause of the query.
+     * @param pageKey The columns the pages are ordered by.
+     */
+    explicit Statement(QString name, QString first, QString next, QVector<QString> whereFields,
+                       QVector<QString> pageKey);
+
     // Getter methods for the Statement class:
 
     /**
@@ -97,6 +113,13 @@ public:
      */
     [[nodiscard]] QVector<QString> whereFields() const;
 
+    /**
+     * @brief Retrieves the columns a page statement is ordered by.
+     *
+     * @return A QVector of QStrings with the key columns, empty for the other statements.
+     */
+    [[nodiscard]] QVector<QString> pageKey() const;
+
     /**
      * @brief Generates and retrieves the method signature for executing the SQL statement.
      *
@@ -107,33 +130,35 @@ public:
     [[nodiscard]] QString signature() const;
 
     /**
-     * @brief Retrieves the complete list of SQL statements as a string.
+     * @brief Retrieves the declarations of the SQL texts of the statement.
      *
-     * This may combine all the parts of the SQL query into a single string.
+     * Each text is a static constexpr UTF-8 literal, so constructing the class allocates no string.
      *
-     * @return A QString representing the full SQL query.
+     * @return A QString with one declaration per SQL text.
      */
     [[nodiscard]] QString sentences() const;
 
     /**
-     * @brief Retrieves the SQL query formatted for use in a C++ application.
+     * @brief Retrieves the declaration of the statement member for use in a C++ application.
+     *
+     * The statements share the QSqlQuery of the statement cache, the create statement has no
+     * member since it runs its sentences on a local query.
      *
-     * @return A QString representing the SQL query.
+     * @return A QString representing the SQL query, empty for the create statement.
      */
     [[nodiscard]] QString sqlQuery() const;
 
     /**
-     * @brief Retrieves the attributes (columns or fields) involved in the SQL query.
-     *
-     * @return A QString representing the attributes of the SQL statement.
+     * @brief Prepares the SQL statement in the constructor, only for the eager statements.
+     * @return A QString representing the prepared SQL query, empty for the lazy statements.
      */
-    [[nodiscard]] QString attributes() const;
+    [[nodiscard]] QString prepare() const;
 
     /**
-     * @brief Prepares the SQL statement for execution.
-     * @return A QString representing the prepared SQL query.
+     * @brief Prepares the SQL statement on its first use, taking it from the statement cache of the connection.
+     * @return A QString with the call that prepares the statement if it is not prepared yet.
      */
-    [[nodiscard]] QString prepare() const;
+    [[nodiscard]] QString ensurePrepared() const;
 
     /**
      * @brief Retrieves the size of the SQL statement in terms of the number of fields or components.
@@ -159,10 +184,36 @@ public:
      */
     [[nodiscard]] bool isUnique() const;
 
+    /**
+     * @brief Checks whether the statement is iterated through a next method.
+     *
+     * Those statements keep their result set between calls, so every instance of the generated
+     * class gets its own query instead of sharing the one of the statement cache.
+     *
+     * @return true for the non-unique SELECT statements.
+     */
+    [[nodiscard]] bool isCursor() const;
+
+    /**
+     * @brief Marks the statement to be prepared in the constructor instead of on its first use.
+     *
+     * @param eager true for the hot statements that are worth preparing up front.
+     */
+    void setEager(bool eager);
+
+    /**
+     * @brief Checks if the statement is prepared in the constructor.
+     *
+     * @return A boolean indicating whether the statement is eager.
+     */
+    [[nodiscard]] bool isEager() const;
+
 private:
     QString                              m_name; ///< The name of the SQL statement.
     SQLTypes                             m_type; ///< The type of the SQL statement (e.g., SELECT, INSERT).
     QVector<QString>                     m_whereFields; ///< List of fields used in the WHERE clause.
+    QVector<QString>                     m_pageKey; ///< Columns a page statement is ordered by.
     QVector<std::pair<QString, QString>> m_sqlVector; ///< SQL components for complex queries.
     bool                                 m_isUnique; ///< Flag indicating whether the SQL statement is unique.
+    bool                                 m_isEager = false; ///< Flag indicating whether the SQL statement is prepared in the constructor.
 };
@@ -0,0 +1,145 @@
+/**
+ * @file password_hash.cpp
+ * @brief Implementation file for the PasswordHash class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "password_hash.h"
+
+#include <QCryptographicHash>
+#include <QElapsedTimer>
+#include <QMessageAuthenticationCode>
+#include <QRandomGenerator>
+#include <QStringList>
+#include <algorithm>
+
+namespace core::tools
+{
+    namespace
+    {
+        constexpr qsizetype LEGACY_HASH_SIZE = 128; ///< Hex digits of the unsalted SHA-512 hashes.
+
+        /**
+         * @brief Splits an encoded hash in its scheme, iterations, salt and key.
+         * @return The four parts, or an empty list if the hash is not a PBKDF2 one.
+         */
+        QStringList parse(const QString &encoded)
+        {
+            auto parts = encoded.split('$');
+            if (parts.size() != 4 || parts[0] != PasswordHash::SCHEME)
+            {
+                return {};
+            }
+            return parts;
+        }
+    } // namespace
+
+    QString PasswordHash::hash(const QString &password, const int iterations)
+    {
+        QByteArray salt(SALT_SIZE, Qt::Uninitialized);
+        QRandomGenerator::system()->fillRange(reinterpret_cast<quint32 *>(salt.data()), SALT_SIZE / sizeof(quint32));
+        const auto cost = std::max(iterations, MIN_ITERATIONS);
+        const auto key  = pbkdf2(password.toUtf8(), salt, cost);
+        return QString("%1$%2$%3$%4")
+                .arg(SCHEME)
+                .arg(cost)
+                .arg(QString::fromLatin1(salt.toBase64()), QString::fromLatin1(key.toBase64()));
+    }
+
+    bool PasswordHash::verify(const QString &password, const QString &encoded)
+    {
+        const auto parts = parse(encoded);
+        if (parts.isEmpty())
+        {
+            if (encoded.size() != LEGACY_HASH_SIZE)
+            {
+                return false;
+            }
+            const auto digest = QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha512).toHex();
+            return constantTimeEquals(digest, encoded.toLatin1().toLower());
+        }
+
+        bool       valid      = false;
+        const auto iterations = parts[1].toInt(&valid);
+        if (!valid || iterations <= 0)
+        {
+            return false;
+        }
+        const auto salt     = QByteArray::fromBase64(parts[2].toLatin1());
+        const auto expected = QByteArray::fromBase64(parts[3].toLatin1());
+        if (expected.isEmpty())
+        {
+            return false;
+        }
+        return constantTimeEquals(pbkdf2(password.toUtf8(), salt, iterations, static_cast<int>(expected.size())),
+                                  expected);
+    }
+
+    bool PasswordHash::needsRehash(const QString &encoded, const int iterations)
+    {
+        const auto parts = parse(encoded);
+        return parts.isEmpty() || parts[1].toInt() < std::max(iterations, MIN_ITERATIONS);
+    }
+
+    QByteArray PasswordHash::pbkdf2(const QByteArray &password, const QByteArray &salt, const int iterations,
+                                    const int keySize)
+    {
+        QByteArray                 key;
+        QMessageAuthenticationCode mac(QCryptographicHash::Sha512, password);
+        key.reserve(keySize);
+        for (quint32 block = 1; key.size() < keySize; ++block)
+        {
+            const char index[] = {static_cast<char>(block >> 24), static_cast<char>(block >> 16),
+                                  static_cast<char>(block >> 8), static_cast<char>(block)};
+            mac.reset();
+            mac.addData(salt);
+            mac.addData(index, sizeof(index));
+            auto       u = mac.result();
+            QByteArray t = u;
+            for (int i = 1; i < iterations; ++i)
+            {
+                mac.reset();
+                mac.addData(u);
+                u = mac.result();
+                for (qsizetype j = 0; j < t.size(); ++j)
+                {
+                    t[j] = static_cast<char>(t[j] ^ u[j]);
+                }
+            }
+            key += t;
+        }
+        key.truncate(keySize);
+        return key;
+    }
+
+    bool PasswordHash::constantTimeEquals(const QByteArray &left, const QByteArray &right)
+    {
+        if (left.size() != right.size())
+        {
+            return false;
+        }
+        // Every byte is compared, so the time does not tell where the first difference is
+        unsigned char difference = 0;
+        for (qsizetype i = 0; i < left.size(); ++i)
+        {
+            difference |= static_cast<unsigned char>(left[i] ^ right[i]);
+        }
+        return difference == 0;
+    }
+
+    int PasswordHash::calibrate(const std::chrono::milliseconds target)
+    {
+        QElapsedTimer timer;
+        timer.start();
+        static_cast<void>(pbkdf2("calibration", QByteArray(SALT_SIZE, '\0'), MIN_ITERATIONS));
+        const auto elapsed = std::max<qint64>(1, timer.nsecsElapsed());
+
+        const auto iterations = static_cast<double>(MIN_ITERATIONS) * std::chrono::nanoseconds(target).count() /
+                                static_cast<double>(elapsed);
+        return std::max(MIN_ITERATIONS, static_cast<int>(iterations / 1000) * 1000);
+    }
+
+} // namespace core::tools
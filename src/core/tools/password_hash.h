@@ -0,0 +1,93 @@
+/**
+ * @file password_hash.h
+ * @brief Header file for the PasswordHash class.
+ *
+ * This file declares the PasswordHash class, which derives salted password hashes with a
+ * tunable work factor and verifies them in constant time.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QString>
+#include <chrono>
+#include "dllexports.h"
+
+namespace core::tools
+{
+
+    /**
+     * @class PasswordHash
+     * @brief Salted PBKDF2-HMAC-SHA512 password hashes.
+     *
+     * A hash is stored as `pbkdf2-sha512$<iterations>$<salt>$<key>`, salt and key in base64, so
+     * the work factor can be raised without invalidating the stored passwords: verify() uses
+     * the iterations of the stored hash and needsRehash() tells when it is lower than the
+     * current one. The unsalted SHA-512 hex digests of older databases are still verified.
+     */
+    class CORE_API PasswordHash
+    {
+    public:
+        static constexpr auto SCHEME             = "pbkdf2-sha512"; ///< Identifier of the hash scheme.
+        static constexpr int  DEFAULT_ITERATIONS = 210000; ///< Default work factor, the OWASP recommendation.
+        static constexpr int  MIN_ITERATIONS     = 10000; ///< Lowest work factor accepted.
+        static constexpr int  SALT_SIZE          = 16; ///< Bytes of random salt.
+        static constexpr int  KEY_SIZE           = 64; ///< Bytes of derived key.
+
+        /**
+         * @brief Hashes a password with a new random salt.
+         * @param password The password.
+         * @param iterations The work factor.
+         * @return The encoded hash.
+         */
+        [[nodiscard]] static QString hash(const QString &password, int iterations = DEFAULT_ITERATIONS);
+
+        /**
+         * @brief Verifies a password against an encoded hash, comparing the keys in constant time.
+         * @param password The password.
+         * @param encoded The stored hash.
+         * @return true if the password matches.
+         */
+        [[nodiscard]] static bool verify(const QString &password, const QString &encoded);
+
+        /**
+         * @brief Checks whether a stored hash uses an older scheme or a lower work factor.
+         * @param encoded The stored hash.
+         * @param iterations The current work factor.
+         * @return true if the password should be hashed again once it is verified.
+         */
+        [[nodiscard]] static bool needsRehash(const QString &encoded, int iterations = DEFAULT_ITERATIONS);
+
+        /**
+         * @brief Derives a key with PBKDF2-HMAC-SHA512 (RFC 8018).
+         * @param password The password bytes.
+         * @param salt The salt bytes.
+         * @param iterations The work factor.
+         * @param keySize The bytes of the derived key.
+         * @return The derived key.
+         */
+        [[nodiscard]] static QByteArray pbkdf2(const QByteArray &password, const QByteArray &salt, int iterations,
+                                               int keySize = KEY_SIZE);
+
+        /**
+         * @brief Compares two byte arrays in a time that only depends on their size.
+         * @param left The first array.
+         * @param right The second array.
+         * @return true if both arrays are equal.
+         */
+        [[nodiscard]] static bool constantTimeEquals(const QByteArray &left, const QByteArray &right);
+
+        /**
+         * @brief Measures this machine to find the work factor of a target hashing time.
+         * @param target The time a login should spend hashing.
+         * @return The iterations, rounded to thousands and never lower than MIN_ITERATIONS.
+         */
+        [[nodiscard]] static int calibrate(std::chrono::milliseconds target);
+    };
+
+} // namespace core::tools
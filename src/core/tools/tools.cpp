@@ -82,7 +82,7 @@ namespace core::tools
 
     QVector<QString> extractBoundFields(const QString &query)
     {
-        static const QRegularExpression re(R"(WHERE\s+(.*?)(?=\s*(GROUP|ORDER|LIMIT|$)))",
+        static const QRegularExpression re(R"(WHERE\s+(.*?)(?=\s*(\bGROUP\s+BY\b|\bORDER\s+BY\b|\bLIMIT\b|$)))",
                                            QRegularExpression::CaseInsensitiveOption);
         static const QRegularExpression paramRe(R"(:\b(\w+)\b)");
 
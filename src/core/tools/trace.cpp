@@ -0,0 +1,195 @@
+/**
+ * @file trace.cpp
+ * @brief Implementation file for the Trace class.
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#include "trace.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutex>
+#include <QThread>
+#include <chrono>
+
+namespace core::tools
+{
+    std::atomic_bool Trace::s_enabled = false;
+
+    namespace
+    {
+        /**
+         * @brief Spans recorded by every thread.
+         */
+        struct Recorder
+        {
+            QMutex                  mutex; ///< Spans are recorded from any thread.
+            QList<Trace::Span>      spans; ///< Recorded spans.
+            QHash<quint64, QString> threadNames; ///< Name of each thread that recorded a span.
+            qsizetype               dropped = 0; ///< Spans not kept once MAX_SPANS was reached.
+            QString                 outputPath; ///< File written by flush().
+            std::atomic<qint64>     origin = 0; ///< Zero of the trace clock, in steady clock nanoseconds.
+        };
+
+        Recorder &recorder()
+        {
+            static Recorder self;
+            return self;
+        }
+
+        /**
+         * @brief Reads the steady clock.
+         */
+        qint64 steadyNow()
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch())
+                    .count();
+        }
+
+        /**
+         * @brief Converts nanoseconds to the microseconds used by the trace-event format.
+         */
+        double microseconds(const qint64 nanoseconds)
+        {
+            return static_cast<double>(nanoseconds) / 1000.0;
+        }
+    } // namespace
+
+    void Trace::enable(const QString &outputPath)
+    {
+        auto        &self = recorder();
+        QMutexLocker locker(&self.mutex);
+        if (!s_enabled.load())
+        {
+            self.origin.store(steadyNow());
+        }
+        self.outputPath = outputPath;
+        s_enabled.store(true);
+    }
+
+    bool Trace::enableFromEnvironment()
+    {
+        const auto path = qEnvironmentVariable(ENVIRONMENT_VARIABLE);
+        if (path.isEmpty())
+        {
+            return false;
+        }
+        enable(path);
+        return true;
+    }
+
+    void Trace::disable()
+    {
+        s_enabled.store(false);
+    }
+
+    qint64 Trace::now()
+    {
+        return steadyNow() - recorder().origin.load(std::memory_order_relaxed);
+    }
+
+    void Trace::record(const char *name, const char *category, const QString &detail, const qint64 start,
+                       const qint64 end)
+    {
+        const auto   thread = static_cast<quint64>(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+        auto        &self   = recorder();
+        QMutexLocker locker(&self.mutex);
+        if (self.spans.size() >= MAX_SPANS)
+        {
+            self.dropped++;
+            return;
+        }
+        if (!self.threadNames.contains(thread))
+        {
+            const auto threadName = QThread::currentThread()->objectName();
+            self.threadNames.insert(thread, threadName.isEmpty() ? QString("Thread %1").arg(thread) : threadName);
+        }
+        self.spans.append({name, category, detail, thread, start, end - start});
+    }
+
+    QList<Trace::Span> Trace::spans()
+    {
+        auto        &self = recorder();
+        QMutexLocker locker(&self.mutex);
+        return self.spans;
+    }
+
+    void Trace::clear()
+    {
+        auto        &self = recorder();
+        QMutexLocker locker(&self.mutex);
+        self.spans.clear();
+        self.threadNames.clear();
+        self.dropped = 0;
+    }
+
+    QByteArray Trace::toChromeTrace()
+    {
+        auto        &self = recorder();
+        QMutexLocker locker(&self.mutex);
+        const auto   pid = QCoreApplication::applicationPid();
+
+        QJsonArray events;
+        for (auto it = self.threadNames.cbegin(); it != self.threadNames.cend(); ++it)
+        {
+            events.append(QJsonObject{{"name", "thread_name"},
+                                      {"ph", "M"},
+                                      {"pid", pid},
+                                      {"tid", static_cast<qint64>(it.key())},
+                                      {"args", QJsonObject{{"name", it.value()}}}});
+        }
+        for (const auto &span: self.spans)
+        {
+            QJsonObject event{{"name", span.name},
+                              {"cat", span.category},
+                              {"ph", "X"},
+                              {"ts", microseconds(span.start)},
+                              {"dur", microseconds(span.duration)},
+                              {"pid", pid},
+                              {"tid", static_cast<qint64>(span.thread)}};
+            if (!span.detail.isEmpty())
+            {
+                event.insert("args", QJsonObject{{"detail", span.detail}});
+            }
+            events.append(event);
+        }
+
+        QJsonObject trace{{"traceEvents", events}, {"displayTimeUnit", "ms"}};
+        if (self.dropped > 0)
+        {
+            trace.insert("otherData", QJsonObject{{"droppedSpans", static_cast<qint64>(self.dropped)}});
+        }
+        return QJsonDocument(trace).toJson(QJsonDocument::Compact);
+    }
+
+    bool Trace::write(const QString &path)
+    {
+        QFile file(path);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            return false;
+        }
+        const auto json = toChromeTrace();
+        return file.write(json) == json.size();
+    }
+
+    bool Trace::flush()
+    {
+        QString path;
+        {
+            auto        &self = recorder();
+            QMutexLocker locker(&self.mutex);
+            path = self.outputPath;
+        }
+        return path.isEmpty() || write(path);
+    }
+
+} // namespace core::tools
@@ -0,0 +1,175 @@
+/**
+ * @file trace.h
+ * @brief Header file for the Trace and ScopedSpan classes.
+ *
+ * This file declares a lightweight tracing facility: scoped spans record their name, thread,
+ * start and duration while tracing is enabled, and the recorded spans can be written as a
+ * Chrome trace-event JSON file to be opened in chrome://tracing or Perfetto.
+ *
+ * @copyright Copyright 2024 Manel Jimeno. All rights reserved.
+ * @author Manel Jimeno <manel.jimeno@gmail.com>
+ * @date 2024
+ * @license MIT http://www.opensource.org/licenses/mit-license.php
+ */
+
+#pragma once
+
+#include <QByteArray>
+#include <QList>
+#include <QString>
+#include <atomic>
+#include "dllexports.h"
+
+namespace core::tools
+{
+
+    /**
+     * @class Trace
+     * @brief Process-wide recorder of timed spans.
+     *
+     * Tracing is disabled by default, then a span only costs the relaxed load of a flag. Set the
+     * INVOICE_TRACE environment variable to the path of the output file and call
+     * enableFromEnvironment() at startup and flush() at exit to get the trace of a run.
+     */
+    class CORE_API Trace
+    {
+    public:
+        static constexpr auto      ENVIRONMENT_VARIABLE = "INVOICE_TRACE"; ///< Path of the trace file.
+        static constexpr qsizetype MAX_SPANS            = 1 << 20; ///< Spans kept, the later ones are dropped.
+
+        /**
+         * @brief A recorded span.
+         */
+        struct Span
+        {
+            const char *name; ///< Name of the span, a string literal.
+            const char *category; ///< Category of the span, a string literal.
+            QString     detail; ///< Optional detail, such as the SQL of a statement.
+            quint64     thread; ///< Identifier of the thread that recorded the span.
+            qint64      start; ///< Start in nanoseconds since tracing was enabled.
+            qint64      duration; ///< Duration in nanoseconds.
+        };
+
+        /**
+         * @brief Starts recording spans.
+         * @param outputPath File written by flush(), empty to only keep the spans in memory.
+         */
+        static void enable(const QString &outputPath = {});
+
+        /**
+         * @brief Enables tracing if the INVOICE_TRACE environment variable names an output file.
+         * @return true if tracing was enabled.
+         */
+        static bool enableFromEnvironment();
+
+        /**
+         * @brief Stops recording spans, the recorded ones are kept.
+         */
+        static void disable();
+
+        /**
+         * @brief Checks whether spans are recorded.
+         * @return true if tracing is enabled.
+         */
+        [[nodiscard]] static bool isEnabled() noexcept
+        {
+            return s_enabled.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Retrieves the time of the trace clock.
+         * @return Nanoseconds since tracing was enabled.
+         */
+        [[nodiscard]] static qint64 now();
+
+        /**
+         * @brief Records a span, ScopedSpan calls it when it is destroyed.
+         * @param name Name of the span, a string literal.
+         * @param category Category of the span, a string literal.
+         * @param detail Optional detail.
+         * @param start Start read from now().
+         * @param end End read from now().
+         */
+        static void record(const char *name, const char *category, const QString &detail, qint64 start, qint64 end);
+
+        /**
+         * @brief Retrieves the recorded spans.
+         * @return A copy of the spans, in the order they finished.
+         */
+        [[nodiscard]] static QList<Span> spans();
+
+        /**
+         * @brief Discards the recorded spans.
+         */
+        static void clear();
+
+        /**
+         * @brief Serializes the recorded spans as complete events of the Chrome trace-event format.
+         * @return The JSON document.
+         */
+        [[nodiscard]] static QByteArray toChromeTrace();
+
+        /**
+         * @brief Writes the recorded spans to a Chrome trace-event JSON file.
+         * @param path The file path.
+         * @return true if the file was written.
+         */
+        static bool write(const QString &path);
+
+        /**
+         * @brief Writes the recorded spans to the output file given to enable(), if any.
+         * @return true if there was nothing to write or the file was written.
+         */
+        static bool flush();
+
+    private:
+        static std::atomic_bool s_enabled; ///< Whether spans are recorded.
+    };
+
+    /**
+     * @class ScopedSpan
+     * @brief Records a span from its construction to its destruction.
+     *
+     * Whether it records is decided when it is constructed, so a span that starts while
+     * tracing is disabled costs nothing else.
+     */
+    class ScopedSpan
+    {
+    public:
+        /**
+         * @brief Starts a span.
+         * @param name Name of the span, a string literal.
+         * @param category Category of the span, a string literal.
+         * @param detail Optional detail, only copied while tracing is enabled.
+         */
+        explicit ScopedSpan(const char *name, const char *category = "app", const QString &detail = {}) :
+            m_name(name), m_category(category), m_start(Trace::isEnabled() ? Trace::now() : -1)
+        {
+            if (m_start >= 0)
+            {
+                m_detail = detail;
+            }
+        }
+
+        /**
+         * @brief Ends the span and records it.
+         */
+        ~ScopedSpan()
+        {
+            if (m_start >= 0)
+            {
+                Trace::record(m_name, m_category, m_detail, m_start, Trace::now());
+            }
+        }
+
+        ScopedSpan(const ScopedSpan &)            = delete;
+        ScopedSpan &operator=(const ScopedSpan &) = delete;
+
+    private:
+        const char  *m_name; ///< Name of the span.
+        const char  *m_category; ///< Category of the span.
+        QString      m_detail; ///< Detail of the span, empty while tracing is disabled.
+        const qint64 m_start; ///< Start of the span, negative if it is not recorded.
+    };
+
+} // namespace core::tools
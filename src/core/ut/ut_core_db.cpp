@@ -6,11 +6,21 @@
 
 #include <QCoreApplication>
 #include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QSemaphore>
+#include <QSqlError>
+#include <QThread>
 #include <QTimer>
 #include <gtest/gtest.h>
 #include <memory>
+#include <optional>
+#include "db/db_manager.h"
 #include "db/dynamic_table.h"
+#include "db/factory.h"
+#include "db/query_profiler.h"
 #include "db/sqlite/sqlite_column.h"
+#include "db/transaction.h"
 #include "tools/tools.h"
 
 using namespace core::db;
@@ -49,6 +59,49 @@ TEST(SQLiteTable, not_create_table_when_exists)
     EXPECT_EQ(records.size(), 2);
 }
 
+TEST(SQLiteTable, scan)
+{
+    int rows = 0;
+    for (const auto &record: table->scan())
+    {
+        EXPECT_FALSE(record.value("name").toString().isEmpty());
+        rows++;
+    }
+    EXPECT_EQ(rows, 2);
+}
+
+TEST(SQLiteTable, scan_stop_early)
+{
+    auto cursor = table->scan();
+    ASSERT_TRUE(cursor.next());
+    cursor.close();
+    EXPECT_FALSE(cursor.next());
+    EXPECT_EQ(table->select().size(), 2);
+}
+
+TEST(SQLiteTable, scan_not_disturbed_by_other_tables)
+{
+    // Another object on the same connection runs the same select while the cursor is open
+    DynamicTable other(db, "TestTable", settingsColumns);
+    auto         cursor = table->scan();
+    ASSERT_TRUE(cursor.next());
+    const auto first = cursor.record().value("name").toString();
+    EXPECT_EQ(other.select().size(), 2);
+    ASSERT_TRUE(cursor.next());
+    EXPECT_NE(cursor.record().value("name").toString(), first);
+    EXPECT_FALSE(cursor.next());
+}
+
+TEST(SQLiteTable, scanPk)
+{
+    auto cursor = table->scanPk({{"name", "name_2"}});
+    auto it     = cursor.begin();
+    ASSERT_NE(it, cursor.end());
+    EXPECT_EQ(it->value("value"), "value2");
+    ++it;
+    EXPECT_EQ(it, cursor.end());
+}
+
 TEST(SQLiteTable, selectPk)
 {
     const auto records = table->selectPk({{"name", "name_1"}});
@@ -70,6 +123,665 @@ TEST(SQLiteTable, deleteRow)
     EXPECT_EQ(records.size(), 1);
 }
 
+TEST(SQLiteTable, insertMany)
+{
+    QVariantList names;
+    QVariantList values;
+    for (int i = 0; i < 10; i++)
+    {
+        names << QString("batch_%1").arg(i);
+        values << QString("value_%1").arg(i);
+    }
+    table->insertMany({{"name", names}, {"value", values}}, 3);
+    const auto records = table->select();
+    EXPECT_EQ(records.size(), 11);
+}
+
+TEST(SQLiteTable, updateMany)
+{
+    table->updateMany({{"name", QVariantList{"batch_0", "batch_1"}}, {"value", QVariantList{"updated", "updated"}}});
+    const auto records = table->selectPk({{"name", "batch_1"}});
+    EXPECT_GT(records.size(), 0);
+    EXPECT_EQ(records[0].value("value"), "updated");
+}
+
+TEST(SQLiteTable, insertMany_rollback_on_error)
+{
+    const QVariantList names{"batch_10", "batch_11", "name_2"};
+    const QVariantList values{"value_10", "value_11", "value_2"};
+    EXPECT_THROW(table->insertMany({{"name", names}, {"value", values}}, 2), SQLError);
+    const auto records = table->select();
+    EXPECT_EQ(records.size(), 11);
+}
+
+TEST(SQLiteTable, insertMany_columns_mismatch)
+{
+    EXPECT_THROW(table->insertMany({{"name", QVariantList{"batch_10"}}, {"value", QVariantList{}}}), SQLError);
+}
+
+TEST(SQLiteTable, deleteMany)
+{
+    QVariantList names;
+    for (int i = 0; i < 10; i++)
+    {
+        names << QString("batch_%1").arg(i);
+    }
+    table->deleteMany({{"name", names}});
+    const auto records = table->select();
+    EXPECT_EQ(records.size(), 1);
+}
+
+TEST(SQLiteTable, rows_by_position)
+{
+    table->insertRow(DynamicTable::row("row_1", "value_1"));
+    table->updateRow(DynamicTable::row("row_1", "updated"));
+    const auto records = table->selectByKey(DynamicTable::row("row_1"));
+    ASSERT_EQ(records.size(), 1);
+    EXPECT_EQ(records[0].value("value"), "updated");
+
+    table->upsertRow(DynamicTable::row("row_1", "upserted"));
+    table->upsertRow(DynamicTable::row("row_2", "inserted"));
+    EXPECT_EQ(table->selectByKey(DynamicTable::row("row_1"))[0].value("value"), "upserted");
+    EXPECT_EQ(table->select().size(), 3);
+
+    table->removeRow(DynamicTable::row("row_1"));
+    table->removeRow(DynamicTable::row("row_2"));
+    EXPECT_EQ(table->select().size(), 1);
+    EXPECT_THROW(table->insertRow(DynamicTable::row("row_3")), SQLError);
+}
+
+TEST(SQLiteTable, batches_by_position)
+{
+    const QVariantList names{"row_1", "row_2", "row_3"};
+    table->insertRows(std::array{names, QVariantList{"a", "b", "c"}}, 2);
+    table->upsertRows(std::array{names, QVariantList{"x", "y", "z"}});
+    EXPECT_EQ(table->selectByKey(DynamicTable::row("row_3"))[0].value("value"), "z");
+    table->removeRows(std::array{names});
+    EXPECT_EQ(table->select().size(), 1);
+    EXPECT_THROW(table->removeRows(std::array{names, names}), SQLError);
+}
+
+TEST(SQLiteTable, pages_by_key)
+{
+    const QVariantList names{"page_1", "page_2", "page_3", "page_4"};
+    table->insertRows(std::array{names, QVariantList{"d", "c", "b", "a"}});
+    EXPECT_EQ(table->pageKey(), QStringList{"name"});
+
+    // The row left by the previous tests, name_2, sorts first
+    auto page = table->selectPage({}, 3);
+    ASSERT_EQ(page.size(), 3);
+    EXPECT_EQ(page[0].value("name"), "name_2");
+    EXPECT_EQ(page[2].value("name"), "page_2");
+    page = table->selectPage(table->pageKeyOf(page.last()), 3);
+    ASSERT_EQ(page.size(), 2);
+    EXPECT_EQ(page[0].value("name"), "page_3");
+    EXPECT_TRUE(table->selectPage(table->pageKeyOf(page.last()), 3).isEmpty());
+
+    EXPECT_THROW(table->selectPage({}, 0), SQLError);
+    EXPECT_THROW(table->selectPage({}, 3, "idx_missing"), SQLError);
+    EXPECT_THROW(table->selectPage(DynamicTable::row("page_1", "d"), 3), SQLError);
+    table->removeRows(std::array{names});
+}
+
+TEST(SQLiteTable, pages_by_index)
+{
+    DynamicTable invoices(db, "Invoices",
+                          {std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER,
+                                                          SQLiteModifier::isPrimaryKey),
+                           std::make_shared<SQLiteColumn>("customer", SQLiteColumn::SQLiteDataType::TEXT,
+                                                          SQLiteModifier::isNotNull, "idx_invoices_customer")});
+    invoices.create();
+    invoices.insertRows(std::array{QVariantList{1, 2, 3, 4}, QVariantList{"b", "a", "b", "a"}});
+    EXPECT_EQ(invoices.pageKey("idx_invoices_customer"), (QStringList{"customer", "id"}));
+
+    // Ordered by customer, then the invoices of a customer by id
+    auto page = invoices.selectPage({}, 3, "idx_invoices_customer");
+    ASSERT_EQ(page.size(), 3);
+    EXPECT_EQ(page[0].value("id").toLongLong(), 2);
+    EXPECT_EQ(page[1].value("id").toLongLong(), 4);
+    EXPECT_EQ(page[2].value("id").toLongLong(), 1);
+    page = invoices.selectPage(invoices.pageKeyOf(page.last(), "idx_invoices_customer"), 3, "idx_invoices_customer");
+    ASSERT_EQ(page.size(), 1);
+    EXPECT_EQ(page[0].value("id").toLongLong(), 3);
+
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("Invoices");
+    builder->setSchema(invoices.schema());
+    EXPECT_EQ(builder->createSelectPage(builder->pageKey("idx_invoices_customer"), true, "customer <> ''"),
+              "SELECT * FROM Invoices WHERE (customer <> '') AND (customer, id) > (:after_customer, :after_id) ORDER "
+              "BY customer, id LIMIT :page_size;");
+}
+
+TEST(SQLiteTable, pages_by_nullable_index)
+{
+    DynamicTable contacts(db, "Contacts",
+                          {std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER,
+                                                          SQLiteModifier::isPrimaryKey),
+                           std::make_shared<SQLiteColumn>("email", SQLiteColumn::SQLiteDataType::TEXT,
+                                                          SQLiteModifier::None, "idx_contacts_email")});
+    contacts.create();
+    // The NULL emails come first and the second page starts among them
+    contacts.insertRows(std::array{QVariantList{1, 2, 3, 4, 5, 6},
+                                   QVariantList{"b", QVariant(), "a", QVariant(), QVariant(), "a"}});
+
+    QList<long long> ids;
+    auto             page = contacts.selectPage({}, 2, "idx_contacts_email");
+    while (!page.isEmpty())
+    {
+        for (const auto &row: page)
+        {
+            ids << row.value("id").toLongLong();
+        }
+        page = contacts.selectPage(contacts.pageKeyOf(page.last(), "idx_contacts_email"), 2, "idx_contacts_email");
+    }
+    EXPECT_EQ(ids, (QList<long long>{2, 4, 5, 3, 6, 1}));
+
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("Contacts");
+    builder->setSchema(contacts.schema());
+    EXPECT_EQ(builder->createSelectPage(builder->pageKey("idx_contacts_email"), true),
+              "SELECT * FROM Contacts WHERE ((email > :after_email OR (:after_email IS NULL AND email IS NOT NULL)) "
+              "OR email IS :after_email AND id > :after_id) ORDER BY email, id LIMIT :page_size;");
+}
+
+TEST(SQLiteTable, declared_indexes)
+{
+    TableSchema schema = {
+            std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER, SQLiteModifier::isPrimaryKey),
+            std::make_shared<SQLiteColumn>("customer", SQLiteColumn::SQLiteDataType::TEXT, SQLiteModifier::isNotNull),
+            std::make_shared<SQLiteColumn>("issued", SQLiteColumn::SQLiteDataType::TEXT, SQLiteModifier::isNotNull),
+            std::make_shared<SQLiteColumn>("total", SQLiteColumn::SQLiteDataType::REAL),
+            std::make_shared<SQLiteColumn>("paid", SQLiteColumn::SQLiteDataType::INTEGER)};
+    const auto plain = schema.fingerprint();
+    schema.addIndex({"idx_orders_customer_issued", {{"customer"}, {"issued"}}, {"total"}});
+    schema.addIndex({"idx_orders_recent", {{"customer"}, {"issued", true}}, {}, false, "paid = 0"});
+    schema.addIndex({"idx_orders_customer_lower", {{"lower(customer)"}, {"issued"}}, {}, true});
+    // Every index is part of the definition the statements are shared by
+    EXPECT_NE(schema.fingerprint(), plain);
+
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("Orders");
+    builder->setSchema(schema);
+    EXPECT_EQ(builder->createIndexes(),
+              (QVector<QString>{
+                      "CREATE INDEX IF NOT EXISTS idx_orders_customer_issued ON orders(customer, issued, total);",
+                      "CREATE INDEX IF NOT EXISTS idx_orders_recent ON orders(customer, issued DESC) WHERE paid = 0;",
+                      "CREATE UNIQUE INDEX IF NOT EXISTS idx_orders_customer_lower ON orders(lower(customer), "
+                      "issued);"}));
+    // Only the ascending columns order the pages
+    EXPECT_EQ(builder->pageKey("idx_orders_customer_issued"), (QStringList{"customer", "issued", "id"}));
+    EXPECT_TRUE(builder->pageKey("idx_orders_recent").isEmpty());
+    EXPECT_TRUE(builder->pageKey("idx_orders_customer_lower").isEmpty());
+
+    DynamicTable orders(db, "Orders", schema);
+    orders.create();
+    orders.insertRows(std::array{QVariantList{1, 2, 3}, QVariantList{"b", "a", "a"},
+                                 QVariantList{"2024-02-01", "2024-03-01", "2024-01-01"}, QVariantList{10.0, 20.0, 30.0},
+                                 QVariantList{0, 1, 0}});
+    const auto page = orders.selectPage({}, 2, "idx_orders_customer_issued");
+    ASSERT_EQ(page.size(), 2);
+    EXPECT_EQ(page[0].value("id").toLongLong(), 3);
+    EXPECT_EQ(page[1].value("id").toLongLong(), 2);
+    // The unique index rejects the same customer and date in another case
+    EXPECT_THROW(orders.insertRow(DynamicTable::row(4, "A", "2024-03-01", 40.0, 0)), SQLError);
+}
+
+TEST(SQLiteTable, pages_by_partial_index)
+{
+    TableSchema schema = {
+            std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER, SQLiteModifier::isPrimaryKey),
+            std::make_shared<SQLiteColumn>("customer", SQLiteColumn::SQLiteDataType::TEXT, SQLiteModifier::isNotNull),
+            std::make_shared<SQLiteColumn>("paid", SQLiteColumn::SQLiteDataType::INTEGER, SQLiteModifier::isNotNull)};
+    schema.addIndex({"idx_bills_unpaid", {{"customer"}}, {}, false, "paid = 0"});
+
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("Bills");
+    builder->setSchema(schema);
+    EXPECT_EQ(builder->pageWhere("idx_bills_unpaid"), "paid = 0");
+    EXPECT_EQ(builder->pageWhere("idx_bills_unpaid", "customer <> ''"), "(customer <> '') AND (paid = 0)");
+    EXPECT_EQ(builder->pageWhere({}, "customer <> ''"), "customer <> ''");
+
+    DynamicTable bills(db, "Bills", schema);
+    bills.create();
+    bills.insertRows(std::array{QVariantList{1, 2, 3, 4, 5}, QVariantList{"b", "a", "a", "c", "b"},
+                                QVariantList{0, 1, 0, 0, 1}});
+
+    // Only the rows of the index are paged
+    QList<long long> ids;
+    auto             page = bills.selectPage({}, 2, "idx_bills_unpaid");
+    while (!page.isEmpty())
+    {
+        for (const auto &row: page)
+        {
+            ids << row.value("id").toLongLong();
+        }
+        page = bills.selectPage(bills.pageKeyOf(page.last(), "idx_bills_unpaid"), 2, "idx_bills_unpaid");
+    }
+    EXPECT_EQ(ids, (QList<long long>{3, 1, 4}));
+}
+
+TEST(Transaction, commit)
+{
+    {
+        Transaction transaction(db);
+        EXPECT_EQ(transaction.level(), 0);
+        table->insert({{"name", "transaction_1"}, {"value", "value"}});
+        transaction.commit();
+    }
+    EXPECT_EQ(table->select().size(), 2);
+    table->deleteRows({{"name", "transaction_1"}});
+}
+
+TEST(Transaction, rollback_on_exception)
+{
+    EXPECT_THROW(
+            {
+                Transaction transaction(db);
+                table->insert({{"name", "transaction_1"}, {"value", "value"}});
+                table->insert({{"name", "transaction_1"}, {"value", "duplicated"}});
+                transaction.commit();
+            },
+            SQLError);
+    EXPECT_EQ(table->select().size(), 1);
+}
+
+TEST(Transaction, nested_savepoints)
+{
+    {
+        Transaction outer(db);
+        table->insert({{"name", "transaction_1"}, {"value", "value"}});
+        {
+            Transaction inner(db);
+            EXPECT_EQ(inner.level(), 1);
+            table->insert({{"name", "transaction_2"}, {"value", "value"}});
+        }
+        // A batch joins the outer transaction instead of failing to begin its own
+        table->insertMany({{"name", QVariantList{"transaction_3"}}, {"value", QVariantList{"value"}}});
+        outer.commit();
+    }
+    EXPECT_EQ(table->selectPk({{"name", "transaction_1"}}).size(), 1);
+    EXPECT_EQ(table->selectPk({{"name", "transaction_2"}}).size(), 0);
+    EXPECT_EQ(table->selectPk({{"name", "transaction_3"}}).size(), 1);
+    table->deleteMany({{"name", QVariantList{"transaction_1", "transaction_3"}}});
+    EXPECT_EQ(table->select().size(), 1);
+
+    // The levels are released, so the next guard begins a transaction again
+    Transaction transaction(db);
+    EXPECT_EQ(transaction.level(), 0);
+}
+
+TEST(StatementCache, shared_across_tables)
+{
+    const auto cache  = DBManager::manager().statementCache(db);
+    const auto hits   = cache->hits();
+    const auto misses = cache->misses();
+
+    // The writes are shared, the selects read through a cursor are prepared by each table
+    DynamicTable first(db, "TestTable", settingsColumns);
+    first.deleteRows({{"name", "missing"}});
+    DynamicTable second(db, "TestTable", settingsColumns);
+    second.deleteRows({{"name", "missing"}});
+    EXPECT_EQ(second.select().size(), 1);
+
+    EXPECT_EQ(cache->hits(), hits + 2);
+    EXPECT_EQ(cache->misses(), misses);
+}
+
+TEST(StatementCache, least_recently_used_eviction)
+{
+    StatementCache cache(db, 2);
+    const auto     first = cache.acquire("SELECT 1;");
+    static_cast<void>(cache.acquire("SELECT 2;"));
+    static_cast<void>(cache.acquire("SELECT 1;"));
+    static_cast<void>(cache.acquire("SELECT 3;"));
+    EXPECT_EQ(cache.size(), 2);
+    EXPECT_EQ(cache.evictions(), 1);
+    EXPECT_EQ(cache.hits(), 1);
+    EXPECT_EQ(cache.misses(), 3);
+    // "SELECT 2;" was the least recently used one
+    EXPECT_EQ(cache.acquire("SELECT 1;"), first);
+    static_cast<void>(cache.acquire("SELECT 2;"));
+    EXPECT_EQ(cache.misses(), 4);
+}
+
+TEST(StatementCache, failed_prepare_is_not_cached)
+{
+    StatementCache cache(db);
+    const auto     statement = cache.acquire("SELECT * FROM missing_table;");
+    EXPECT_FALSE(statement->lastError().text().isEmpty());
+    EXPECT_EQ(cache.size(), 0);
+}
+
+TEST(Factory, statements_shared_by_identical_schemas)
+{
+    Factory::clearStatements();
+    const TableSchema columns(settingsColumns);
+    const auto        first = Factory::statements(DBManager::QSQLITE, "TestTable", columns);
+    EXPECT_EQ(first->selectPk, "SELECT * FROM TestTable WHERE name=:name;");
+    EXPECT_EQ(first->upsert, "INSERT INTO TestTable (name, value) VALUES (:name, :value) ON CONFLICT(name) DO UPDATE "
+                             "SET value=excluded.value;");
+    // The update binds the primary key twice through one placeholder
+    ASSERT_EQ(first->updateBinding.size(), 2);
+    EXPECT_EQ(first->updateBinding[0].name, ":name");
+    EXPECT_EQ(first->updateBinding[1].column, 1);
+    ASSERT_EQ(first->keyBinding.size(), 1);
+    EXPECT_EQ(first->keyBinding[0].column, 0);
+
+    // Other column objects with the same definition share the statements
+    const TableSchema copies = {std::make_shared<SQLiteColumn>("name", SQLiteColumn::SQLiteDataType::TEXT,
+                                                               SQLiteModifier::isNotNull | SQLiteModifier::isUnique |
+                                                                       SQLiteModifier::isPrimaryKey),
+                                std::make_shared<SQLiteColumn>("value", SQLiteColumn::SQLiteDataType::TEXT)};
+    EXPECT_EQ(Factory::statements(DBManager::QSQLITE, "TestTable", copies), first);
+    EXPECT_EQ(Factory::cachedStatements(), 1);
+
+    const TableSchema changed = {*settingsColumns.begin(),
+                                 std::make_shared<SQLiteColumn>("value", SQLiteColumn::SQLiteDataType::TEXT,
+                                                                SQLiteModifier::isNotNull)};
+    EXPECT_NE(Factory::statements(DBManager::QSQLITE, "TestTable", changed), first);
+    EXPECT_NE(Factory::statements(DBManager::QSQLITE, "OtherTable", columns), first);
+    EXPECT_EQ(Factory::cachedStatements(), 3);
+
+    DynamicTable opened(db, "TestTable", settingsColumns);
+    EXPECT_EQ(opened.select().size(), 1);
+    EXPECT_EQ(Factory::cachedStatements(), 3);
+}
+
+TEST(Factory, builder_partitions_follow_the_columns)
+{
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("TestTable");
+    builder->addColumn(std::make_shared<SQLiteColumn>("value", SQLiteColumn::SQLiteDataType::TEXT));
+    EXPECT_TRUE(builder->whereClause().isEmpty());
+    builder->addColumn(std::make_shared<SQLiteColumn>("name", SQLiteColumn::SQLiteDataType::TEXT,
+                                                      SQLiteModifier::isPrimaryKey));
+    EXPECT_EQ(builder->whereClause(), " WHERE name=:name");
+    EXPECT_EQ(builder->createUpdate(), "UPDATE TestTable SET value=:value, name=:name WHERE name=:name;");
+}
+
+TEST(Factory, update_keeps_the_immutable_columns)
+{
+    const auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("TestTable");
+    builder->addColumn(std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER,
+                                                      SQLiteModifier::isPrimaryKey));
+    builder->addColumn(std::make_shared<SQLiteColumn>("modified_at", SQLiteColumn::SQLiteDataType::DATETIME,
+                                                      SQLiteModifier::None, std::nullopt, "CURRENT_TIMESTAMP"));
+    builder->addColumn(std::make_shared<SQLiteColumn>("owner", SQLiteColumn::SQLiteDataType::TEXT,
+                                                      SQLiteModifier::isImmutable));
+    builder->addColumn(std::make_shared<SQLiteColumn>("created_at", SQLiteColumn::SQLiteDataType::DATETIME,
+                                                      SQLiteModifier::isImmutable, std::nullopt, "CURRENT_TIMESTAMP"));
+    // Only the modifier keeps a column, not its name or its default
+    builder->addColumn(std::make_shared<SQLiteColumn>("created_on", SQLiteColumn::SQLiteDataType::DATETIME,
+                                                      SQLiteModifier::None, std::nullopt, "CURRENT_DATE"));
+    EXPECT_EQ(builder->createUpdate(), "UPDATE TestTable SET id=:id, modified_at=CURRENT_TIMESTAMP, "
+                                       "created_on=CURRENT_DATE WHERE id=:id;");
+    EXPECT_EQ(builder->createInsert(), "INSERT INTO TestTable (id, modified_at, owner, created_at, created_on) VALUES "
+                                       "(:id, CURRENT_TIMESTAMP, :owner, CURRENT_TIMESTAMP, CURRENT_DATE);");
+    EXPECT_TRUE(builder->createUpsert().endsWith(
+            " ON CONFLICT(id) DO UPDATE SET modified_at=excluded.modified_at, created_on=excluded.created_on;"));
+    EXPECT_EQ(SQLiteColumn::getModifierMask({"is_immutable"}), SQLiteModifier::isImmutable);
+}
+
+TEST(TableSchema, columns_by_position)
+{
+    const TableSchema schema = {
+            std::make_shared<SQLiteColumn>("id", SQLiteColumn::SQLiteDataType::INTEGER,
+                                           SQLiteModifier::isPrimaryKey | SQLiteModifier::isAutoIncrement),
+            std::make_shared<SQLiteColumn>("done", SQLiteColumn::SQLiteDataType::BOOLEAN, SQLiteModifier::None,
+                                           "idx_state", "0"),
+            std::make_shared<SQLiteColumn>("state", SQLiteColumn::SQLiteDataType::TEXT, SQLiteModifier::isNotNull,
+                                           "idx_state", std::nullopt, std::nullopt, std::nullopt, "NOCASE")};
+    ASSERT_EQ(schema.size(), 3);
+    EXPECT_EQ(schema.indexOf("state"), 2);
+    EXPECT_FALSE(schema.indexOf("missing").has_value());
+    EXPECT_TRUE(schema.hasModifier(0, SQLiteModifier::isAutoIncrement));
+    EXPECT_FALSE(schema.hasModifier(1, SQLiteModifier::isPrimaryKey));
+    EXPECT_EQ(schema.dataType(1), "TEXT");
+    EXPECT_EQ(schema.typeCode(1), static_cast<int>(SQLiteColumn::SQLiteDataType::BOOLEAN));
+    EXPECT_EQ(schema.attribute(1, TableSchema::Attribute::Default), "0");
+    EXPECT_FALSE(schema.optionalAttribute(2, TableSchema::Attribute::Default).has_value());
+    // Both columns share the interned index name
+    EXPECT_EQ(&schema.attribute(1, TableSchema::Attribute::Index),
+              &schema.attribute(2, TableSchema::Attribute::Index));
+
+    auto builder = Factory::builder(DBManager::QSQLITE);
+    builder->setTableName("Tasks");
+    builder->setSchema(schema);
+    EXPECT_EQ(builder->createTable(), "CREATE TABLE IF NOT EXISTS Tasks ( id INTEGER PRIMARY KEY AUTOINCREMENT, done "
+                                      "TEXT DEFAULT 0, state TEXT NOT NULL COLLATE NOCASE );");
+    EXPECT_EQ(builder->createInsert(), "INSERT INTO Tasks (done, state) VALUES (0, :state);");
+    EXPECT_EQ(builder->createIndexes(), QVector<QString>{"CREATE INDEX IF NOT EXISTS idx_state ON tasks(done, state);"});
+}
+
+TEST(QueryProfiler, statistics_by_statement)
+{
+    QueryProfiler::clear();
+    // Every execution is slower than a microsecond, so the plans are captured
+    QueryProfiler::enable(std::chrono::microseconds(1));
+    table->insert({{"name", "profiled_1"}, {"value", "value"}});
+    table->insert({{"name", "profiled_2"}, {"value", "value"}});
+    EXPECT_EQ(table->select().size(), 3);
+    table->deleteMany({{"name", QVariantList{"profiled_1", "profiled_2"}}});
+    QueryProfiler::disable();
+    EXPECT_EQ(table->select().size(), 1);
+
+    const auto insert = QueryProfiler::statistics("DynamicTable::insert[TestTable]");
+    EXPECT_EQ(insert.executions, 2);
+    EXPECT_EQ(insert.rows, 2);
+    EXPECT_EQ(insert.errors, 0);
+    EXPECT_LE(insert.minTime, insert.p50);
+    EXPECT_LE(insert.p50, insert.p99);
+    EXPECT_LE(insert.p99, insert.maxTime);
+    EXPECT_TRUE(insert.sql.startsWith("INSERT", Qt::CaseInsensitive));
+
+    const auto select = QueryProfiler::statistics("DynamicTable::select[TestTable]");
+    EXPECT_EQ(select.executions, 1);
+    EXPECT_EQ(select.rows, 3);
+    EXPECT_TRUE(select.plan.contains("TestTable"));
+    EXPECT_EQ(QueryProfiler::statistics("DynamicTable::deleteMany[TestTable]").rows, 2);
+
+    EXPECT_EQ(QJsonDocument::fromJson(QueryProfiler::toJson()).array().size(), 3);
+    const auto csv = QueryProfiler::toCsv().split('\n');
+    EXPECT_TRUE(csv.first().startsWith("name,executions,errors,rows"));
+    QueryProfiler::clear();
+}
+
+TEST(ConnectionPool, lease_not_enabled)
+{
+    EXPECT_THROW(static_cast<void>(DBManager::manager().lease("not_pooled")), DBManagerException);
+}
+
+TEST(ConnectionPool, owner_thread_uses_original_connection)
+{
+    auto pooled = DBManager::manager().connect(DBManager::QSQLITE, db.databaseName(), "pooled");
+    ASSERT_TRUE(pooled.open());
+    const auto pool = DBManager::manager().enablePool("pooled", 1, std::chrono::milliseconds(0));
+
+    const auto lease = DBManager::manager().lease("pooled");
+    EXPECT_EQ(lease.database().connectionName(), "pooled");
+    EXPECT_EQ(pool->size(), 0);
+}
+
+TEST(ConnectionPool, worker_thread_uses_clone)
+{
+    const auto pool = DBManager::manager().pool("pooled");
+    ASSERT_TRUE(pool);
+
+    QString     connectionName;
+    qsizetype   rows   = 0;
+    auto *const worker = QThread::create(
+            [&]()
+            {
+                const auto   lease = DBManager::manager().lease("pooled");
+                DynamicTable workerTable(lease.database(), "TestTable", settingsColumns);
+                connectionName = lease.database().connectionName();
+                rows           = workerTable.select().size();
+            });
+    worker->start();
+    worker->wait();
+    delete worker;
+
+    EXPECT_TRUE(connectionName.startsWith("pooled_clone_"));
+    EXPECT_EQ(rows, 1);
+    // The clone is closed when its thread finishes
+    EXPECT_EQ(pool->size(), 0);
+}
+
+TEST(ConnectionPool, bounded_and_idle_eviction)
+{
+    const auto pool = DBManager::manager().pool("pooled");
+    ASSERT_TRUE(pool);
+
+    QSemaphore  leased;
+    QSemaphore  returned;
+    QSemaphore  evict;
+    QSemaphore  finish;
+    int         evicted = -1;
+    auto *const holder  = QThread::create(
+            [&]()
+            {
+                auto lease = DBManager::manager().lease("pooled");
+                leased.release();
+                returned.acquire();
+                lease.release();
+                leased.release();
+                evict.acquire();
+                evicted = pool->evictIdle();
+                leased.release();
+                finish.acquire();
+            });
+    bool        timedOut = false;
+    auto *const waiter   = QThread::create(
+            [&]()
+            {
+                try
+                {
+                    const auto lease = DBManager::manager().lease("pooled", std::chrono::milliseconds(50));
+                }
+                catch (const ConnectionPoolException &)
+                {
+                    timedOut = true;
+                }
+            });
+
+    holder->start();
+    leased.acquire();
+    EXPECT_EQ(pool->leased(), 1);
+    // The only slot is leased, so the second thread cannot get a connection
+    waiter->start();
+    waiter->wait();
+    EXPECT_TRUE(timedOut);
+
+    returned.release();
+    leased.acquire();
+    EXPECT_EQ(pool->size(), 1);
+    EXPECT_EQ(pool->leased(), 0);
+    QThread::msleep(5);
+    // The idle clone belongs to a running thread, so only that thread can close it
+    EXPECT_EQ(pool->evictIdle(), 0);
+    EXPECT_EQ(pool->size(), 1);
+
+    evict.release();
+    leased.acquire();
+    EXPECT_EQ(evicted, 1);
+    EXPECT_EQ(pool->size(), 0);
+
+    finish.release();
+    holder->wait();
+    delete holder;
+    delete waiter;
+}
+
+TEST(ConnectionPool, slot_of_finished_thread_is_reused)
+{
+    const auto pool = DBManager::manager().pool("pooled");
+    ASSERT_TRUE(pool);
+
+    // The lease is returned after its thread finished, so the clone stays open until its slot is needed
+    std::optional<ConnectionLease> leaked;
+    auto *const                    first = QThread::create([&]() { leaked = DBManager::manager().lease("pooled"); });
+    first->start();
+    first->wait();
+    leaked.reset();
+    EXPECT_EQ(pool->size(), 1);
+
+    QString     connectionName;
+    auto *const second = QThread::create(
+            [&]()
+            {
+                const auto lease = DBManager::manager().lease("pooled", std::chrono::milliseconds(50));
+                connectionName   = lease.database().connectionName();
+            });
+    second->start();
+    second->wait();
+    EXPECT_TRUE(connectionName.startsWith("pooled_clone_"));
+    EXPECT_EQ(pool->size(), 0);
+    delete first;
+    delete second;
+}
+
+TEST(SQLiteOptions, pragmas)
+{
+    const auto pragmas = SQLiteOptions::bulkLoad().pragmas();
+    EXPECT_TRUE(pragmas.contains("PRAGMA journal_mode = WAL;"));
+    EXPECT_TRUE(pragmas.contains("PRAGMA synchronous = OFF;"));
+    EXPECT_TRUE(pragmas.contains("PRAGMA cache_size = -65536;"));
+    EXPECT_TRUE(pragmas.contains("PRAGMA foreign_keys = OFF;"));
+}
+
+static QVariant pragmaValue(const QSqlDatabase &database, const QString &pragma)
+{
+    QSqlQuery query(database);
+    if (query.exec(QString("PRAGMA %1;").arg(pragma)) && query.next())
+    {
+        return query.value(0);
+    }
+    return {};
+}
+
+TEST(SQLiteOptions, applied_on_open_and_on_clones)
+{
+    const auto dbPath = core::tools::getTemporaryFileName(".db");
+    {
+        const auto tuned = DBManager::manager().connect(dbPath, SQLiteOptions::interactive(), "tuned");
+        EXPECT_EQ(pragmaValue(tuned, "journal_mode").toString(), "wal");
+        EXPECT_EQ(pragmaValue(tuned, "synchronous").toInt(), 1);
+        EXPECT_EQ(pragmaValue(tuned, "foreign_keys").toInt(), 1);
+        EXPECT_EQ(pragmaValue(tuned, "cache_size").toInt(), -16384);
+
+        // The per connection pragmas are applied again on the clone of another thread
+        const auto pool = DBManager::manager().enablePool("tuned");
+        QString    cloneName;
+        QVariant   synchronous;
+        QVariant   cacheSize;
+        QVariant   tempStore;
+        QVariant   foreignKeys;
+        auto      *worker = QThread::create(
+                [&]()
+                {
+                    const auto lease = DBManager::manager().lease("tuned");
+                    cloneName        = lease.database().connectionName();
+                    synchronous      = pragmaValue(lease.database(), "synchronous");
+                    cacheSize        = pragmaValue(lease.database(), "cache_size");
+                    tempStore        = pragmaValue(lease.database(), "temp_store");
+                    foreignKeys      = pragmaValue(lease.database(), "foreign_keys");
+                });
+        worker->start();
+        worker->wait();
+        delete worker;
+        EXPECT_TRUE(cloneName.startsWith("tuned_clone_"));
+        EXPECT_EQ(synchronous.toInt(), 1);
+        EXPECT_EQ(cacheSize.toInt(), -16384);
+        EXPECT_EQ(tempStore.toInt(), 2);
+        EXPECT_EQ(foreignKeys.toInt(), 1);
+        DBManager::manager().connection("tuned").close();
+    }
+    QFile::remove(dbPath);
+    QFile::remove(dbPath + "-wal");
+    QFile::remove(dbPath + "-shm");
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app{argc, argv};
@@ -0,0 +1,323 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QSqlQuery>
+#include <QTimer>
+#include <array>
+#include <gtest/gtest.h>
+#include <string_view>
+#include "db/db_exception.h"
+#include "db/query_profiler.h"
+#include "tools/tools.h"
+#include "users.h"
+
+QSqlDatabase db;
+
+// The description of the columns is known at compile time
+static_assert(Users::COLUMNS.size() == 9);
+static_assert(std::string_view(Users::COLUMNS[3].name) == "email");
+static_assert(Users::COLUMNS[0].hasModifier(core::db::SQLiteModifier::isAutoIncrement));
+static_assert(Users::COLUMNS[8].type == core::db::SQLiteColumn::SQLiteDataType::DATETIME);
+static_assert(Users::COLUMNS[8].hasModifier(core::db::SQLiteModifier::isImmutable));
+
+namespace
+{
+    Users::Record makeUser(const QString &name, const QString &email = {})
+    {
+        Users::Record record{};
+        record.m_username    = name;
+        record.m_password    = "password";
+        record.m_email       = email.isEmpty() ? name + "@invoice.manager" : email;
+        record.m_groupId     = 1;
+        record.m_created_by  = "admin";
+        record.m_modified_by = "admin";
+        return record;
+    }
+
+    Users::Record byId(const long long id)
+    {
+        Users::Record record{};
+        record.m_id = id;
+        return record;
+    }
+} // namespace
+
+/**
+ * @brief Runs the class generated from data/users.json on an empty users table.
+ */
+class GeneratedUsers : public testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        users.create();
+    }
+
+    void TearDown() override
+    {
+        QSqlQuery(db).exec("DELETE FROM users;");
+    }
+
+    Users users{db};
+};
+
+TEST_F(GeneratedUsers, insert_and_select_by_key)
+{
+    auto first  = makeUser("first");
+    auto second = makeUser("second");
+    users.insert(first);
+    users.insert(second);
+    EXPECT_GT(first.m_id, 0);
+    EXPECT_EQ(second.m_id, first.m_id + 1);
+    EXPECT_EQ(users.countRows(), 2);
+
+    auto found = byId(second.m_id);
+    ASSERT_TRUE(users.selectPk(found));
+    EXPECT_EQ(found.m_username, "second");
+    EXPECT_EQ(found.m_email, "second@invoice.manager");
+
+    auto missing = byId(second.m_id + 1);
+    EXPECT_FALSE(users.selectPk(missing));
+}
+
+TEST_F(GeneratedUsers, update_by_key)
+{
+    auto first  = makeUser("first");
+    auto second = makeUser("second");
+    users.insert(first);
+    users.insert(second);
+
+    first.m_email = "changed@invoice.manager";
+    users.update(first);
+
+    auto found = byId(first.m_id);
+    ASSERT_TRUE(users.selectPk(found));
+    EXPECT_EQ(found.m_email, "changed@invoice.manager");
+    found = byId(second.m_id);
+    ASSERT_TRUE(users.selectPk(found));
+    EXPECT_EQ(found.m_email, "second@invoice.manager");
+}
+
+TEST_F(GeneratedUsers, update_keeps_the_creation_time)
+{
+    auto user = makeUser("stamped");
+    users.insert(user);
+    QSqlQuery query(db);
+    ASSERT_TRUE(query.exec(QString("UPDATE users SET created_at='2020-01-01 00:00:00', "
+                                   "modified_at='2020-01-01 00:00:00' WHERE id=%1;")
+                                   .arg(user.m_id)));
+
+    // The columns declared is_immutable keep the values of the insert
+    user.m_password   = "rehashed";
+    user.m_created_by = "intruder";
+    users.update(user);
+
+    ASSERT_TRUE(query.exec(
+            QString("SELECT created_at, modified_at, created_by FROM users WHERE id=%1;").arg(user.m_id)));
+    ASSERT_TRUE(query.next());
+    EXPECT_EQ(query.value(0).toString(), "2020-01-01 00:00:00");
+    EXPECT_NE(query.value(1).toString(), "2020-01-01 00:00:00");
+    EXPECT_EQ(query.value(2).toString(), "admin");
+}
+
+TEST_F(GeneratedUsers, delete_by_key)
+{
+    auto first  = makeUser("first");
+    auto second = makeUser("second");
+    users.insert(first);
+    users.insert(second);
+
+    users.deleteRow(first);
+    EXPECT_EQ(users.countRows(), 1);
+    auto found = byId(first.m_id);
+    EXPECT_FALSE(users.selectPk(found));
+    found = byId(second.m_id);
+    EXPECT_TRUE(users.selectPk(found));
+
+    // The username of the deleted row can be inserted again
+    auto again = makeUser("first");
+    users.insert(again);
+    EXPECT_EQ(users.countRows(), 2);
+}
+
+TEST_F(GeneratedUsers, batches)
+{
+    std::array records{makeUser("batch_1"), makeUser("batch_2"), makeUser("batch_3")};
+    users.insertBatch(records);
+    EXPECT_EQ(users.countRows(), 3);
+    EXPECT_EQ(records[1].m_id, records[0].m_id + 1);
+    EXPECT_EQ(records[2].m_id, records[0].m_id + 2);
+
+    for (auto &record: records)
+    {
+        record.m_password = "rehashed";
+    }
+    users.updateBatch(records);
+    for (const auto &record: records)
+    {
+        auto found = byId(record.m_id);
+        ASSERT_TRUE(users.selectPk(found));
+        EXPECT_EQ(found.m_password, "rehashed");
+        EXPECT_EQ(found.m_username, record.m_username);
+    }
+
+    // A duplicated username rolls the whole batch back
+    std::array duplicated{makeUser("batch_4"), makeUser("batch_1")};
+    EXPECT_THROW(users.insertBatch(duplicated), core::db::SQLError);
+    EXPECT_EQ(users.countRows(), 3);
+}
+
+TEST_F(GeneratedUsers, writes_notify_table_listeners)
+{
+    QStringList tables;
+    const auto  handle = core::db::SQLiteDbApi::addTableListener([&tables](const QString &table) { tables << table; });
+
+    auto user = makeUser("listened");
+    users.insert(user);
+    users.update(user);
+    std::array records{makeUser("listened_1"), makeUser("listened_2")};
+    users.insertBatch(records);
+    users.updateBatch(records);
+    users.deleteRow(user);
+    auto found = byId(records[0].m_id);
+    users.selectPk(found);
+    EXPECT_EQ(tables, QStringList(5, "users"));
+
+    core::db::SQLiteDbApi::removeTableListener(handle);
+    users.deleteRow(records[0]);
+    EXPECT_EQ(tables.size(), 5);
+}
+
+TEST_F(GeneratedUsers, statements_are_profiled)
+{
+    core::db::QueryProfiler::clear();
+    core::db::QueryProfiler::enable();
+    auto user = makeUser("profiled");
+    users.insert(user);
+    auto found = byId(user.m_id);
+    users.selectPk(found);
+    core::db::QueryProfiler::disable();
+
+    EXPECT_EQ(core::db::QueryProfiler::statistics("Users::insert").executions, 1);
+    EXPECT_EQ(core::db::QueryProfiler::statistics("Users::insert").rows, 1);
+    EXPECT_EQ(core::db::QueryProfiler::statistics("Users::selectPk").rows, 1);
+    core::db::QueryProfiler::clear();
+}
+
+TEST_F(GeneratedUsers, create_declares_the_indexes)
+{
+    QSqlQuery query(db);
+    ASSERT_TRUE(query.exec("SELECT name FROM sqlite_master WHERE type='index' AND tbl_name='users';"));
+    QStringList indexes;
+    while (query.next())
+    {
+        indexes << query.value(0).toString();
+    }
+    EXPECT_TRUE(indexes.contains("idx_users_username"));
+    EXPECT_TRUE(indexes.contains("idx_users_email"));
+}
+
+TEST_F(GeneratedUsers, selects_from_json)
+{
+    auto alice = makeUser("alice", "shared@invoice.manager");
+    auto bob   = makeUser("bob", "shared@invoice.manager");
+    auto carol = makeUser("carol");
+    users.insert(alice);
+    users.insert(bob);
+    users.insert(carol);
+
+    auto byName       = Users::Record{};
+    byName.m_username = "bob";
+    ASSERT_TRUE(users.findUserByUsername(byName));
+    EXPECT_EQ(byName.m_id, bob.m_id);
+    byName.m_username = "nobody";
+    EXPECT_FALSE(users.findUserByUsername(byName));
+
+    auto byEmail    = Users::Record{};
+    byEmail.m_email = "shared@invoice.manager";
+    QStringList names;
+    for (auto found = users.findUserByEmail(byEmail); found; found = users.nextFindUserByEmail(byEmail))
+    {
+        names << byEmail.m_username;
+    }
+    names.sort();
+    EXPECT_EQ(names, (QStringList{"alice", "bob"}));
+}
+
+TEST_F(GeneratedUsers, iterations_of_two_instances)
+{
+    auto alice = makeUser("alice", "shared@invoice.manager");
+    auto bob   = makeUser("bob", "shared@invoice.manager");
+    users.insert(alice);
+    users.insert(bob);
+
+    // Another instance on the same connection runs the same select while the first one iterates
+    Users other(db);
+    auto  first  = Users::Record{};
+    auto  second = Users::Record{};
+    first.m_email  = "shared@invoice.manager";
+    second.m_email = "shared@invoice.manager";
+    ASSERT_TRUE(users.findUserByEmail(first));
+    ASSERT_TRUE(other.findUserByEmail(second));
+    ASSERT_TRUE(other.nextFindUserByEmail(second));
+    EXPECT_FALSE(other.nextFindUserByEmail(second));
+    ASSERT_TRUE(users.nextFindUserByEmail(first));
+    EXPECT_FALSE(users.nextFindUserByEmail(first));
+}
+
+TEST_F(GeneratedUsers, pages)
+{
+    std::array records{makeUser("page_1", "shared@invoice.manager"), makeUser("page_2"),
+                       makeUser("page_3", "shared@invoice.manager"), makeUser("page_4", "shared@invoice.manager"),
+                       makeUser("page_5")};
+    users.insertBatch(records);
+
+    auto page = users.selectPage(nullptr, 2);
+    ASSERT_EQ(page.size(), 2);
+    EXPECT_EQ(page[0].m_username, "page_1");
+    EXPECT_EQ(page[1].m_username, "page_2");
+    page = users.selectPage(&page.last(), 2);
+    ASSERT_EQ(page.size(), 2);
+    EXPECT_EQ(page[0].m_username, "page_3");
+    page = users.selectPage(&page.last(), 2);
+    ASSERT_EQ(page.size(), 1);
+    EXPECT_EQ(page[0].m_username, "page_5");
+    EXPECT_TRUE(users.selectPage(&page.last(), 2).isEmpty());
+
+    auto filter    = Users::Record{};
+    filter.m_email = "shared@invoice.manager";
+    page           = users.findUserByEmailPage(filter, nullptr, 2);
+    ASSERT_EQ(page.size(), 2);
+    EXPECT_EQ(page[1].m_username, "page_3");
+    page = users.findUserByEmailPage(filter, &page.last(), 2);
+    ASSERT_EQ(page.size(), 1);
+    EXPECT_EQ(page[0].m_username, "page_4");
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app{argc, argv};
+
+    QTimer::singleShot(0,
+                       [&]()
+                       {
+                           const auto dbPath = core::tools::getTemporaryFileName(".db");
+                           db                = QSqlDatabase::addDatabase("QSQLITE");
+                           db.setDatabaseName(dbPath);
+
+                           ASSERT_TRUE(db.open());
+
+                           ::testing::InitGoogleTest(&argc, argv);
+                           const auto testResult = RUN_ALL_TESTS();
+
+                           QFile::remove(dbPath);
+                           QCoreApplication::exit(testResult);
+                       });
+
+    return QCoreApplication::exec();
+}
@@ -119,6 +119,70 @@ TEST(DBAPIGenerator, create_db_api_generator)
     QFile::remove(path + ".db");
 }
 
+QJsonDocument usersDocument()
+{
+    const QJsonObject tableObj{
+            {"name", "Users"},
+            {"columns",
+             QJsonArray{QJsonObject{{"name", "id"},
+                                    {"type", "INTEGER"},
+                                    {"modifiers", QJsonArray{"is_primary_key", "is_unique", "is_auto_increment"}}},
+                        QJsonObject{{"name", "username"}, {"type", "TEXT"}, {"modifiers", QJsonArray{"is_unique"}}},
+                        QJsonObject{{"name", "email"}, {"type", "TEXT"}}}}};
+    return QJsonDocument(QJsonObject{{"table", tableObj}});
+}
+
+TEST(DBAPIGenerator, eager_statements)
+{
+    // Only the statements named in eager_statements are prepared by the constructor
+    auto root                = usersDocument().object();
+    root["eager_statements"] = QJsonArray{"countRows", "selectPk"};
+    DBClass dbClass(db);
+    dbClass.load(QJsonDocument(root));
+
+    const auto source = dbClass.getSourceFile();
+    EXPECT_TRUE(source.contains("m_countRows = prepare(COUNT_ROWS);"));
+    EXPECT_TRUE(source.contains("m_selectPk = prepare(SELECT_PK);"));
+    EXPECT_FALSE(source.contains("m_insert = prepare(INSERT);"));
+    EXPECT_TRUE(source.contains("ensurePrepared(m_insert, INSERT);"));
+
+    root["eager_statements"] = QJsonArray{"unknown"};
+    DBClass invalid(db);
+    EXPECT_THROW(invalid.load(QJsonDocument(root)), InvalidJSON);
+}
+
+TEST(DBAPIGenerator, pages_need_a_declared_index)
+{
+    auto        root            = usersDocument().object();
+    QJsonObject findUserByEmail{{"name", "findUserByEmail"}, {"where", "email = :email"}, {"type", "select"}};
+    findUserByEmail["order_by"] = "idx_missing";
+    root["statements"]          = QJsonArray{findUserByEmail};
+    DBClass invalid(db);
+    EXPECT_THROW(invalid.load(QJsonDocument(root)), InvalidJSON);
+}
+
+TEST(DBAPIGenerator, invalid_indexes)
+{
+    auto root  = usersDocument().object();
+    auto table = root["table"].toObject();
+
+    const auto rejects = [&root, &table](const QJsonObject &index)
+    {
+        table["indexes"] = QJsonArray{index};
+        root["table"]    = table;
+        DBClass invalid(db);
+        EXPECT_THROW(invalid.load(QJsonDocument(root)), InvalidJSON);
+    };
+    rejects(QJsonObject{{"name", "idx_users_missing"}, {"columns", QJsonArray{"missing"}}});
+    rejects(QJsonObject{{"name", "idx_users_empty"}, {"columns", QJsonArray{}}});
+    rejects(QJsonObject{{"name", "idx_users_order"},
+                        {"columns", QJsonArray{QJsonObject{{"name", "email"}, {"order", "up"}}}}});
+    rejects(QJsonObject{{"name", "idx_users_unique"},
+                        {"columns", QJsonArray{"email"}},
+                        {"unique", true},
+                        {"include", QJsonArray{"username"}}});
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication   app{argc, argv};
@@ -0,0 +1,59 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <gtest/gtest.h>
+#include "tools/password_hash.h"
+
+using core::tools::PasswordHash;
+
+TEST(PasswordHash, pbkdf2_test_vectors)
+{
+    EXPECT_EQ(PasswordHash::pbkdf2("password", "salt", 1).toHex(),
+              "867f70cf1ade02cff3752599a3a53dc4af34c7a669815ae5d513554e1c8cf252c02d470a285a0501bad999bfe943c08f050235"
+              "d7d68b1da55e63f73b60a57fce");
+    // More than one block of the derived key
+    const auto key = PasswordHash::pbkdf2("passwordPASSWORDpassword", "saltSALTsaltSALTsaltSALTsaltSALTsalt", 4096, 80);
+    EXPECT_EQ(key.toHex(),
+              "8c0511f4c6e597c6ac6315d8f0362e225f3c501495ba23b868c005174dc4ee71115b59f9e60cd9532fa33e0f75aefe30225c58"
+              "3a186cd82bd4daea9724a3d3b804f75bdd41494fa324cab24bcc680fb3");
+}
+
+TEST(PasswordHash, hash_and_verify)
+{
+    const auto hash = PasswordHash::hash("secret", PasswordHash::MIN_ITERATIONS);
+    EXPECT_TRUE(hash.startsWith(QString("%1$%2$").arg(PasswordHash::SCHEME).arg(PasswordHash::MIN_ITERATIONS)));
+    EXPECT_TRUE(PasswordHash::verify("secret", hash));
+    EXPECT_FALSE(PasswordHash::verify("Secret", hash));
+    // Every hash has its own salt
+    EXPECT_NE(PasswordHash::hash("secret", PasswordHash::MIN_ITERATIONS), hash);
+    EXPECT_FALSE(PasswordHash::verify("secret", "pbkdf2-sha512$x$$"));
+}
+
+TEST(PasswordHash, legacy_hash_needs_rehash)
+{
+    const QString legacy = "c7ad44cbad762a5da0a452f9e854fdc1e0e7a52a38015f23f3eab1d80b931dd472634dfac71cd34ebc35d16ab7fb8a"
+                           "90c81f975113d6c7538dc69dd8de9077ec";
+    EXPECT_TRUE(PasswordHash::verify("admin", legacy));
+    EXPECT_FALSE(PasswordHash::verify("other", legacy));
+    EXPECT_TRUE(PasswordHash::needsRehash(legacy));
+
+    const auto hash = PasswordHash::hash("admin", PasswordHash::MIN_ITERATIONS);
+    EXPECT_FALSE(PasswordHash::needsRehash(hash, PasswordHash::MIN_ITERATIONS));
+    EXPECT_TRUE(PasswordHash::needsRehash(hash, PasswordHash::MIN_ITERATIONS * 2));
+}
+
+TEST(PasswordHash, constant_time_equals)
+{
+    EXPECT_TRUE(PasswordHash::constantTimeEquals("abc", "abc"));
+    EXPECT_FALSE(PasswordHash::constantTimeEquals("abc", "abd"));
+    EXPECT_FALSE(PasswordHash::constantTimeEquals("abc", "abcd"));
+}
+
+TEST(PasswordHash, calibrate)
+{
+    EXPECT_GE(PasswordHash::calibrate(std::chrono::milliseconds(1)), PasswordHash::MIN_ITERATIONS);
+    EXPECT_EQ(PasswordHash::calibrate(std::chrono::milliseconds(50)) % 1000, 0);
+}
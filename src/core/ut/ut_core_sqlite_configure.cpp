@@ -10,6 +10,9 @@
 #include <QTimer>
 #include <QUuid>
 #include <gtest/gtest.h>
+#include <thread>
+#include "db/db_manager.h"
+#include "settings/settings_watcher.h"
 #include "settings/sqlite_settings.h"
 
 QSqlDatabase db;
@@ -34,6 +37,102 @@ TEST(SQLiteSettings, get_value)
     EXPECT_EQ(settings["value_2"].toInt(), 3);
 }
 
+TEST(SQLiteSettings, update_existing_value)
+{
+    core::settings::SQLiteSettings settings(db, "GoogleTest");
+    settings.read();
+    EXPECT_FALSE(settings.isDirty());
+
+    settings.setValue("value_1", "hi");
+    EXPECT_FALSE(settings.isDirty());
+    settings.setValue("value_1", "bye");
+    EXPECT_TRUE(settings.isDirty());
+    EXPECT_TRUE(settings.write());
+    EXPECT_FALSE(settings.isDirty());
+
+    core::settings::SQLiteSettings stored(db, "GoogleTest");
+    stored.read();
+    EXPECT_EQ(stored.value("value_1").toString(), "bye");
+    EXPECT_EQ(stored.value("value_2").toInt(), 3);
+}
+
+TEST(SQLiteSettings, remove_value)
+{
+    core::settings::SQLiteSettings settings(db, "GoogleTest");
+    settings.read();
+    EXPECT_TRUE(settings.remove("value_2"));
+    EXPECT_FALSE(settings.remove("value_2"));
+    EXPECT_TRUE(settings.write());
+
+    core::settings::SQLiteSettings stored(db, "GoogleTest");
+    stored.read();
+    EXPECT_FALSE(stored.contains("value_2"));
+    EXPECT_TRUE(stored.contains("value_1"));
+}
+
+TEST(SQLiteSettings, typed_snapshot)
+{
+    core::settings::SQLiteSettings settings(db, "GoogleTest");
+    const auto                     fontSize = settings.registerKey<int>("font_size", 10);
+    const auto                     greeting = settings.registerKey<QString>("value_1");
+    EXPECT_EQ(settings.get(fontSize), 10);
+    EXPECT_TRUE(settings.get(greeting).isEmpty());
+
+    settings.read();
+    EXPECT_EQ(settings.get(greeting), "bye");
+
+    const auto before = settings.snapshot();
+    settings.setValue("font_size", "12");
+    EXPECT_TRUE(settings.write());
+    // Readers keep the snapshot they hold, the new values go to a new one
+    EXPECT_EQ(before->value(fontSize), 10);
+    EXPECT_GT(settings.snapshot()->version(), before->version());
+
+    int read = 0;
+    std::thread reader([&]() { read = settings.get(fontSize); });
+    reader.join();
+    EXPECT_EQ(read, 12);
+    EXPECT_EQ(settings.registerKey<int>("font_size").slot(), fontSize.slot());
+}
+
+TEST(SQLiteSettings, change_feed)
+{
+    core::settings::SQLiteSettings  settings(db, "GoogleTest");
+    core::settings::SettingsWatcher watcher(settings);
+    settings.read();
+    const auto greeting = settings.registerKey<QString>("value_1");
+
+    {
+        // Another process updating the same database
+        auto other = QSqlDatabase::addDatabase("QSQLITE", "other_process");
+        other.setDatabaseName(db.databaseName());
+        ASSERT_TRUE(other.open());
+        core::settings::SQLiteSettings remote(other, "GoogleTest");
+        remote.read();
+        remote.setValue("value_1", "remote");
+        remote.setValue("theme", "dark");
+        remote.remove("font_size");
+        EXPECT_TRUE(remote.write());
+    }
+    core::db::DBManager::manager().releaseStatementCache("other_process");
+    QSqlDatabase::removeDatabase("other_process");
+
+    QMap<QString, QVariant> notified;
+    QObject::connect(&watcher, &core::settings::SettingsWatcher::settingChanged,
+                     [&](const QString &key, const QVariant &value) { notified[key] = value; });
+    watcher.poll();
+    EXPECT_EQ(notified.size(), 3);
+    EXPECT_EQ(notified["value_1"].toString(), "remote");
+    EXPECT_EQ(notified["theme"].toString(), "dark");
+    EXPECT_FALSE(notified["font_size"].isValid());
+    EXPECT_EQ(settings.get(greeting), "remote");
+
+    // Nothing else changed, the poll only reads the data version
+    notified.clear();
+    watcher.poll();
+    EXPECT_TRUE(notified.isEmpty());
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app{argc, argv};
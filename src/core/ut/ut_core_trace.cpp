@@ -0,0 +1,74 @@
+/**
+ * Part of https://github.com/ManelJimeno/invoice_manager (C) 2024
+ * Authors: Manel Jimeno <manel.jimeno@gmail.com>
+ * License: http://www.opensource.org/licenses/mit-license.php MIT
+ */
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <gtest/gtest.h>
+#include <thread>
+#include "tools/trace.h"
+
+using core::tools::ScopedSpan;
+using core::tools::Trace;
+
+class TraceTest : public testing::Test
+{
+protected:
+    void TearDown() override
+    {
+        Trace::disable();
+        Trace::clear();
+    }
+};
+
+TEST_F(TraceTest, disabled_records_nothing)
+{
+    {
+        const ScopedSpan span("disabled");
+    }
+    EXPECT_TRUE(Trace::spans().isEmpty());
+}
+
+TEST_F(TraceTest, records_spans)
+{
+    Trace::enable();
+    {
+        const ScopedSpan outer("outer", "test");
+        const ScopedSpan inner("inner", "test", "detail");
+    }
+    std::thread([]() { const ScopedSpan span("worker", "test"); }).join();
+
+    const auto spans = Trace::spans();
+    ASSERT_EQ(spans.size(), 3);
+    EXPECT_STREQ(spans[0].name, "inner");
+    EXPECT_EQ(spans[0].detail, "detail");
+    EXPECT_STREQ(spans[1].name, "outer");
+    EXPECT_LE(spans[1].start, spans[0].start);
+    EXPECT_GE(spans[1].duration, spans[0].duration);
+    EXPECT_STREQ(spans[2].name, "worker");
+    EXPECT_NE(spans[2].thread, spans[0].thread);
+}
+
+TEST_F(TraceTest, chrome_trace)
+{
+    Trace::enable();
+    {
+        const ScopedSpan span("statement", "db", "SELECT 1");
+    }
+
+    const auto document = QJsonDocument::fromJson(Trace::toChromeTrace());
+    ASSERT_TRUE(document.isObject());
+    const auto events = document.object()["traceEvents"].toArray();
+    // The name of the thread, then the span
+    ASSERT_EQ(events.size(), 2);
+    EXPECT_EQ(events[0].toObject()["ph"].toString(), "M");
+    const auto event = events[1].toObject();
+    EXPECT_EQ(event["name"].toString(), "statement");
+    EXPECT_EQ(event["cat"].toString(), "db");
+    EXPECT_EQ(event["ph"].toString(), "X");
+    EXPECT_GE(event["dur"].toDouble(), 0.0);
+    EXPECT_EQ(event["args"].toObject()["detail"].toString(), "SELECT 1");
+}